@@ -0,0 +1,114 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "BenchmarkTour.h"
+
+#include "OptionsMenu.h"
+#include "HiScoreMenu.h"
+#include "CreditsMenu.h"
+#include "Level.h"
+#include "WorkCounters.h"
+
+BenchmarkTour::BenchmarkTour(Configuration* config, GameConfiguration* game, Display* display, const std::string& output, int frames) :
+	config(config), game(game), display(display), frames(frames) {
+	mainMenu = nullptr;
+	csv.open(output, std::ofstream::out);
+	if (!csv.is_open()) {
+		g_warning("%s[%d] : Unable to open benchmark output %s", __FILE__, __LINE__, output.c_str());
+	}
+}
+
+BenchmarkTour::~BenchmarkTour() {
+	Deactivate();
+}
+
+bool BenchmarkTour::Activate() {
+	return csv.is_open();
+}
+
+void BenchmarkTour::Deactivate() {
+	if (mainMenu != nullptr) {
+		mainMenu->Deactivate();
+		delete mainMenu;
+		mainMenu = nullptr;
+	}
+	if (csv.is_open()) {
+		csv.close();
+	}
+}
+
+bool BenchmarkTour::Run() {
+	display->getFrameStats()->setFrameLimit(frames);
+	WorkCounters::setEnabled(true);
+	csv << "scene,frames,load_ms,avg_ms,p99_ms,fps,draw_calls_per_frame" << std::endl;
+
+	// The menus, the sub menus share the main menu background and cursor.
+	mainMenu = new MainMenu(config, game, display);
+	if (runScene("MainMenu", mainMenu, false)) {
+		runScene("OptionsMenu", new OptionsMenu(config, game, display, mainMenu), true);
+		runScene("HiScoreMenu", new HiScoreMenu(config, game, display, mainMenu), true);
+		runScene("CreditsMenu", new CreditsMenu(config, game, display, mainMenu), true);
+	}
+	mainMenu->Deactivate();
+	delete mainMenu;
+	mainMenu = nullptr;
+
+	// Each level, with a fresh game state so an earlier level can't end the tour.
+	std::vector<std::string>* levels = game->getLevels();
+	for (std::string& path : *levels) {
+		GameState* gameState = new GameState();
+		gameState->addLives(game->getInitialLives());
+		gameState->setState(GAME_CONTINUE);
+		runScene(path, new Level(config, game, display, gameState, path), true);
+		delete gameState;
+	}
+	csv.close();
+	return true;
+}
+
+bool BenchmarkTour::runScene(const std::string& name, IAppState* scene, bool cleanup) {
+	FrameStats* stats = display->getFrameStats();
+	const double frequency = (double) SDL_GetPerformanceFrequency();
+
+	Uint64 start = SDL_GetPerformanceCounter();
+	bool active = scene->Activate();
+	double load = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / frequency;
+
+	if (active) {
+		stats->reset();
+		unsigned int drawCalls = WorkCounters::getTotal(WORK_DRAW_CALLS);
+		// The scene runs until the display reaches the frame limit and requests it to quit.
+		scene->Run();
+		drawCalls = WorkCounters::getTotal(WORK_DRAW_CALLS) - drawCalls;
+		// The first frame only marks the start of the recording.
+		const int count = stats->getFrames();
+		const double mean = stats->getMeanFrameTime();
+		const double p99 = stats->getFrameTime(0.99);
+		csv << name << "," << count << "," << load << "," << mean << "," << p99 << ","
+		    << ((mean > 0.0) ? (1000.0 / mean) : 0.0) << "," << ((double) drawCalls / (count + 1)) << std::endl;
+		g_message("%s[%d] : %s: %d frames, load %.1f ms, avg %.2f ms, p99 %.2f ms", __FILE__, __LINE__,
+		          name.c_str(), count, load, mean, p99);
+	} else {
+		g_warning("%s[%d] : Benchmark scene %s failed to activate", __FILE__, __LINE__, name.c_str());
+	}
+	if (cleanup) {
+		scene->Deactivate();
+		delete scene;
+	}
+	return active;
+}
@@ -0,0 +1,98 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef BENCHMARKTOUR_H
+#define BENCHMARKTOUR_H
+
+#include "config.h"
+
+#include <string>
+#include <fstream>
+
+// main.h includes the gettext, sdl, etc items
+#include "main.h"
+#include "IAppState.h"
+#include "Configuration.h"
+#include "GameConfiguration.h"
+#include "Display.h"
+#include "MainMenu.h"
+
+/**
+ * @brief The default number of frames to render for each scene of the tour.
+ */
+#define OCCILLO_TOUR_FRAMES 300
+
+/**
+ * @brief A rendering benchmark that runs each menu and then each level for a fixed number of frames.
+ *
+ * The scenes are run in turn, (the levels with the auto pilot), and the load time, frame times and
+ * draw calls of each are written as a row of a CSV file.
+ */
+class BenchmarkTour : public IAppState {
+  public:
+	/**
+	 * @brief Create a new benchmark tour.
+	 * @param config The application configuration.
+	 * @param game The game configuration.
+	 * @param display The display.
+	 * @param output The CSV file to write.
+	 * @param frames The number of frames to render for each scene.
+	 */
+	BenchmarkTour(Configuration* config, GameConfiguration* game, Display* display, const std::string& output, int frames);
+	~BenchmarkTour();
+
+	bool Run();
+	bool Activate();
+	void Deactivate();
+
+  private:
+	/**
+	 * @brief The application configuration.
+	 */
+	Configuration* config;
+	/**
+	 * @brief The game configuration.
+	 */
+	GameConfiguration* game;
+	/**
+	 * @brief The display.
+	 */
+	Display* display;
+	/**
+	 * @brief The number of frames to render for each scene.
+	 */
+	int frames;
+	/**
+	 * @brief The CSV output.
+	 */
+	std::ofstream csv;
+	/**
+	 * @brief The main menu, (kept for the sub menus which share its background and cursor).
+	 */
+	MainMenu* mainMenu;
+	/**
+	 * @brief Run the given scene and write its results.
+	 * @param name The name of the scene.
+	 * @param scene The scene to run.
+	 * @param cleanup TRUE to deactivate and delete the scene once run.
+	 * @return TRUE if the scene activated.
+	 */
+	bool runScene(const std::string& name, IAppState* scene, bool cleanup);
+};
+
+#endif /* BENCHMARKTOUR_H */
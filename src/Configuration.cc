@@ -31,6 +31,11 @@ Configuration::Configuration() {
 	fullscreen = OCCILLO_DEFAULT_FULLSCREEN;
 	displayHeight = OCCILLO_DEFAULT_RES_HEIGHT;
 	displayWidth = OCCILLO_DEFAULT_RES_WIDTH;
+	logicalWidth = OCCILLO_DEFAULT_LOGICAL_WIDTH;
+	logicalHeight = OCCILLO_DEFAULT_LOGICAL_HEIGHT;
+	dynamicScaleMin = OCCILLO_DEFAULT_DYNAMIC_SCALE_MIN;
+	dynamicScaleMax = OCCILLO_DEFAULT_DYNAMIC_SCALE_MAX;
+	dynamicScaleFps = OCCILLO_DEFAULT_DYNAMIC_SCALE_FPS;
 	sndVolume = OCCILLO_DEFAULT_VOLUME;
 	musicVolume = OCCILLO_DEFAULT_VOLUME;
 	dataPath = PACKAGE_DATADIR;
@@ -40,18 +45,32 @@ Configuration::Configuration() {
 	controllerDeadZone = OCCILLO_DEFAULT_CONTROLLERDEADZONE;
 	menuFocusAlpha = OCCILLO_DEFAULT_MENUFOCUSALPHA;
 	menuNonFocusAlpha = OCCILLO_DEFAULT_MENUNONFOCUSALPHA;
+	autoPlay = OCCILLO_DEFAULT_AUTOPLAY;
+	soundCache = OCCILLO_DEFAULT_SOUND_CACHE;
+	musicCache = OCCILLO_DEFAULT_MUSIC_CACHE;
+	lowDpi = OCCILLO_DEFAULT_LOW_DPI;
+	softwareCursor = OCCILLO_DEFAULT_SOFTWARE_CURSOR;
+	simulationRate = OCCILLO_DEFAULT_SIMULATION_RATE;
+	workerThreads = OCCILLO_DEFAULT_WORKER_THREADS;
 #ifdef _WIN32
 	registryDataPath = getInstallPath();
         g_info("%s[%d] : Installation Path: %s", __FILE__, __LINE__, registryDataPath.c_str());
 #else
 	registryDataPath = "";
 #endif
+	g_mutex_init(&resourceLock);
+	packChecked = false;
 }
 
 Configuration::Configuration(const Configuration& orig) {
 	fullscreen = orig.fullscreen;
 	displayHeight = orig.displayHeight;
 	displayWidth = orig.displayWidth;
+	logicalWidth = orig.logicalWidth;
+	logicalHeight = orig.logicalHeight;
+	dynamicScaleMin = orig.dynamicScaleMin;
+	dynamicScaleMax = orig.dynamicScaleMax;
+	dynamicScaleFps = orig.dynamicScaleFps;
 	sndVolume = orig.sndVolume;
 	musicVolume = orig.musicVolume;
 	dataPath = orig.dataPath;
@@ -60,10 +79,21 @@ Configuration::Configuration(const Configuration& orig) {
 	controllerDeadZone = orig.controllerDeadZone;
 	menuFocusAlpha = orig.menuFocusAlpha;
 	menuNonFocusAlpha = orig.menuNonFocusAlpha;
+	autoPlay = orig.autoPlay;
+	soundCache = orig.soundCache;
+	musicCache = orig.musicCache;
+	lowDpi = orig.lowDpi;
+	softwareCursor = orig.softwareCursor;
+	simulationRate = orig.simulationRate;
+	workerThreads = orig.workerThreads;
+	overrides = orig.overrides;
 	registryDataPath = orig.registryDataPath;
+	g_mutex_init(&resourceLock);
+	packChecked = false;
 }
 
 Configuration::~Configuration() {
+	g_mutex_clear(&resourceLock);
 }
 
 bool Configuration::load(const std::string& file) {
@@ -101,6 +131,18 @@ bool Configuration::load(const std::string& file) {
 			setControllerDeadZone(g_key_file_get_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_CONTROLLERDEADZONE, nullptr));
 			setMenuFocusAlpha(g_key_file_get_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_MENUFOCUSALPHA, nullptr));
 			setMenuNonFocusAlpha(g_key_file_get_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_MENUNONFOCUSALPHA, nullptr));
+			setAutoPlay(g_key_file_get_boolean(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_AUTOPLAY, nullptr));
+			setSoundCache(g_key_file_get_boolean(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_SOUND_CACHE, nullptr));
+			setMusicCache(g_key_file_get_boolean(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_MUSIC_CACHE, nullptr));
+			setLowDpi(g_key_file_get_boolean(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_LOW_DPI, nullptr));
+			setSoftwareCursor(g_key_file_get_boolean(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_SOFTWARE_CURSOR, nullptr));
+			setSimulationRate(g_key_file_get_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_SIMULATION_RATE, nullptr));
+			setWorkerThreads(g_key_file_get_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_WORKER_THREADS, nullptr));
+			setLogicalWidth(g_key_file_get_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_LOGICAL_WIDTH, nullptr));
+			setLogicalHeight(g_key_file_get_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_LOGICAL_HEIGHT, nullptr));
+			setDynamicScaleMin(g_key_file_get_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_DYNAMIC_SCALE_MIN, nullptr));
+			setDynamicScaleMax(g_key_file_get_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_DYNAMIC_SCALE_MAX, nullptr));
+			setDynamicScaleFps(g_key_file_get_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_DYNAMIC_SCALE_FPS, nullptr));
 		} catch (...) {
 			g_info("%s[%d] : config file load failed.", __FILE__, __LINE__);
 			g_key_file_free(keyfile);
@@ -117,19 +159,6 @@ bool Configuration::store(const std::string& file) {
 	GKeyFile *keyfile;
 	GError *error = nullptr;
 
-	keyfile = g_key_file_new();
-	g_key_file_set_boolean(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_FULLSCREEN, fullscreen);
-	g_key_file_set_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_DISPLAY_HEIGHT, displayHeight);
-	g_key_file_set_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_DISPLAY_WIDTH, displayWidth);
-	g_key_file_set_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_SOUND_VOLUME, sndVolume);
-	g_key_file_set_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_MUSIC_VOLUME, musicVolume);
-	g_key_file_set_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_SOUND_BUFFER_SIZE, soundBufferSize);
-	g_key_file_set_string(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_DATA_PATH, dataPath.c_str());
-	g_key_file_set_string(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_GAME_CONFIGURATION, gameConfiguration.c_str());
-	g_key_file_set_string(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_PLAYERNAME, playerName.c_str());
-	g_key_file_set_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_CONTROLLERDEADZONE, controllerDeadZone);
-	g_key_file_set_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_MENUFOCUSALPHA, menuFocusAlpha);
-	g_key_file_set_integer(keyfile, PACKAGE_NAME, OCCILLO_CONFIGURATION_SETTING_MENUNONFOCUSALPHA, menuNonFocusAlpha);
 	std::string* basepath = locateConfigFile();
 	if (basepath == nullptr) {
 		basepath = new std::string;
@@ -137,6 +166,36 @@ bool Configuration::store(const std::string& file) {
 	// Ensure base path exists.
 	mkdirs(*basepath);
 	*basepath += file;
+
+	keyfile = g_key_file_new();
+	if (!overrides.empty()) {
+		// Start from the stored settings so overridden settings keep their stored value.
+		g_key_file_load_from_file(keyfile, basepath->c_str(), G_KEY_FILE_NONE, nullptr);
+	}
+	setBooleanField(keyfile, OCCILLO_CONFIGURATION_SETTING_FULLSCREEN, fullscreen);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_DISPLAY_HEIGHT, displayHeight);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_DISPLAY_WIDTH, displayWidth);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_SOUND_VOLUME, sndVolume);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_MUSIC_VOLUME, musicVolume);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_SOUND_BUFFER_SIZE, soundBufferSize);
+	setStringField(keyfile, OCCILLO_CONFIGURATION_SETTING_DATA_PATH, dataPath);
+	setStringField(keyfile, OCCILLO_CONFIGURATION_SETTING_GAME_CONFIGURATION, gameConfiguration);
+	setStringField(keyfile, OCCILLO_CONFIGURATION_SETTING_PLAYERNAME, playerName);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_CONTROLLERDEADZONE, controllerDeadZone);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_MENUFOCUSALPHA, menuFocusAlpha);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_MENUNONFOCUSALPHA, menuNonFocusAlpha);
+	setBooleanField(keyfile, OCCILLO_CONFIGURATION_SETTING_AUTOPLAY, autoPlay);
+	setBooleanField(keyfile, OCCILLO_CONFIGURATION_SETTING_SOUND_CACHE, soundCache);
+	setBooleanField(keyfile, OCCILLO_CONFIGURATION_SETTING_MUSIC_CACHE, musicCache);
+	setBooleanField(keyfile, OCCILLO_CONFIGURATION_SETTING_LOW_DPI, lowDpi);
+	setBooleanField(keyfile, OCCILLO_CONFIGURATION_SETTING_SOFTWARE_CURSOR, softwareCursor);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_SIMULATION_RATE, simulationRate);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_WORKER_THREADS, workerThreads);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_LOGICAL_WIDTH, logicalWidth);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_LOGICAL_HEIGHT, logicalHeight);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_DYNAMIC_SCALE_MIN, dynamicScaleMin);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_DYNAMIC_SCALE_MAX, dynamicScaleMax);
+	setIntegerField(keyfile, OCCILLO_CONFIGURATION_SETTING_DYNAMIC_SCALE_FPS, dynamicScaleFps);
 	g_info("%s[%d] : Storing config file %s", __FILE__, __LINE__, basepath->c_str());
 
 	if (!g_key_file_save_to_file(keyfile, basepath->c_str(), &error)) {
@@ -187,6 +246,74 @@ void Configuration::setDisplayHeight(int height) {
 
 }
 
+int Configuration::getLogicalWidth() {
+	return logicalWidth;
+}
+
+void Configuration::setLogicalWidth(int width) {
+	if (width < 0 || width >= 8192) {
+		return;
+	}
+	logicalWidth = width;
+	g_info("%s[%d] : Configuration: Logical Width %d", __FILE__, __LINE__, width);
+}
+
+int Configuration::getLogicalHeight() {
+	return logicalHeight;
+}
+
+void Configuration::setLogicalHeight(int height) {
+	if (height < 0 || height >= 4096) {
+		return;
+	}
+	logicalHeight = height;
+	g_info("%s[%d] : Configuration: Logical Height %d", __FILE__, __LINE__, height);
+}
+
+int Configuration::getDynamicScaleMin() {
+	return dynamicScaleMin;
+}
+
+void Configuration::setDynamicScaleMin(int percent) {
+	if (percent < 10 || percent > 100) {
+		return;
+	}
+	dynamicScaleMin = percent;
+	g_info("%s[%d] : Configuration: Dynamic scale minimum %d%%", __FILE__, __LINE__, percent);
+}
+
+int Configuration::getDynamicScaleMax() {
+	return dynamicScaleMax;
+}
+
+void Configuration::setDynamicScaleMax(int percent) {
+	if (percent < 10 || percent > 100) {
+		return;
+	}
+	dynamicScaleMax = percent;
+	g_info("%s[%d] : Configuration: Dynamic scale maximum %d%%", __FILE__, __LINE__, percent);
+}
+
+int Configuration::getDynamicScaleFps() {
+	return dynamicScaleFps;
+}
+
+void Configuration::setDynamicScaleFps(int fps) {
+	if (fps <= 0 || fps > 1000) {
+		return;
+	}
+	dynamicScaleFps = fps;
+	g_info("%s[%d] : Configuration: Dynamic scale target %d fps", __FILE__, __LINE__, fps);
+}
+
+int Configuration::getRenderWidth() {
+	return ((logicalWidth > 0) && (logicalHeight > 0)) ? logicalWidth : displayWidth;
+}
+
+int Configuration::getRenderHeight() {
+	return ((logicalWidth > 0) && (logicalHeight > 0)) ? logicalHeight : displayHeight;
+}
+
 int Configuration::getSoundEffectVolume() {
 	return sndVolume;
 }
@@ -238,6 +365,7 @@ std::string* Configuration::getDataPath() {
 
 void Configuration::setDataPath(const std::string& dataPath) {
 	this->dataPath = dataPath;
+	clearResourceIndex();
 	g_info("%s[%d] : Configuration: Data Path %s", __FILE__, __LINE__, dataPath.c_str());
 
 }
@@ -269,7 +397,12 @@ std::string Configuration::locateMultiResource(const std::string& resources){
 	  if(i != 0){
 			result += ";";
 		}
-		result += locateResource(values[i]);				
+		if (!values[i].empty() && (values[i][0] == '@')) {
+			// Animation options, (see Texture), not a file.
+			result += values[i];
+		} else {
+			result += locateResource(values[i]);
+		}
 	}
 	return result;
 }
@@ -280,39 +413,108 @@ std::string Configuration::locateResource(const std::string& resource) {
 		return locateMultiResource(resource);
 	}
 
-	std::string file = resource;
-	g_info("%s[%d] : Locating resource %s", __FILE__, __LINE__, file.c_str());
+	g_mutex_lock(&resourceLock);
+	std::unordered_map<std::string, std::string>::iterator it = resources.find(resource);
+	std::string result;
+	if (it != resources.end()) {
+		result = it->second;
+	} else {
+		result = findResource(resource);
+		// Misses aren't kept, as the file may be created later.
+		if (!result.empty()) {
+			resources.insert(std::make_pair(resource, result));
+		}
+	}
+	g_mutex_unlock(&resourceLock);
+	return result;
+}
+
+std::string Configuration::findResource(const std::string& resource) {
+	g_info("%s[%d] : Locating resource %s", __FILE__, __LINE__, resource.c_str());
+	if (!packChecked) {
+		openResourcePack();
+	}
+	// Packed resources take precedence, so the loose files are only for resources not in the pack.
+	if (ResourcePack::contains(resource)) {
+		std::string packed = ResourcePack::getPath(resource);
+		g_info("%s[%d] : Found resource %s", __FILE__, __LINE__, packed.c_str());
+		return packed;
+	}
 	/*
-	 * Determine if file exists... if not, then try to prepend config->getDataPath() to it.
+	 * The file as given, then under the data path, the path stored in the registry, (the MSI installer
+	 * will set this), and the package datadir, (compile time installation path).
 	 */
-	if (g_file_test(file.c_str(), G_FILE_TEST_EXISTS)) {
-		g_info("%s[%d] : Found resource %s", __FILE__, __LINE__, file.c_str());
-		return file;
+	std::vector<std::string> candidates;
+	candidates.push_back(resource);
+	candidates.push_back(dataPath + G_DIR_SEPARATOR_S + resource);
+	if (!registryDataPath.empty()) {
+		candidates.push_back(registryDataPath + G_DIR_SEPARATOR_S + resource);
+	}
+	candidates.push_back(PACKAGE_DATADIR G_DIR_SEPARATOR_S + resource);
+
+	for (const std::string& candidate : candidates) {
+		if (isIndexed(candidate)) {
+			g_info("%s[%d] : Found resource %s", __FILE__, __LINE__, candidate.c_str());
+			return candidate;
+		}
 	}
-	// File doesn't exist. Add datapath to it...
-	std::string file2 = dataPath + G_DIR_SEPARATOR_S + file;
-	if (g_file_test(file2.c_str(), G_FILE_TEST_EXISTS)) {
-		g_info("%s[%d] : Found resource %s", __FILE__, __LINE__, file2.c_str());
-		return file2;
+	// Not in the directory listings, (eg a case insensitive file system), so probe as before.
+	for (const std::string& candidate : candidates) {
+		if (g_file_test(candidate.c_str(), G_FILE_TEST_EXISTS)) {
+			g_info("%s[%d] : Found resource %s", __FILE__, __LINE__, candidate.c_str());
+			return candidate;
+		}
 	}
+	g_info("%s[%d] : Resource not found? %s", __FILE__, __LINE__, resource.c_str());
+	return "";
+}
 
-	// Use value as stored in registry, the MSI installer will set this.
-	if (!registryDataPath.empty()) {
-		file2 = registryDataPath + G_DIR_SEPARATOR_S + file;
-		if (g_file_test(file2.c_str(), G_FILE_TEST_EXISTS)) {
-			g_info("%s[%d] : Found resource %s", __FILE__, __LINE__, file2.c_str());
-			return file2;
+bool Configuration::isIndexed(const std::string& file) {
+	gchar* dir = g_path_get_dirname(file.c_str());
+	gchar* name = g_path_get_basename(file.c_str());
+	std::string directory(dir);
+	std::string entry(name);
+	g_free(dir);
+	g_free(name);
+
+	std::unordered_map<std::string, std::unordered_set<std::string> >::iterator it = directories.find(directory);
+	if (it == directories.end()) {
+		// Read the directory once, (a missing directory is indexed as empty).
+		std::unordered_set<std::string> entries;
+		GDir* d = g_dir_open(directory.c_str(), 0, nullptr);
+		if (d != nullptr) {
+			const gchar* e;
+			while ((e = g_dir_read_name(d)) != nullptr) {
+				entries.insert(std::string(e));
+			}
+			g_dir_close(d);
 		}
+		it = directories.insert(std::make_pair(directory, entries)).first;
 	}
+	return it->second.find(entry) != it->second.end();
+}
+
+void Configuration::clearResourceIndex() {
+	g_mutex_lock(&resourceLock);
+	resources.clear();
+	directories.clear();
+	packChecked = false;
+	g_mutex_unlock(&resourceLock);
+}
 
-	// datapath + file doesn't exit, try again with package datadir (compile time installation path)
-	file2 = PACKAGE_DATADIR G_DIR_SEPARATOR_S + file;
-	if (g_file_test(file2.c_str(), G_FILE_TEST_EXISTS)) {
-		g_info("%s[%d] : Found resource %s", __FILE__, __LINE__, file2.c_str());
-		return file2;
+void Configuration::openResourcePack() {
+	packChecked = true;
+	std::vector<std::string> candidates;
+	candidates.push_back(dataPath + G_DIR_SEPARATOR_S OCCILLO_RESOURCEPACK_FILE);
+	if (!registryDataPath.empty()) {
+		candidates.push_back(registryDataPath + G_DIR_SEPARATOR_S OCCILLO_RESOURCEPACK_FILE);
+	}
+	candidates.push_back(PACKAGE_DATADIR G_DIR_SEPARATOR_S OCCILLO_RESOURCEPACK_FILE);
+	for (const std::string& candidate : candidates) {
+		if (isIndexed(candidate) && ResourcePack::open(candidate)) {
+			return;
+		}
 	}
-	g_info("%s[%d] : Resource not found? %s", __FILE__, __LINE__, file.c_str());
-	return "";
 }
 
 std::string* Configuration::locateConfigFile() {
@@ -419,6 +621,24 @@ std::string Configuration::getDefaultUserName() {
 #endif
 }
 
+void Configuration::setBooleanField(GKeyFile *keyfile, const char* key, bool value) {
+	if (!isOverridden(key)) {
+		g_key_file_set_boolean(keyfile, PACKAGE_NAME, key, value);
+	}
+}
+
+void Configuration::setIntegerField(GKeyFile *keyfile, const char* key, int value) {
+	if (!isOverridden(key)) {
+		g_key_file_set_integer(keyfile, PACKAGE_NAME, key, value);
+	}
+}
+
+void Configuration::setStringField(GKeyFile *keyfile, const char* key, const std::string& value) {
+	if (!isOverridden(key)) {
+		g_key_file_set_string(keyfile, PACKAGE_NAME, key, value.c_str());
+	}
+}
+
 std::string Configuration::getStringField(GKeyFile *keyfile, const char* key) {
 	gchar* str = g_key_file_get_string(keyfile, PACKAGE_NAME, key, nullptr);
 	if (str == nullptr) {
@@ -453,6 +673,78 @@ void Configuration::setControllerDeadZone(int deadzone) {
 	this->controllerDeadZone = deadzone;
 }
 
+bool Configuration::isAutoPlay() {
+	return autoPlay;
+}
+
+void Configuration::setAutoPlay(bool autoPlay) {
+	this->autoPlay = autoPlay;
+	g_info("%s[%d] : Configuration: Auto play %d", __FILE__, __LINE__, autoPlay);
+}
+
+bool Configuration::isSoundCache() {
+	return soundCache;
+}
+
+void Configuration::setSoundCache(bool soundCache) {
+	this->soundCache = soundCache;
+	g_info("%s[%d] : Configuration: Sound cache %d", __FILE__, __LINE__, soundCache);
+}
+
+bool Configuration::isMusicCache() {
+	return musicCache;
+}
+
+void Configuration::setMusicCache(bool musicCache) {
+	this->musicCache = musicCache;
+	g_info("%s[%d] : Configuration: Music cache %d", __FILE__, __LINE__, musicCache);
+}
+
+bool Configuration::isLowDpi() {
+	return lowDpi;
+}
+
+void Configuration::setLowDpi(bool lowDpi) {
+	this->lowDpi = lowDpi;
+	g_info("%s[%d] : Configuration: Low DPI %d", __FILE__, __LINE__, lowDpi);
+}
+
+bool Configuration::isSoftwareCursor() {
+	return softwareCursor;
+}
+
+void Configuration::setSoftwareCursor(bool softwareCursor) {
+	this->softwareCursor = softwareCursor;
+	g_info("%s[%d] : Configuration: Software cursor %d", __FILE__, __LINE__, softwareCursor);
+}
+
+int Configuration::getSimulationRate() {
+	return simulationRate;
+}
+
+void Configuration::setSimulationRate(int rate) {
+	simulationRate = (rate > 0) ? rate : 0;
+	g_info("%s[%d] : Configuration: Simulation rate %d", __FILE__, __LINE__, simulationRate);
+}
+
+int Configuration::getWorkerThreads() {
+	return workerThreads;
+}
+
+void Configuration::setWorkerThreads(int workers) {
+	workerThreads = (workers > 0) ? workers : 0;
+	g_info("%s[%d] : Configuration: Worker threads %d", __FILE__, __LINE__, workerThreads);
+}
+
+void Configuration::setOverride(const std::string& key) {
+	overrides.insert(key);
+	g_info("%s[%d] : Configuration: %s overridden for this session", __FILE__, __LINE__, key.c_str());
+}
+
+bool Configuration::isOverridden(const std::string& key) {
+	return overrides.find(key) != overrides.end();
+}
+
 #ifdef _WIN32
 
 std::string getInstallPath() {
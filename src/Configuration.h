@@ -20,6 +20,9 @@
 #define CONFIGURATION_H
 #include <iostream>
 #include <string>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <glib.h>
 #include <cerrno>
 #include <sys/stat.h>
@@ -33,6 +36,7 @@
 #include "config.h"
 
 #include "StringUtil.h"
+#include "ResourcePack.h"
 
 #define OCCILLO_DEFAULT_GAME "game/game.ini"
 #define OCCILLO_DEFAULT_FULLSCREEN false
@@ -44,6 +48,18 @@
 #define OCCILLO_DEFAULT_MENUFOCUSALPHA 255
 #define OCCILLO_DEFAULT_MENUNONFOCUSALPHA 180
 #define OCCILLO_DEFAULT_CONTROLLERDEADZONE 8000
+#define OCCILLO_DEFAULT_AUTOPLAY false
+#define OCCILLO_DEFAULT_SOUND_CACHE false
+#define OCCILLO_DEFAULT_MUSIC_CACHE false
+#define OCCILLO_DEFAULT_LOW_DPI false
+#define OCCILLO_DEFAULT_SOFTWARE_CURSOR false
+#define OCCILLO_DEFAULT_SIMULATION_RATE 0
+#define OCCILLO_DEFAULT_WORKER_THREADS 0
+#define OCCILLO_DEFAULT_LOGICAL_WIDTH 0
+#define OCCILLO_DEFAULT_LOGICAL_HEIGHT 0
+#define OCCILLO_DEFAULT_DYNAMIC_SCALE_MIN 100
+#define OCCILLO_DEFAULT_DYNAMIC_SCALE_MAX 100
+#define OCCILLO_DEFAULT_DYNAMIC_SCALE_FPS 60
 
 #define OCCILLO_CONFIGURATION_SETTING_FULLSCREEN "fullscreen"
 #define OCCILLO_CONFIGURATION_SETTING_DISPLAY_WIDTH "displayWidth"
@@ -57,6 +73,18 @@
 #define OCCILLO_CONFIGURATION_SETTING_MENUFOCUSALPHA "menuFoucsAlpha"
 #define OCCILLO_CONFIGURATION_SETTING_MENUNONFOCUSALPHA "menuNonFoucsAlpha"
 #define OCCILLO_CONFIGURATION_SETTING_CONTROLLERDEADZONE "controllerDeadZone"
+#define OCCILLO_CONFIGURATION_SETTING_AUTOPLAY "autoPlay"
+#define OCCILLO_CONFIGURATION_SETTING_SOUND_CACHE "soundCache"
+#define OCCILLO_CONFIGURATION_SETTING_MUSIC_CACHE "musicCache"
+#define OCCILLO_CONFIGURATION_SETTING_LOW_DPI "lowDpi"
+#define OCCILLO_CONFIGURATION_SETTING_SOFTWARE_CURSOR "softwareCursor"
+#define OCCILLO_CONFIGURATION_SETTING_SIMULATION_RATE "simulationRate"
+#define OCCILLO_CONFIGURATION_SETTING_WORKER_THREADS "workerThreads"
+#define OCCILLO_CONFIGURATION_SETTING_LOGICAL_WIDTH "logicalWidth"
+#define OCCILLO_CONFIGURATION_SETTING_LOGICAL_HEIGHT "logicalHeight"
+#define OCCILLO_CONFIGURATION_SETTING_DYNAMIC_SCALE_MIN "dynamicScaleMin"
+#define OCCILLO_CONFIGURATION_SETTING_DYNAMIC_SCALE_MAX "dynamicScaleMax"
+#define OCCILLO_CONFIGURATION_SETTING_DYNAMIC_SCALE_FPS "dynamicScaleFps"
 
 /**
  * @brief The engine configuration for display and audio.
@@ -118,6 +146,66 @@ public:
      * @param height The requested height
      */
     void setDisplayHeight(int height);
+    /**
+     * Get the logical width the game is rendered at, (scaled to the display).
+     * @return The logical width, (0 to render at the display size).
+     */
+    int getLogicalWidth();
+    /**
+     * Set the logical width the game is rendered at, (scaled to the display).
+     * @param width The logical width, (0 to render at the display size).
+     */
+    void setLogicalWidth(int width);
+    /**
+     * Get the logical height the game is rendered at, (scaled to the display).
+     * @return The logical height, (0 to render at the display size).
+     */
+    int getLogicalHeight();
+    /**
+     * Set the logical height the game is rendered at, (scaled to the display).
+     * @param height The logical height, (0 to render at the display size).
+     */
+    void setLogicalHeight(int height);
+    /**
+     * Get the width the game is laid out and its assets rasterized at.
+     * @return The logical width if set, otherwise the display width.
+     */
+    int getRenderWidth();
+    /**
+     * Get the height the game is laid out and its assets rasterized at.
+     * @return The logical height if set, otherwise the display height.
+     */
+    int getRenderHeight();
+    /**
+     * Get the smallest scale the level playfield may be rendered at, as frame times rise.
+     * @return The scale in percent, (100 for no dynamic resolution).
+     */
+    int getDynamicScaleMin();
+    /**
+     * Set the smallest scale the level playfield may be rendered at, as frame times rise.
+     * @param percent The scale in percent, (100 for no dynamic resolution).
+     */
+    void setDynamicScaleMin(int percent);
+    /**
+     * Get the largest scale the level playfield is rendered at with dynamic resolution.
+     * @return The scale in percent.
+     */
+    int getDynamicScaleMax();
+    /**
+     * Set the largest scale the level playfield is rendered at with dynamic resolution.
+     * @param percent The scale in percent.
+     */
+    void setDynamicScaleMax(int percent);
+    /**
+     * Get the frame rate dynamic resolution aims for.
+     * @return The frames per second.
+     */
+    int getDynamicScaleFps();
+    /**
+     * Set the frame rate dynamic resolution aims for.
+     * @param fps The frames per second.
+     */
+    void setDynamicScaleFps(int fps);
     /**
      * Get the sound effect volume
      * @return The volume (0-100) 0 = mute.
@@ -179,6 +267,76 @@ public:
      * @param deadzone The dead zone value.
      */
     void setControllerDeadZone(int deadzone);
+    /**
+     * Get if the paddle is to be controlled by the auto pilot.
+     * @return TRUE if the game plays itself.
+     */
+    bool isAutoPlay();
+    /**
+     * Set if the paddle is to be controlled by the auto pilot.
+     * @param autoPlay TRUE to have the game play itself.
+     */
+    void setAutoPlay(bool autoPlay);
+    /**
+     * Get if decoded sound effects are kept in the user cache directory between runs.
+     * @return TRUE if decoded sounds are kept.
+     */
+    bool isSoundCache();
+    /**
+     * Set if decoded sound effects are kept in the user cache directory between runs.
+     * @param soundCache TRUE to keep decoded sounds.
+     */
+    void setSoundCache(bool soundCache);
+    /**
+     * Get if music is rendered once to PCM in the user cache directory and the rendered copy played.
+     * @return TRUE if rendered music is used.
+     */
+    bool isMusicCache();
+    /**
+     * Set if music is rendered once to PCM in the user cache directory and the rendered copy played.
+     * @param musicCache TRUE to use rendered music.
+     */
+    void setMusicCache(bool musicCache);
+    /**
+     * Get if HiDPI displays are rendered at the window size, (and upscaled by the system), rather than the pixel size.
+     * @return TRUE to render at the window size.
+     */
+    bool isLowDpi();
+    /**
+     * Set if HiDPI displays are rendered at the window size, (and upscaled by the system), rather than the pixel size.
+     * @param lowDpi TRUE to render at the window size.
+     */
+    void setLowDpi(bool lowDpi);
+    /**
+     * Get if the menu pointer is always drawn by the renderer, rather than by the system as a hardware cursor.
+     * @return TRUE to always draw the pointer.
+     */
+    bool isSoftwareCursor();
+    /**
+     * Set if the menu pointer is always drawn by the renderer, rather than by the system as a hardware cursor.
+     * @param softwareCursor TRUE to always draw the pointer.
+     */
+    void setSoftwareCursor(bool softwareCursor);
+    /**
+     * Get the rate at which the level is simulated on its own thread.
+     * @return The steps per second, (0 to simulate once per frame on the render thread).
+     */
+    int getSimulationRate();
+    /**
+     * Set the rate at which the level is simulated on its own thread.
+     * @param rate The steps per second, (0 to simulate once per frame on the render thread).
+     */
+    void setSimulationRate(int rate);
+    /**
+     * Get the number of job system worker threads.
+     * @return The number of workers, (0 for one less than the number of cores).
+     */
+    int getWorkerThreads();
+    /**
+     * Set the number of job system worker threads.
+     * @param workers The number of workers, (0 for one less than the number of cores).
+     */
+    void setWorkerThreads(int workers);
     /**
      * Get the height in pixels of a single unit.
      * @return The heigh in pixels
@@ -239,6 +397,22 @@ public:
      * @return A delimited path to the resources, or an empty string if the resource can't be found.
      */
     std::string locateMultiResource(const std::string& resources);
+    /**
+     * @brief Mark the given setting as overridden for this session only, (eg from the command line).
+     *
+     * Overridden settings keep their previously stored value when the configuration is stored.
+     *
+     * @param key The setting, (one of OCCILLO_CONFIGURATION_SETTING_*).
+     */
+    void setOverride(const std::string& key);
+    /**
+     * @brief Determine if the given setting is overridden for this session.
+     *
+     * @param key The setting, (one of OCCILLO_CONFIGURATION_SETTING_*).
+     *
+     * @return TRUE if the setting is overridden.
+     */
+    bool isOverridden(const std::string& key);
 
 private:
     /**
@@ -253,6 +427,26 @@ private:
      * @brief The display height to use/set.
      */
     int displayHeight;
+    /**
+     * @brief The logical width to render at, (0 for the display width).
+     */
+    int logicalWidth;
+    /**
+     * @brief The logical height to render at, (0 for the display height).
+     */
+    int logicalHeight;
+    /**
+     * @brief The smallest dynamic resolution scale in percent, (100 for none).
+     */
+    int dynamicScaleMin;
+    /**
+     * @brief The largest dynamic resolution scale in percent.
+     */
+    int dynamicScaleMax;
+    /**
+     * @brief The frame rate dynamic resolution aims for.
+     */
+    int dynamicScaleFps;
     /**
      * @brief The sound effects volume to use. (O = off, 100 = max).
      */
@@ -277,10 +471,58 @@ private:
      * @brief The controller dead zone (default = 8000).
      */
     int controllerDeadZone;
+    /**
+     * @brief Flag for auto play mode, (TRUE = paddle is controlled by the auto pilot).
+     */
+    bool autoPlay;
+    /**
+     * @brief Flag to keep decoded sound effects in the user cache directory.
+     */
+    bool soundCache;
+    /**
+     * @brief Flag to play music rendered to PCM.
+     */
+    bool musicCache;
+    /**
+     * @brief Flag to render HiDPI displays at the window size.
+     */
+    bool lowDpi;
+    /**
+     * @brief Flag to always draw the menu pointer with the renderer.
+     */
+    bool softwareCursor;
+    /**
+     * @brief The simulation thread steps per second, (0 for no simulation thread).
+     */
+    int simulationRate;
+    /**
+     * @brief The job system worker threads, (0 for one less than the number of cores).
+     */
+    int workerThreads;
+    /**
+     * @brief The settings overridden for this session, and not to be stored.
+     */
+    std::set<std::string> overrides;
     /**
      * @brief The data path for game assets.
      */
     std::string dataPath;
+    /**
+     * @brief The located resources, by resource name, (resources not found are searched for again).
+     */
+    std::unordered_map<std::string, std::string> resources;
+    /**
+     * @brief The entries of each directory searched for resources, read once.
+     */
+    std::unordered_map<std::string, std::unordered_set<std::string> > directories;
+    /**
+     * @brief Lock for the resource index, (levels are located from a background thread).
+     */
+    GMutex resourceLock;
+    /**
+     * @brief TRUE once the data directories have been searched for a resource pack.
+     */
+    bool packChecked;
     /**
      * @brief The data path for game assets as stored in the win32 registry
      */
@@ -298,6 +540,26 @@ private:
      * @return The configuration file.
      */
     std::string* locateConfigFile();
+    /**
+     * Search the data directories for the given resource, (with the resource lock held).
+     * @param resource The resource to locate.
+     * @return A path to the resource, or an empty string if the resource can't be found.
+     */
+    std::string findResource(const std::string& resource);
+    /**
+     * Determine if the given file is in the index of its directory, (reading the directory if needed).
+     * @param file The file.
+     * @return TRUE if the directory holds the file.
+     */
+    bool isIndexed(const std::string& file);
+    /**
+     * Discard the resource index, (eg when the data path changes).
+     */
+    void clearResourceIndex();
+    /**
+     * Map the resource pack from the first data directory holding one, (with the resource lock held).
+     */
+    void openResourcePack();
     /**
      * make all folders as specified in the path
      * @param path The path to create.
@@ -319,6 +581,30 @@ private:
      * @return The value for the given key.
      */
     std::string getStringField(GKeyFile *keyfile, const char* key);
+    /**
+     * @brief Set the boolean field for key, unless the setting is overridden.
+     *
+     * @param keyfile The keyfile
+     * @param key The key to set
+     * @param value The value
+     */
+    void setBooleanField(GKeyFile *keyfile, const char* key, bool value);
+    /**
+     * @brief Set the integer field for key, unless the setting is overridden.
+     *
+     * @param keyfile The keyfile
+     * @param key The key to set
+     * @param value The value
+     */
+    void setIntegerField(GKeyFile *keyfile, const char* key, int value);
+    /**
+     * @brief Set the string field for key, unless the setting is overridden.
+     *
+     * @param keyfile The keyfile
+     * @param key The key to set
+     * @param value The value
+     */
+    void setStringField(GKeyFile *keyfile, const char* key, const std::string& value);
 
 };
 
@@ -66,6 +66,15 @@ GameConfiguration::GameConfiguration() {
 
 	brickHitSpeedIncreaseRatio = 3.0;
 	awardBonusLife = -1;
+
+	soundChannels = OCCILLO_VOICEMANAGER_CHANNELS;
+	soundCoalesceTime = OCCILLO_VOICEMANAGER_COALESCE_TIME;
+	soundMaxVoices = OCCILLO_VOICEMANAGER_MAX_VOICES;
+	brickHitPriority = 0;
+	paddleHitPriority = 1;
+	ballLossPriority = 2;
+	animationRate = OCCILLO_TEXTURE_ANIMATION_RATE;
+	animationMode = nullptr;
 }
 
 GameConfiguration::~GameConfiguration() {
@@ -92,6 +101,7 @@ GameConfiguration::~GameConfiguration() {
 		free(tcol);
 	}
 	delete credits;
+	delete animationMode;
 	delete applicationIcon;
 	delete highScoreTable;
 	delete textdomain;
@@ -105,7 +115,11 @@ bool GameConfiguration::load(const std::string& file) {
 	keyfile = g_key_file_new();
 
 	g_info("%s[%d] : Looking for game config file %s", __FILE__, __LINE__, file.c_str());
-	if (!g_key_file_load_from_file(keyfile, file.c_str(), flags, &error)) {
+	const char* data = nullptr;
+	size_t size = 0;
+	bool loaded = ResourcePack::find(file, &data, &size) ? g_key_file_load_from_data(keyfile, data, size, flags, &error)
+	              : g_key_file_load_from_file(keyfile, file.c_str(), flags, &error);
+	if (!loaded) {
 		g_info("%s[%d] : game config file error: %s", __FILE__, __LINE__, error->message);
 		g_key_file_free(keyfile);
 		g_error_free(error);
@@ -155,6 +169,14 @@ bool GameConfiguration::load(const std::string& file) {
 			setField(keyfile, paddleWidthRatio, OCCILLO_GAMECONFIGURATION_SETTING_PADDLE_WIDTH);
 			setField(keyfile, brickHitSpeedIncreaseRatio, OCCILLO_GAMECONFIGURATION_SETTING_BRICK_HIT_INCREASE);
 			setField(keyfile, awardBonusLife, OCCILLO_GAMECONFIGURATION_SETTING_AWARD_LIFE);
+			setField(keyfile, soundChannels, OCCILLO_GAMECONFIGURATION_SETTING_SOUND_CHANNELS);
+			setField(keyfile, soundCoalesceTime, OCCILLO_GAMECONFIGURATION_SETTING_SOUND_COALESCE);
+			setField(keyfile, soundMaxVoices, OCCILLO_GAMECONFIGURATION_SETTING_SOUND_VOICES);
+			setField(keyfile, brickHitPriority, OCCILLO_GAMECONFIGURATION_SETTING_BRICK_HIT_PRIORITY);
+			setField(keyfile, paddleHitPriority, OCCILLO_GAMECONFIGURATION_SETTING_PADDLE_HIT_PRIORITY);
+			setField(keyfile, ballLossPriority, OCCILLO_GAMECONFIGURATION_SETTING_BALL_LOSS_PRIORITY);
+			setField(keyfile, animationRate, OCCILLO_GAMECONFIGURATION_SETTING_ANIMATION_RATE);
+			setField(keyfile, animationMode, OCCILLO_GAMECONFIGURATION_SETTING_ANIMATION_MODE);
 
 			processLevels(g_key_file_get_string_list(keyfile, PACKAGE_NAME, OCCILLO_GAMECONFIGURATION_SETTING_LEVELS, nullptr, nullptr));
 		} catch (...) {
@@ -309,6 +331,38 @@ int GameConfiguration::getAwardBonusLife() {
   return awardBonusLife;
 }
 
+int GameConfiguration::getSoundChannels() {
+	return soundChannels;
+}
+
+int GameConfiguration::getSoundCoalesceTime() {
+	return soundCoalesceTime;
+}
+
+int GameConfiguration::getSoundMaxVoices() {
+	return soundMaxVoices;
+}
+
+int GameConfiguration::getBrickHitPriority() {
+	return brickHitPriority;
+}
+
+int GameConfiguration::getPaddleHitPriority() {
+	return paddleHitPriority;
+}
+
+int GameConfiguration::getBallLossPriority() {
+	return ballLossPriority;
+}
+
+int GameConfiguration::getAnimationRate() {
+	return animationRate;
+}
+
+std::string* GameConfiguration::getAnimationMode() {
+	return animationMode;
+}
+
 std::string* GameConfiguration::getTextDomain(){
   return textdomain;
 }
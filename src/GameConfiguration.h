@@ -29,6 +29,9 @@
 #include "config.h"
 #include "main.h"
 #include "HighScoreTable.h"
+#include "VoiceManager.h"
+#include "Texture.h"
+#include "ResourcePack.h"
 
 #define OCCILLO_GAMECONFIGURATION_SETTING_FONT "font"
 #define OCCILLO_GAMECONFIGURATION_SETTING_FONTBOLD "fontbold"
@@ -67,6 +70,14 @@
 #define OCCILLO_GAMECONFIGURATION_SETTING_PADDLE_WIDTH "paddleWidthRatio"
 #define OCCILLO_GAMECONFIGURATION_SETTING_BRICK_HIT_INCREASE "brickHitSpeedIncreaseRatio"
 #define OCCILLO_GAMECONFIGURATION_SETTING_AWARD_LIFE "awardBonusLife"
+#define OCCILLO_GAMECONFIGURATION_SETTING_SOUND_CHANNELS "soundChannels"
+#define OCCILLO_GAMECONFIGURATION_SETTING_SOUND_COALESCE "soundCoalesceTime"
+#define OCCILLO_GAMECONFIGURATION_SETTING_SOUND_VOICES "soundMaxVoices"
+#define OCCILLO_GAMECONFIGURATION_SETTING_BRICK_HIT_PRIORITY "brickHitPriority"
+#define OCCILLO_GAMECONFIGURATION_SETTING_PADDLE_HIT_PRIORITY "paddleHitPriority"
+#define OCCILLO_GAMECONFIGURATION_SETTING_BALL_LOSS_PRIORITY "ballLossPriority"
+#define OCCILLO_GAMECONFIGURATION_SETTING_ANIMATION_RATE "animationRate"
+#define OCCILLO_GAMECONFIGURATION_SETTING_ANIMATION_MODE "animationMode"
 #define OCCILLO_GAMECONFIGURATION_SETTING_GAME_NAME "gamename"
 #define OCCILLO_GAMECONFIGURATION_SETTING_TEXTDOMAIN "textdomain"
 
@@ -324,6 +335,63 @@ class GameConfiguration {
 	*/
 	int getAwardBonusLife();
 
+	/**
+	* @brief Get the number of mixing channels to allocate for sound effects.
+	*
+	* @return The number of mixing channels.
+	*/
+	int getSoundChannels();
+
+	/**
+	* @brief Get the time in ms within which repeated plays of the same sound effect are played once.
+	*
+	* @return The coalesce time in ms, (0 to play every sound).
+	*/
+	int getSoundCoalesceTime();
+
+	/**
+	* @brief Get the maximum number of channels that may play the same sound effect.
+	*
+	* @return The maximum number of voices per sound.
+	*/
+	int getSoundMaxVoices();
+
+	/**
+	* @brief Get the priority of the brick hit sound. When all channels are busy, a sound may take the
+	* channel of a sound with a lower priority.
+	*
+	* @return The priority of the brick hit sound.
+	*/
+	int getBrickHitPriority();
+
+	/**
+	* @brief Get the priority of the paddle hit sound.
+	*
+	* @return The priority of the paddle hit sound.
+	*/
+	int getPaddleHitPriority();
+
+	/**
+	* @brief Get the priority of the ball loss sound.
+	*
+	* @return The priority of the ball loss sound.
+	*/
+	int getBallLossPriority();
+
+	/**
+	* @brief Get the frame rate of animated textures that don't give their own, (see Texture).
+	*
+	* @return The frame rate, (frames per second).
+	*/
+	int getAnimationRate();
+
+	/**
+	* @brief Get the mode of animated textures that don't give their own, ("loop", "pingpong" or "once").
+	*
+	* @return The animation mode.
+	*/
+	std::string* getAnimationMode();
+
 
 	/**
 	* @brief Get the text domain to utilise for this game instance.
@@ -381,6 +449,15 @@ class GameConfiguration {
 
 	int awardBonusLife;
 
+	int soundChannels;
+	int soundCoalesceTime;
+	int soundMaxVoices;
+	int brickHitPriority;
+	int paddleHitPriority;
+	int ballLossPriority;
+	int animationRate;
+	std::string* animationMode;
+
 	/**
 	* @brief Process a list of levels
 	*
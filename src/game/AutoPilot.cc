@@ -0,0 +1,163 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "AutoPilot.h"
+
+AutoPilot::AutoPilot(Ball* ball, Paddle* paddle, Brick** bricks, int bricksWidth, int bricksHigh, unsigned int seed) :
+	ball(ball), paddle(paddle), bricks(bricks), bricksWidth(bricksWidth), bricksHigh(bricksHigh), random(seed) {
+	serveTime = 0.0;
+	serveX = -1;
+	idleTime = 0.0;
+	lastScore = -1;
+	aim = 0.0;
+	descending = false;
+}
+
+AutoPilot::~AutoPilot() {
+	// NOP
+}
+
+double AutoPilot::nextRandom() {
+	return (((double) (random() - random.min()) / (double) (random.max() - random.min())) * 2.0) - 1.0;
+}
+
+void AutoPilot::update(double timeElapsed, bool ballInPlay, int score) {
+	const double paddleWidth = paddle->getWidth();
+	if (!ballInPlay) {
+		// Wander to a random serve position, so each serve takes a different angle.
+		if (serveX < 0) {
+			serveX = paddle->getX() + (int) (nextRandom() * paddleWidth * 2.0);
+		}
+		paddle->steer(serveX);
+		serveTime += timeElapsed;
+		idleTime = 0.0;
+		descending = false;
+		return;
+	}
+	serveX = -1;
+	if (score != lastScore) {
+		lastScore = score;
+		idleTime = 0.0;
+	} else {
+		idleTime += timeElapsed;
+	}
+	// Choose a new point on the paddle to hit each time the ball starts to fall.
+	const bool down = std::sin(ball->getDirection()) > 0.0;
+	if (down && !descending) {
+		aim = nextRandom() * paddleWidth * OCCILLO_AUTOPILOT_AIM_RATIO;
+	}
+	descending = down;
+
+	double x = predict();
+	if (x < 0.0) {
+		x = ball->getX() + (ball->getWidth() / 2.0);
+	}
+	paddle->steer((int) (x - (paddleWidth / 2.0) + aim));
+}
+
+bool AutoPilot::serve() {
+	if (serveTime >= OCCILLO_AUTOPILOT_SERVE_DELAY) {
+		serveTime = 0.0;
+		return true;
+	}
+	return false;
+}
+
+bool AutoPilot::bump() {
+	if (idleTime >= OCCILLO_AUTOPILOT_BUMP_DELAY) {
+		g_info("%s[%d] : Auto pilot, no score in %f secs", __FILE__, __LINE__, idleTime);
+		idleTime = 0.0;
+		return true;
+	}
+	return false;
+}
+
+double AutoPilot::predict() {
+	const double w = ball->getWidth();
+	const double h = ball->getHeight();
+	const double direction = ball->getDirection();
+	const double speed = ball->getSpeed();
+	// The y co-ordinate of the ball when it touches the paddle.
+	const double paddleY = paddle->getY() - h;
+	const int n = bricksWidth * bricksHigh;
+
+	double x = ball->getX();
+	double y = ball->getY();
+	double vx = std::cos(direction) * speed;
+	double vy = std::sin(direction) * speed;
+	double remaining = OCCILLO_AUTOPILOT_HORIZON;
+
+	for (int bounce = 0; (bounce < OCCILLO_AUTOPILOT_MAX_BOUNCES) && (remaining > 0.0); bounce++) {
+		// Determine how far to look ahead, either up to the paddle or the horizon.
+		double step = remaining;
+		bool reachesPaddle = false;
+		if (vy > 0.0) {
+			double t = (paddleY - y) / vy;
+			if (t <= step) {
+				step = std::max(t, 0.0);
+				reachesPaddle = true;
+			}
+		}
+		Box path = Box(x, y, w, h, vx * step, vy * step);
+		Box sweep = Box::getBroadphaseBox(path);
+
+		// Find the first brick along the path.
+		double first = 1.0;
+		Brick* hit = nullptr;
+		for (int i = 0; i < n; i++) {
+			Brick* b = bricks[i];
+			if ((b == nullptr) || (b->getHitCount() <= 0)) {
+				continue;
+			}
+			Box brick = Box(b->getX(), b->getY(), b->getWidth(), b->getHeight(), 0.0, 0.0);
+			if (Box::AABBCheck(sweep, brick)) {
+				double t = Box::sweptAABB(path, brick);
+				if (t < first) {
+					first = t;
+					hit = b;
+				}
+			}
+		}
+
+		if (hit == nullptr) {
+			x += vx * step;
+			y += vy * step;
+			if (reachesPaddle) {
+				return x + (w / 2.0);
+			}
+			remaining -= step;
+			continue;
+		}
+
+		// Move to the brick and rebound, (as per Ball::collision(Brick*)).
+		x += vx * step * first;
+		y += vy * step * first;
+		remaining -= step * first;
+		const double centerX = x + (w / 2.0);
+		const double centerY = y + (w / 2.0);
+		if (((centerX < hit->getX()) && (vx > 0.0))
+		        || ((centerX > (hit->getX() + hit->getWidth())) && (vx < 0.0))) {
+			vx = -vx;
+		}
+		if (((centerY > (hit->getY() + hit->getHeight())) && (vy < 0.0))
+		        || ((centerY < hit->getY()) && (vy > 0.0))) {
+			vy = -vy;
+		}
+	}
+	return -1.0;
+}
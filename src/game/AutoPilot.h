@@ -0,0 +1,158 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef GAME_AUTOPILOT_H
+#define GAME_AUTOPILOT_H
+
+#include "config.h"
+
+#include <cmath>
+#include <random>
+
+#include "Brick.h"
+#include "Paddle.h"
+#include "Ball.h"
+#include "Box.h"
+
+/**
+ * @brief The time in seconds to wait with the ball on the paddle before serving.
+ */
+#define OCCILLO_AUTOPILOT_SERVE_DELAY 1.0
+/**
+ * @brief The time in seconds without a score change before the ball is bumped.
+ */
+#define OCCILLO_AUTOPILOT_BUMP_DELAY 15.0
+/**
+ * @brief The maximum number of brick rebounds to follow when predicting the ball path.
+ */
+#define OCCILLO_AUTOPILOT_MAX_BOUNCES 32
+/**
+ * @brief The maximum time in seconds to follow the ball path when predicting.
+ */
+#define OCCILLO_AUTOPILOT_HORIZON 8.0
+/**
+ * @brief The maximum offset from the center of the paddle to aim for, (as a ratio of the paddle width).
+ */
+#define OCCILLO_AUTOPILOT_AIM_RATIO 0.35
+
+/**
+ * @brief Paddle controller that plays the game, used in place of keyboard, mouse or controller input.
+ *
+ * The auto pilot follows the path of the ball through the brick field (using the same swept AABB
+ * tests as the ball) to find where it will meet the paddle, and steers the paddle there.
+ */
+class AutoPilot {
+  public:
+	/**
+	 * @brief Create a new auto pilot.
+	 *
+	 * @param ball The ball to track.
+	 * @param paddle The paddle to steer.
+	 * @param bricks The array of all bricks in the level.
+	 * @param bricksWidth The number of bricks wide the play area is.
+	 * @param bricksHigh The number of bricks high the play area is.
+	 * @param seed The seed for the aim/serve randomisation.
+	 */
+	AutoPilot(Ball* ball, Paddle* paddle, Brick** bricks, int bricksWidth, int bricksHigh, unsigned int seed);
+	virtual ~AutoPilot();
+	/**
+	 * @brief Update the paddle steering, (to be called before the paddle is moved).
+	 *
+	 * @param timeElapsed The time elapsed since the last update.
+	 * @param ballInPlay TRUE if the ball is in free movement.
+	 * @param score The current score.
+	 */
+	void update(double timeElapsed, bool ballInPlay, int score);
+	/**
+	 * @brief Determine if the ball should be served.
+	 *
+	 * @return TRUE if the ball should be put into play.
+	 */
+	bool serve();
+	/**
+	 * @brief Determine if the ball should be bumped, (the ball is stuck in a loop not hitting bricks).
+	 *
+	 * @return TRUE if the ball should be bumped.
+	 */
+	bool bump();
+	/**
+	 * @brief Predict where the ball will meet the paddle.
+	 *
+	 * @return The x co-ordinate of the center of the ball when it reaches the paddle, or -1.0 if
+	 * it could not be determined.
+	 */
+	double predict();
+
+  private:
+	/**
+	 * @brief The ball being tracked.
+	 */
+	Ball* ball;
+	/**
+	 * @brief The paddle being steered.
+	 */
+	Paddle* paddle;
+	/**
+	 * @brief The array of all bricks in the level.
+	 */
+	Brick** bricks;
+	/**
+	 * @brief The number of bricks wide the play area is.
+	 */
+	const int bricksWidth;
+	/**
+	 * @brief The number of bricks high the play area is.
+	 */
+	const int bricksHigh;
+	/**
+	 * @brief The time the ball has been waiting on the paddle.
+	 */
+	double serveTime;
+	/**
+	 * @brief The x co-ordinate to serve the ball from.
+	 */
+	int serveX;
+	/**
+	 * @brief The time since the score last changed.
+	 */
+	double idleTime;
+	/**
+	 * @brief The score at the last update.
+	 */
+	int lastScore;
+	/**
+	 * @brief The offset from the center of the paddle to hit the ball with.
+	 */
+	double aim;
+	/**
+	 * @brief Flag to indicate the ball was moving down at the last update.
+	 */
+	bool descending;
+	/**
+	 * @brief The random source for aim and serve positions.
+	 */
+	std::minstd_rand random;
+	/**
+	 * @brief Get a random value in the range [-1.0, 1.0].
+	 *
+	 * @return A random value.
+	 */
+	double nextRandom();
+};
+
+#endif /* GAME_AUTOPILOT_H */
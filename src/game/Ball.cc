@@ -58,6 +58,10 @@ void Ball::render(SDL_Renderer* renderer) {
 	texture->render(renderer, location.x, location.y);
 }
 
+void Ball::render(SDL_Renderer* renderer, int x, int y) {
+	texture->render(renderer, x, y);
+}
+
 void Ball::move(double timeElapsed) {
 	location.x += (velocity.x * timeElapsed);
 	location.y += (velocity.y * timeElapsed);
@@ -96,6 +100,7 @@ double Ball::getSpeed() {
 }
 
 double Ball::collision(Brick* brick, double timeElapsed) {
+	WorkCounters::add(WORK_COLLISION_TESTS);
 	if (brick == nullptr) {
 		return 1.0;
 	}
@@ -115,6 +120,7 @@ double Ball::collision(Brick* brick, double timeElapsed) {
 }
 
 double Ball::collision(Paddle* paddle, double timeElapsed) {
+	WorkCounters::add(WORK_COLLISION_TESTS);
 	// Convert the ball/brick into boxes.
 	Box ball = Box(location.x, location.y, texture->getWidth(), texture->getHeight(), velocity.x * timeElapsed, velocity.y * timeElapsed);
 	Box ballSweep = Box::getBroadphaseBox(ball);
@@ -78,6 +78,14 @@ class Ball {
 	*/
 	void render(SDL_Renderer* renderer);
 	/**
+	* @brief Render the ball at the given position, (eg as recorded in a snapshot).
+	*
+	* @param renderer The renderer to use.
+	* @param x The x co-ordinate.
+	* @param y The y co-ordinate.
+	*/
+	void render(SDL_Renderer* renderer, int x, int y);
+	/**
 	* @brief Have the ball move along it's path for the given time
 	*
 	* @param timeElapsed The amount of time since the ball last moved.
@@ -45,6 +45,7 @@ Box Box::getBroadphaseBox(Box b) {
 }
 
 double Box::sweptAABB(Box b1, Box b2) {
+    WorkCounters::add(WORK_SWEPT_AABB);
     double xInvEntry, yInvEntry;
     double xInvExit, yInvExit;
 
@@ -29,6 +29,8 @@
 #include <limits>
 #include <algorithm>
 
+#include "WorkCounters.h"
+
 /**
  * Representation of an axis aligned box region.
  */
@@ -18,9 +18,9 @@
 
 #include "BrickDestructionAnimation.h"
 
-BrickDestructionAnimation::BrickDestructionAnimation(Texture *texture, int x, int y, uint32_t animationTime, uint32_t gravity, bool small) :
+BrickDestructionAnimation::BrickDestructionAnimation(const FrameClock& clock, Texture *texture, int x, int y, uint32_t animationTime, uint32_t gravity, bool small) :
 texture(texture), x(x), y(y), animationTime(animationTime), gravity(gravity), small(small) {
-    this->startTime = SDL_GetTicks();
+    this->startTime = clock.getTime();
     for (int i = 0; i < 16; i++) {
         double j = (i < 8) ? 2 : 5;
         deltas[3 * i] = ((double) std::rand() / (double) RAND_MAX); // x velocity
@@ -33,17 +33,21 @@ BrickDestructionAnimation::~BrickDestructionAnimation() {
     // texture is owned by original brick, so don't destroy.
 }
 
-bool BrickDestructionAnimation::isComplete() {
-    return ((SDL_GetTicks() - startTime) > animationTime);
+bool BrickDestructionAnimation::isComplete(const FrameClock& clock) {
+    return ((clock.getTime() - startTime) > animationTime);
 }
 
-bool BrickDestructionAnimation::reset() {
-    this->startTime = SDL_GetTicks();
+bool BrickDestructionAnimation::reset(const FrameClock& clock) {
+    this->startTime = clock.getTime();
     return true;
 }
 
-void BrickDestructionAnimation::render(SDL_Renderer* renderer) {
-    float timeDelta = (float) (SDL_GetTicks() - startTime);
+bool BrickDestructionAnimation::isPlayfield() {
+    return true;
+}
+
+void BrickDestructionAnimation::render(SDL_Renderer* renderer, const FrameClock& clock) {
+    float timeDelta = (float) (clock.getTime() - startTime);
     float alpha = 255.0f - (timeDelta / (float) animationTime * 255.0f);
     texture->setAlpha((Uint8) alpha);
     if (small) {
@@ -31,6 +31,7 @@ class BrickDestructionAnimation : public GameAnimation {
 public:
     /**
      * Create a new title animation sequence.
+     * @param clock The frame clock, (the animation starts at the current frame).
      * @param texture The texture to animate. (Is owned by this object).
      * @param x The x co-ordinate to display.
      * @param y The y co-ordinate to display.
@@ -38,15 +39,17 @@ public:
      * @param gravity The vertical drop rate.
      * @param small TRUE for small explosion animation.
      */
-    BrickDestructionAnimation(Texture *texture, int x, int y, uint32_t animationTime, uint32_t gravity = 0, bool small = false);
+    BrickDestructionAnimation(const FrameClock& clock, Texture *texture, int x, int y, uint32_t animationTime, uint32_t gravity = 0, bool small = false);
 
     virtual ~BrickDestructionAnimation();
 
-    bool isComplete();
+    bool isComplete(const FrameClock& clock);
 
-    bool reset();
+    bool reset(const FrameClock& clock);
 
-    void render(SDL_Renderer* renderer);
+    void render(SDL_Renderer* renderer, const FrameClock& clock);
+
+    bool isPlayfield();
 
 private:
     /**
@@ -31,14 +31,14 @@ bool EndGame::Activate() {
 	if (widgets == nullptr) {
 		// As we are using text input, enable SDL...
 		SDL_StartTextInput();
-		const int dh = config->getDisplayHeight();
-		const int dw = config->getDisplayWidth();
+		const int dh = config->getRenderHeight();
+		const int dw = config->getRenderWidth();
 		const int bh = dh / MENU_ROWS;
 		//  const int bw = dw / MENU_COLUMNS;
 		//  const int menuA = config->getMenuFocusAlpha();
 		//  const int menuNA = config->getMenuNonFocusAlpha();
-		TTF_Font * fontTitle = TTF_OpenFont(config->locateResource(*(game->getFontBold())).c_str(), bh * 3 / 2);
-		TTF_Font * font = TTF_OpenFont(config->locateResource(*(game->getFont())).c_str(), bh);
+		TTF_Font * fontTitle = display->getFontCache()->getFont(config->locateResource(*(game->getFontBold())), bh * 3 / 2);
+		TTF_Font * font = display->getFontCache()->getFont(config->locateResource(*(game->getFont())), bh);
 
 		widgets = new std::vector<IUIWidget*>();
 
@@ -79,7 +79,7 @@ bool EndGame::Activate() {
 			newLabel(dstr, font, 6);
 			newLabel(_("Player Name:"), font, 8);
 
-			UIText* textinput = new UIText(TTF_OpenFont(config->locateResource(*(game->getFont())).c_str(), bh), game->getTitleFontColour(), renderer);
+			UIText* textinput = new UIText(display->getFontCache()->getFont(config->locateResource(*(game->getFont())), bh), game->getTitleFontColour(), renderer);
 			textinput->setXY(dw, bh * 10);
 			textinput->setCenter(true);
 			textinput->setText(*(config->getPlayerName()));
@@ -101,23 +101,19 @@ bool EndGame::Activate() {
 			text->loadFromColour(renderer, Texture::getColour(), bh, bh);
 		}
 		cursor = new UICursor(text, dw, dh);
-
-		TTF_CloseFont(fontTitle);
-		TTF_CloseFont(font);
+		if (!config->isSoftwareCursor()) {
+			cursor->setHardwareCursor(renderer, config->locateResource(*(game->getCursor())), bh);
+		}
 
 		// Setup the music.
 		if (game->getTitleMusic() != nullptr) {
-			backgroundMusic = Mix_LoadMUS(config->locateResource(*(game->getTitleMusic())).c_str());
+			backgroundMusic = display->getMusicCache()->load(config->locateResource(*(game->getTitleMusic())));
 			if (backgroundMusic == nullptr) {
 				g_info("%s[%d] Could not load background music! SDL_Mixer Error: %s", __FILE__, __LINE__, Mix_GetError());
 			}
 			// Start music.
 			if (backgroundMusic != nullptr) {
-				if (Mix_PlayingMusic() != 0) {
-
-					Mix_HaltMusic();
-				}
-				Mix_PlayMusic(backgroundMusic, -1);
+				display->getMusicCache()->play(backgroundMusic, -1);
 			}
 			// Set the music volume
 			Mix_VolumeMusic(config->getMusicVolume());
@@ -134,7 +130,7 @@ void EndGame::Deactivate() {
 
 	if (backgroundMusic != nullptr) {
 		// Stop music...
-		Mix_HaltMusic();
+		display->getMusicCache()->halt();
 		Mix_FreeMusic(backgroundMusic);
 		backgroundMusic = nullptr;
 	}
@@ -163,8 +159,8 @@ void EndGame::event(IUIWidget *widget) {
 }
 
 void EndGame::newLabel(const std::string& text, TTF_Font *font, int y) {
-	const int dh = config->getDisplayHeight();
-	const int dw = config->getDisplayWidth();
+	const int dh = config->getRenderHeight();
+	const int dw = config->getRenderWidth();
 	const int bh = dh / MENU_ROWS;
 	IUIWidget* widget = new UILabel(text, font, game->getTitleFontColour(), renderer);
 	widget->setXY((dw / 2) - (widget->getWidth() / 2), bh * y);
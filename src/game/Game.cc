@@ -25,6 +25,7 @@ Game::Game(Configuration* config, GameConfiguration* game, Display* display) :
 	gameState->addLives(game->getInitialLives());
 	gameState->setState(NEXT_LEVEL);
 	completed = false;
+	prefetch = nullptr;
 }
 
 Game::~Game() {
@@ -41,12 +42,34 @@ bool Game::Activate() {
 		SDL_SetRelativeMouseMode(SDL_TRUE);
 		std::vector<std::string>* levels = game->getLevels();
 		int currentLevel = gameState->getLevel() % levels->size();
+		if ((currentLevel == 0) && (gameState->getLevel() != 0)) {
+			g_message("%s[%d] : Campaign complete, score %d, lives %d", __FILE__, __LINE__,
+			          gameState->getScore(), gameState->getLives());
+		}
 		gameState->incLevel();
 		gameState->setState(GAME_CONTINUE);
-		IAppState* level = new Level(config, game, display, gameState, (*levels)[currentLevel]);
+		// The level takes the prefetch, (and discards it if it was for another level).
+		IAppState* level = new Level(config, game, display, gameState, (*levels)[currentLevel], prefetch);
+		// Start loading the level after this one while this one is played.
+		prefetch = new LevelPrefetch(config, game, display->getSoundCache(), (*levels)[(currentLevel + 1) % levels->size()]);
 		getApplicationState()->push(level);
 		return true;
 	}
+	if (!completed && gameState->getState() == GAME_END && config->isAutoPlay()) {
+		// Auto play skips the high score entry. If the game was lost start over, otherwise the player quit.
+		g_message("%s[%d] : Auto play game over at level %d, score %d", __FILE__, __LINE__,
+		          gameState->getLevel(), gameState->getScore());
+		if (gameState->getLives() == 0) {
+			delete gameState;
+			gameState = new GameState();
+			gameState->addLives(game->getInitialLives());
+			gameState->setState(NEXT_LEVEL);
+			return Activate();
+		}
+		completed = true;
+		SDL_SetRelativeMouseMode(SDL_FALSE);
+		return false;
+	}
 	if (!completed && gameState->getState() == GAME_END) {
 		// The game has completed, so create a End Game application state and push onto the application state stack.
 		completed = true;
@@ -61,6 +84,10 @@ bool Game::Activate() {
 }
 
 void Game::Deactivate() {
+	if (prefetch != nullptr) {
+		delete prefetch;
+		prefetch = nullptr;
+	}
 	if (gameState != nullptr) {
 		delete gameState;
 		gameState = nullptr;
@@ -78,6 +78,10 @@ class Game : public IAppState {
 	* @brief completed flag that the current game is complete.
 	*/
 	bool completed;
+	/**
+	* @brief The next level, being loaded in the background while the current level is played.
+	*/
+	LevelPrefetch* prefetch;
 
 	/**
 	* @brief The current game state.
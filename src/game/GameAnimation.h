@@ -20,6 +20,7 @@
 #define GAME_GAMEANIMATION_H
 
 #include "UIImage.h"
+#include "FrameClock.h"
 
 /**
  * @brief Interface for Game Animation elements.
@@ -32,20 +33,31 @@ public:
     
     /**
      * @brief Is the animation complete?
+     * @param clock The frame clock.
      * @return TRUE if the animation sequence is complete
      */
-    virtual bool isComplete() = 0;
+    virtual bool isComplete(const FrameClock& clock) = 0;
 
     /**
      * @brief reset the internal state of the animation sequence
+     * @param clock The frame clock.
      * @return TRUE if the reset of the animation state completed successfully.
      */
-    virtual bool reset() = 0;
+    virtual bool reset(const FrameClock& clock) = 0;
     /**
      * Render the UI element.
      * @param renderer The SDL renderer.
+     * @param clock The frame clock.
      */
-    virtual void render(SDL_Renderer* renderer) = 0;
+    virtual void render(SDL_Renderer* renderer, const FrameClock& clock) = 0;
+    /**
+     * @brief Is the animation part of the field of play, (drawn with it at the dynamic resolution),
+     * rather than an overlay drawn at the native resolution?
+     * @return TRUE if part of the field of play.
+     */
+    virtual bool isPlayfield() {
+        return false;
+    };
 };
 
 #endif /* GAMEANIMATION_H */
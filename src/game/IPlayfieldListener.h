@@ -0,0 +1,62 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef GAME_IPLAYFIELDLISTENER_H
+#define GAME_IPLAYFIELDLISTENER_H
+
+#include "Brick.h"
+
+/**
+ * @brief Interface for receiving events from the playfield, (used to drive sounds and animations).
+ */
+class IPlayfieldListener {
+  public:
+	virtual ~IPlayfieldListener() {
+	}
+	/**
+	 * @brief The ball has collided with a brick.
+	 * @param brick The brick that was hit.
+	 */
+	virtual void brickCollision(Brick* brick) = 0;
+	/**
+	 * @brief A brick has taken a hit, (directly or from a bomb), and the score has been updated.
+	 * @param brick The brick that was hit.
+	 */
+	virtual void brickHit(Brick* brick) = 0;
+	/**
+	 * @brief A bonus life has been awarded for the score reached.
+	 * @param brick The brick that was hit.
+	 */
+	virtual void bonusLife(Brick* brick) = 0;
+	/**
+	 * @brief The ball has collided with the paddle.
+	 */
+	virtual void paddleCollision() = 0;
+	/**
+	 * @brief The ball has left the field of play, and a life lost.
+	 */
+	virtual void ballLost() = 0;
+	/**
+	 * @brief The ball has been bumped.
+	 * @param x The x co-ordinate of the ball.
+	 * @param y The y co-ordinate of the ball.
+	 */
+	virtual void ballBumped(int x, int y) = 0;
+};
+
+#endif /* GAME_IPLAYFIELDLISTENER_H */
@@ -19,43 +19,41 @@
 
 #include "Level.h"
 
-Level::Level(Configuration *config, GameConfiguration* game, Display* display, GameState* state, const std::string& path) :
-	config(config), gameConfig(game), display(display), gameState(state), levelPath(path),
+Level::Level(Configuration *config, GameConfiguration* game, Display* display, GameState* state, const std::string& path,
+             LevelPrefetch* prefetch) :
+	config(config), gameConfig(game), display(display), gameState(state), levelPath(path), prefetch(prefetch),
 	bricksWidth(game->getNumberBricksWide()), bricksHigh(game->getNumberBricksHigh()) {
 	textures = nullptr;
 	numTextures = 0;
 	renderer = display->getRenderer();
-	bricks = nullptr;
-	paddle = nullptr;
-	ball = nullptr;
+	playfield = nullptr;
+	autoPilot = nullptr;
+	simulation = nullptr;
+	snapshot = nullptr;
+	scaler = nullptr;
 	lastLives = -1;
 	lastScore = -1;
 	fontScore = nullptr;
 	fontTitle = nullptr;
+	fontTitleOutline = nullptr;
 	fontBonus = nullptr;
+	fontBonusOutline = nullptr;
 	livesTexture = nullptr;
 	scoreTexture = nullptr;
-	timeElapsed = SDL_GetTicks();
-	ballInPlay = false;
+	clock = display->getFrameClock();
 	backgroundMusic = nullptr;
 	brickHitSound = nullptr;
 	paddleHitSound = nullptr;
 	ballLossSound = nullptr;
-	initialSpeed = 1.0;
 	doneEndGameAnimation = false;
-	baseValue = 10;
-	bumpBall = false;
-	bonusProbability = 10;
-	bonusProbabilities[0] = 40;
-	bonusProbabilities[1] = 60;
-	bonusProbabilities[2] = 80;
-	bonusProbabilities[3] = 90;
-	bonusProbabilities[4] = 94;
-	bonusProbabilities[5] = 99;
 }
 
 Level::~Level() {
 	cleanup();
+	if (prefetch != nullptr) {
+		delete prefetch;
+		prefetch = nullptr;
+	}
 }
 
 void Level::cleanup() {
@@ -65,13 +63,22 @@ void Level::cleanup() {
 		delete textures;
 		textures = nullptr;
 	}
-	if (ball != nullptr) {
-		delete ball;
-		ball = nullptr;
+	if (simulation != nullptr) {
+		delete simulation;
+		simulation = nullptr;
+	}
+	snapshot = nullptr;
+	if (scaler != nullptr) {
+		delete scaler;
+		scaler = nullptr;
+	}
+	if (autoPilot != nullptr) {
+		delete autoPilot;
+		autoPilot = nullptr;
 	}
-	if (paddle != nullptr) {
-		delete paddle;
-		paddle = nullptr;
+	if (playfield != nullptr) {
+		delete playfield;
+		playfield = nullptr;
 	}
 	if (livesTexture != nullptr) {
 		delete livesTexture;
@@ -81,47 +88,29 @@ void Level::cleanup() {
 		delete scoreTexture;
 		scoreTexture = nullptr;
 	}
-	if (fontScore != nullptr) {
-		TTF_CloseFont(fontScore);
-		fontScore = nullptr;
-	}
-	if (fontTitle != nullptr) {
-		TTF_CloseFont(fontTitle);
-		fontTitle = nullptr;
-	}
-	if (fontBonus != nullptr) {
-		TTF_CloseFont(fontBonus);
-		fontBonus = nullptr;
-	}
-	const int n = bricksWidth * bricksHigh;
-	if (bricks != nullptr) {
-		for (int i = 0; i < n; i++) {
-			Brick* b = bricks[i];
-			if (b != nullptr) {
-				delete b;
-			}
-			bricks[i] = nullptr;
-		}
-		delete[] bricks;
-		bricks = nullptr;
-	}
+	// The fonts belong to the font cache.
+	fontScore = nullptr;
+	fontTitle = nullptr;
+	fontTitleOutline = nullptr;
+	fontBonus = nullptr;
+	fontBonusOutline = nullptr;
 	// stop all sounds
-	Mix_HaltMusic();
+	display->getMusicCache()->halt();
 	Mix_HaltChannel(-1);
 	if (backgroundMusic != nullptr) {
 		Mix_FreeMusic(backgroundMusic);
 		backgroundMusic = nullptr;
 	}
 	if (brickHitSound != nullptr) {
-		Mix_FreeChunk(brickHitSound);
+		display->getSoundCache()->release(brickHitSound);
 		brickHitSound = nullptr;
 	}
 	if (paddleHitSound != nullptr) {
-		Mix_FreeChunk(paddleHitSound);
+		display->getSoundCache()->release(paddleHitSound);
 		paddleHitSound = nullptr;
 	}
 	if (ballLossSound != nullptr) {
-		Mix_FreeChunk(ballLossSound);
+		display->getSoundCache()->release(ballLossSound);
 		ballLossSound = nullptr;
 	}
 }
@@ -137,32 +126,39 @@ void Level::Deactivate() {
 bool Level::Run() {
 	// Setup break ground music...
 	if (backgroundMusic != nullptr) {
-		if (Mix_PlayingMusic() != 0) {
-			Mix_HaltMusic();
-		}
-		Mix_PlayMusic(backgroundMusic, -1);
+		display->getMusicCache()->play(backgroundMusic, -1);
 	}
 	// Set the music volume
 	Mix_VolumeMusic(config->getMusicVolume());
 	Mix_Volume(-1, config->getSoundEffectVolume());
+	// Don't simulate the time spent loading.
+	clock->resume();
+	if ((config->getSimulationRate() > 0) && !simulation->start(config->getSimulationRate(), clock->getScale())) {
+		g_info("%s[%d] : Simulating on the render thread", __FILE__, __LINE__);
+	}
 
 	//Event handler
 	SDL_Event e;
 	//While application is running
-	while (gameState->getState() == GAME_CONTINUE) {
+	while (snapshot->state == GAME_CONTINUE) {
 
 		//Handle events on queue
 		while (SDL_PollEvent(&e) != 0) {
 			//User requests quit
 			if (e.type == SDL_QUIT) {
-				gameState->setState(GAME_END);
+				simulation->end();
 			}
-			// screenshot or end game.
+			// screenshot, pause or end game.
 			if (e.type == SDL_KEYDOWN) {
 				if ((e.key.repeat == 0) && (e.key.keysym.sym == SDLK_F12)) {
 					display->screenshot();
+				} else if ((e.key.repeat == 0) && (e.key.keysym.sym == SDLK_F10)) {
+					display->toggleStats();
+				} else if ((e.key.repeat == 0) && (e.key.keysym.sym == SDLK_PAUSE)) {
+					clock->setPaused(!clock->isPaused());
+					simulation->setPaused(clock->isPaused());
 				} else if ((e.key.repeat == 0) && (e.key.keysym.sym == SDLK_ESCAPE)) {
-					gameState->setState(GAME_END);
+					simulation->end();
 				}
 			}
 			// Process the event
@@ -174,6 +170,8 @@ bool Level::Run() {
 		render();
 		display->render();
 	}
+	// The game state is only read here once the simulation thread has stopped.
+	simulation->stop();
 	return true;
 }
 
@@ -184,150 +182,96 @@ bool Level::loadFromFile(const std::string& path) {
 
 	g_info("%s[%d] : Loading level file %s", __FILE__, __LINE__, path.c_str());
 
-	const int brickWidth = config->getDisplayWidth() / bricksWidth;
-	const int brickHeight = config->getDisplayHeight() / bricksHigh;
-	std::string line;
-
-	std::ifstream lvl(filename.c_str());
-	// ensure we have the file.
-	if (!lvl.is_open()) {
+	// Use the level loaded in the background if there is one, (it is only good for one load).
+	LevelPrefetch* prefetched = nullptr;
+	if (prefetch != nullptr && prefetch->wait() && prefetch->matches(path, config->getRenderWidth(), config->getRenderHeight())) {
+		g_info("%s[%d] : Using prefetched level file %s", __FILE__, __LINE__, path.c_str());
+		prefetched = prefetch;
+	} else if (prefetch != nullptr) {
+		delete prefetch;
+	}
+	prefetch = nullptr;
+	LevelDefinition loaded(bricksWidth, bricksHigh);
+	LevelDefinition* level = &loaded;
+	if (prefetched != nullptr) {
+		level = prefetched->getDefinition();
+	} else if (!loaded.loadFromFile(filename)) {
 		return false;
 	}
-	// Level name
-	std::getline(lvl, levelName);
-	g_info("%s[%d] : Level name: %s", __FILE__, __LINE__, levelName.c_str());
-	// If the level name starts and ends with "<name>" quotes, then strip the quotes.
-	int l = levelName.size();
-	char& start = levelName.front();
-	char& end = levelName.back();
-	if (start == '"' && end == '"') {
-		levelName = levelName.substr(1, l - 2);
-	}
-
-	// base value for bricks.
-	std::getline(lvl, line);
-	g_info("%s[%d] : Base brick hit value ratio : %s", __FILE__, __LINE__, line.c_str());
-	try {
-		baseValue = std::stoi(line);
-	} catch (...) {
-		// ignore.
-		g_info("%s[%d] : Base brick hit value failed to convert", __FILE__, __LINE__);
-	}
-
-	// bonus probabilities.
-	std::getline(lvl, line);
-	g_info("%s[%d] : Base brick bonus probability : %s", __FILE__, __LINE__, line.c_str());
-	try {
-		std::istringstream iss(line);
-		std::string probValue;
-		iss >> probValue;
-		g_info("%s[%d] : Base brick apply bonus value ratio : %s", __FILE__, __LINE__, probValue.c_str());
-		bonusProbability = std::stoi(probValue);
-		// do bonus probabilities.
-		int count = 0;
-		while (iss && (count < 6)) {
-			iss >> probValue;
-			try {
-				bonusProbabilities[count] = std::stoi(probValue);
-				g_info("%s[%d] : Base brick bonus value ratio : %d = %d", __FILE__, __LINE__, count,
-				       bonusProbabilities[count]);
-			} catch (...) {
-				g_info("%s[%d] : Base brick bonus value failed to convert", __FILE__, __LINE__);
-			}
-			count++;
-		}
-
-	} catch (...) {
-		// ignore.
-		g_info("%s[%d] : Base brick bonus value failed to convert", __FILE__, __LINE__);
+	bool result = loadLevel(level, prefetched);
+	if (prefetched != nullptr) {
+		delete prefetched;
 	}
+	return result;
+}
 
-	// initial speed;
-	std::getline(lvl, line);
-	g_info("%s[%d] : Initial Speed ratio : %s", __FILE__, __LINE__, line.c_str());
-	try {
-		initialSpeed = std::stod(line);
-	} catch (...) {
-		// ignore.
-		g_info("%s[%d] : Initial Speed ratio failed to convert", __FILE__, __LINE__);
-	}
+bool Level::loadLevel(LevelDefinition* level, LevelPrefetch* prefetched) {
+	const int brickWidth = config->getRenderWidth() / bricksWidth;
+	const int brickHeight = config->getRenderHeight() / bricksHigh;
+	std::string line;
+
+	levelName = level->getName();
 
 	// Background Music
-	std::getline(lvl, line);
-	g_info("%s[%d] : Background Music : %s", __FILE__, __LINE__, line.c_str());
+	line = level->getMusic();
 	if (!line.empty()) {
 		line = config->locateResource(line);
-		backgroundMusic = Mix_LoadMUS(line.c_str());
+		backgroundMusic = display->getMusicCache()->load(line);
 		if (backgroundMusic == nullptr) {
 			g_info("%s[%d] Could not load background music! SDL_Mixer Error: %s", __FILE__, __LINE__, Mix_GetError());
 		}
 	}
 
 	// Brick Hit
-	std::getline(lvl, line);
-	g_info("%s[%d] : Brick Hit Sound : %s", __FILE__, __LINE__, line.c_str());
+	line = level->getBrickHitSound();
 	if (!line.empty()) {
 		line = config->locateResource(line);
-		brickHitSound = Mix_LoadWAV(line.c_str());
+		brickHitSound = display->getSoundCache()->acquire(line);
 		if (brickHitSound == nullptr) {
 			g_info("%s[%d] Could not load brick hit sound! SDL_Mixer Error: %s", __FILE__, __LINE__, Mix_GetError());
 		}
 	}
 
 	// Paddle Hit
-	std::getline(lvl, line);
-	g_info("%s[%d] : Paddle Hit Sound : %s", __FILE__, __LINE__, line.c_str());
+	line = level->getPaddleHitSound();
 	if (!line.empty()) {
 		line = config->locateResource(line);
-		paddleHitSound = Mix_LoadWAV(line.c_str());
+		paddleHitSound = display->getSoundCache()->acquire(line);
 		if (paddleHitSound == nullptr) {
 			g_info("%s[%d] Could not load paddle hit sound! SDL_Mixer Error: %s", __FILE__, __LINE__, Mix_GetError());
 		}
 	}
 
 	// Loss of ball sound
-	std::getline(lvl, line);
-	g_info("%s[%d] : Ball Loss Sound : %s", __FILE__, __LINE__, line.c_str());
+	line = level->getBallLossSound();
 	if (!line.empty()) {
 		line = config->locateResource(line);
-		ballLossSound = Mix_LoadWAV(line.c_str());
+		ballLossSound = display->getSoundCache()->acquire(line);
 		if (ballLossSound == nullptr) {
 			g_info("%s[%d] Could not load ball loss sound! SDL_Mixer Error: %s", __FILE__, __LINE__, Mix_GetError());
 		}
 	}
 
-	// Number of textures.
-	std::getline(lvl, line);
-	const int textureCount = atoi(line.c_str());
-	if (textureCount < 2) {
-		lvl.close();
-		return false;
-	}
-
 	// Textures
+	std::vector<std::string>* names = level->getTextures();
+	const int textureCount = names->size();
 	textures = new TextureRepository(textureCount);
 	numTextures = textureCount;
 	// texture 0 is background
-	getline(lvl, line);
-	line = config->locateResource(line);
-	g_info("%s[%d] : Texture %d name: %s", __FILE__, __LINE__, 0, line.c_str());
-	if (!textures->add(0, renderer, line, config->getDisplayWidth(), config->getDisplayHeight())) {
+	line = config->locateResource((*names)[0]);
+	if (!((prefetched != nullptr) ? textures->add(0, renderer, prefetched->getTexture(0), line)
+	        : textures->add(0, renderer, line, config->getRenderWidth(), config->getRenderHeight()))) {
 		g_info("%s[%d] : Failed to load background texture name: %s, setting as missing texture.", __FILE__, __LINE__, line.c_str());
 		Texture* t = new Texture();
-		t->loadFromColour(renderer, Texture::getColour(), config->getDisplayWidth(), config->getDisplayHeight());
+		t->loadFromColour(renderer, Texture::getColour(), config->getRenderWidth(), config->getRenderHeight());
 		textures->add(0, t);
 	}
 
 	// load the textures
 	for (int i = 1; i < textureCount; i++) {
-		if (!std::getline(lvl, line)) {
-			cleanup();
-			lvl.close();
-			return false;
-		}
-		g_info("%s[%d] : Texture %d name: %s", __FILE__, __LINE__, i, line.c_str());
-		line = config->locateResource(line);
-		if (!textures->add(i, renderer, line, brickWidth, brickHeight)) {
+		line = config->locateResource((*names)[i]);
+		if (!((prefetched != nullptr) ? textures->add(i, renderer, prefetched->getTexture(i), line)
+		        : textures->add(i, renderer, line, brickWidth, brickHeight))) {
 			g_info("%s[%d] : Failed to load texture %d name: %s, setting as missing texture.", __FILE__, __LINE__, i, line.c_str());
 			Texture* t = new Texture();
 			t->loadFromColour(renderer, Texture::getColour(), brickWidth, brickHeight);
@@ -335,82 +279,75 @@ bool Level::loadFromFile(const std::string& path) {
 		}
 	}
 
-	if (bricks == nullptr) {
-		const int n = bricksWidth * bricksHigh;
-		bricks = new Brick*[n];
-		for (int i = 0; i < n; i++) {
-			bricks[i] = nullptr;
-		}
-	}
-
-	// Level layout. (OCCILLO_BRICK_UNIT_HEIGHT lines)
-	for (int i = 0; i < bricksHigh; i++) {
-		if (!std::getline(lvl, line)) {
-			g_info("%s[%d] : Line %u missing?", __FILE__, __LINE__, i);
-			cleanup();
-			lvl.close();
-			return false;
-		}
-		// build the line.
-		g_info("%s[%d] : Line %d Row: %s", __FILE__, __LINE__, i, line.c_str());
-		if (!processLine(i, line)) {
-			cleanup();
-			lvl.close();
-			return false;
-		}
-	}
-
-	lvl.close();
-
 	/*
 	 * Paddle
 	 */
 	g_info("%s[%d] : Load Paddle %s", __FILE__, __LINE__, gameConfig->getPaddleImage()->c_str());
-	Texture* text = new Texture();
-	if (!text->loadFromFile(renderer, config->locateResource(*(gameConfig->getPaddleImage())),
-	                        brickWidth * gameConfig->getPaddleWidthRatio(),
-	                        brickHeight * gameConfig->getPaddleHeightRatio())) {
+	Texture* paddleTexture = new Texture();
+	if (!((prefetched != nullptr) ? paddleTexture->loadFromSurfaces(renderer, prefetched->getPaddle(), *(gameConfig->getPaddleImage()))
+	        : paddleTexture->loadFromFile(renderer, config->locateResource(*(gameConfig->getPaddleImage())),
+	                                      brickWidth * gameConfig->getPaddleWidthRatio(),
+	                                      brickHeight * gameConfig->getPaddleHeightRatio()))) {
 		g_info("%s[%d] : Failed to load paddle texture name: %s, setting as missing texture.", __FILE__, __LINE__, line.c_str());
-		text->loadFromColour(renderer, Texture::getColour(),
-		                     brickWidth * gameConfig->getPaddleWidthRatio(),
-		                     brickHeight * gameConfig->getPaddleHeightRatio());
+		paddleTexture->loadFromColour(renderer, Texture::getColour(),
+		                              brickWidth * gameConfig->getPaddleWidthRatio(),
+		                              brickHeight * gameConfig->getPaddleHeightRatio());
 	}
 
-	paddle = new Paddle(text,
-	                    config->getDisplayWidth() / 2 - text->getWidth() / 2,
-	                    (brickHeight * bricksHigh) - text->getHeight(),
-	                    config->getDisplayWidth() * 2,
-	                    brickWidth,
-	                    brickWidth * (bricksWidth - 1),
-	                    config->getControllerDeadZone());
 	/*
 	 * Ball
 	 */
-	text = new Texture();
-	if (!text->loadFromFile(renderer, config->locateResource(*(gameConfig->getBallImage())),
-	                        brickHeight * gameConfig->getBallSizeRatio(),
-	                        brickHeight * gameConfig->getBallSizeRatio())) {
+	Texture* ballTexture = new Texture();
+	if (!((prefetched != nullptr) ? ballTexture->loadFromSurfaces(renderer, prefetched->getBall(), *(gameConfig->getBallImage()))
+	        : ballTexture->loadFromFile(renderer, config->locateResource(*(gameConfig->getBallImage())),
+	                                    brickHeight * gameConfig->getBallSizeRatio(),
+	                                    brickHeight * gameConfig->getBallSizeRatio()))) {
 		g_info("%s[%d] : Failed to load ball texture name: %s, setting as missing texture.", __FILE__, __LINE__, line.c_str());
-		text->loadFromColour(renderer, Texture::getColour(),
-		                     brickWidth * gameConfig->getBallSizeRatio(),
-		                     brickHeight * gameConfig->getBallSizeRatio());
+		ballTexture->loadFromColour(renderer, Texture::getColour(),
+		                            brickWidth * gameConfig->getBallSizeRatio(),
+		                            brickHeight * gameConfig->getBallSizeRatio());
 
 	}
-	ball = new Ball(text, brickWidth, brickHeight, (config->getDisplayHeight() * 2) / 3);
+
+	/*
+	 * Bricks, paddle and ball.
+	 */
+	playfield = new Playfield(gameConfig, gameState, config->getRenderWidth(), config->getRenderHeight(), std::rand());
+	if (!playfield->load(level, textures, paddleTexture, ballTexture, config->getControllerDeadZone())) {
+		cleanup();
+		return false;
+	}
+
+	if (config->isAutoPlay()) {
+		g_info("%s[%d] : Paddle under auto pilot", __FILE__, __LINE__);
+		autoPilot = new AutoPilot(playfield->getBall(), playfield->getPaddle(), playfield->getBricks(),
+		                          bricksWidth, bricksHigh, std::rand());
+	}
+	simulation = new Simulation(playfield, autoPilot, gameState);
+	snapshot = &simulation->acquire(this);
+	scaler = new DynamicResolution(renderer, config->getRenderWidth(), config->getRenderHeight(),
+	                               config->getDynamicScaleMin() / 100.0, config->getDynamicScaleMax() / 100.0,
+	                               config->getDynamicScaleFps());
 
 	/*
 	 * In game fonts.
 	 */
 
-	fontTitle = TTF_OpenFont(config->locateResource(*(gameConfig->getFontBold())).c_str(), (brickHeight * gameConfig->getTitleSizeRatio()));
-	fontScore = TTF_OpenFont(config->locateResource(*(gameConfig->getFontBold())).c_str(), (brickHeight * 6 / 10));
-	fontBonus = TTF_OpenFont(config->locateResource(*(gameConfig->getFontBold())).c_str(), (brickHeight * gameConfig->getFontSizeRatio()));
+	FontCache* fonts = display->getFontCache();
+	std::string fontBold = config->locateResource(*(gameConfig->getFontBold()));
+	const int titleSize = brickHeight * gameConfig->getTitleSizeRatio();
+	const int bonusSize = brickHeight * gameConfig->getFontSizeRatio();
+	fontTitle = fonts->getFont(fontBold, titleSize);
+	fontTitleOutline = fonts->getFont(fontBold, titleSize, OCCILLO_OUTLINE_SIZE);
+	fontScore = fonts->getFont(fontBold, (brickHeight * 6 / 10));
+	fontBonus = fonts->getFont(fontBold, bonusSize);
+	fontBonusOutline = fonts->getFont(fontBold, bonusSize, OCCILLO_OUTLINE_SIZE);
 
 	/*
 	 * Level name
 	 */
-	text = new Texture();
-	if (!text->loadFromText(renderer, _(levelName.c_str()), fontTitle, gameConfig->getFontColour(), gameConfig->getTitleFontColour())) {
+	Texture* text = new Texture();
+	if (!text->loadFromText(renderer, _(levelName.c_str()), fontTitle, fontTitleOutline, gameConfig->getFontColour(), gameConfig->getTitleFontColour())) {
 		g_info("%s[%d] : Failed to create level name, setting as missing texture.", __FILE__, __LINE__);
 		text->loadFromColour(renderer, Texture::getColour(),
 		                     brickWidth * gameConfig->getTitleSizeRatio(),
@@ -418,57 +355,10 @@ bool Level::loadFromFile(const std::string& path) {
 
 	}
 	text->setBlendMode(SDL_BLENDMODE_BLEND);
-	int x = config->getDisplayWidth() / 2 - text->getWidth() / 2;
-	int y = config->getDisplayHeight() / 2 - text->getHeight() / 2;
-	animations.push_back(new TextureFadeAnimation(text, x, y, gameConfig->getLevelNameFadeTime())); // 5 secs.
-
-	return true;
-}
+	int x = config->getRenderWidth() / 2 - text->getWidth() / 2;
+	int y = config->getRenderHeight() / 2 - text->getHeight() / 2;
+	animations.push_back(new TextureFadeAnimation(*clock, text, x, y, gameConfig->getLevelNameFadeTime())); // 5 secs.
 
-/**
- * Convert a single hex encoded nibble to int.
- * @param c A sing hex character
- * @return The int representation.
- */
-uint8_t hextCharToInt(char c) {
-	uint8_t value = (uint8_t) c;
-	if (value >= 'a') {
-		return (value - 'a' + 10) & 0xf;
-	}
-	if (value >= 'A') {
-		return (value - 'A' + 10) & 0xf;
-	}
-	return (value - '0') & 0xf;
-}
-
-bool Level::processLine(int i, const std::string& l) {
-	// If the length of the line is less that number of bricks wide, then exit.
-	if (l.size() < (size_t)(bricksWidth * 4)) {
-		g_info("%s[%d] : Line too short? %lu ", __FILE__, __LINE__, l.size());
-		return false;
-	}
-
-	const int brickWidth = config->getDisplayWidth() / bricksWidth;
-	const int brickHeight = config->getDisplayHeight() / bricksHigh;
-
-	for (int j = 0; j < bricksWidth; j++) {
-		// each 4 chars are texture index and flags;
-		uint8_t ti = ((hextCharToInt(l[4 * j])) << 4) + hextCharToInt((l[(4 * j) + 1]));
-		uint8_t flags = ((hextCharToInt(l[(4 * j) + 2])) << 4) + hextCharToInt(l[(4 * j) + 3]);
-		if ((flags == 0) && (ti != 0)) {
-			int apply = std::rand() % 101;
-			if (apply <= bonusProbability) {
-				flags = getBonus();
-				g_info("%s[%d] : Bonus being applied to %d x %d = %d", __FILE__, __LINE__, i , j, flags);
-			}
-		}
-
-		if (ti != 0 && textures->get(ti) != nullptr) {
-			bricks[(i * bricksWidth) + j] = new Brick(textures->get(ti), j * brickWidth, i * brickHeight, flags, baseValue);
-		} else {
-			bricks[(i * bricksWidth) + j] = nullptr;
-		}
-	}
 	return true;
 }
 
@@ -477,26 +367,34 @@ void Level::render() {
 	// Update the level state. (move paddle, move ball, brick collison, etc).
 	updateState();
 
+	// The playfield is drawn at the dynamic resolution scale, and the HUD over it at the native resolution.
+	scaler->begin();
+
 	//Render background texture to screen
 	textures->get(0)->render(renderer, 0, 0);
 
-	// Render bricks
+	// Render bricks, (the bricks' textures and positions are fixed, only their hit counts change).
+	Brick** bricks = playfield->getBricks();
 	const int n = bricksWidth * bricksHigh;
 	for (int i = 0; i < n; i++) {
-		if (bricks[i] != nullptr) {
-			bricks[i]->render(renderer);
+		if ((bricks[i] != nullptr) && (snapshot->hitCounts[i] > 0)) {
+			bricks[i]->getTexture()->render(renderer, bricks[i]->getX(), bricks[i]->getY());
 		}
 	}
 
 	// render ball...
-	ball->render(renderer);
+	playfield->getBall()->render(renderer, snapshot->ballX, snapshot->ballY);
 
 	// render paddle;
-	paddle->render(renderer);
+	playfield->getPaddle()->render(renderer, snapshot->paddleX, snapshot->paddleY);
+
+	// brick fragments.
+	renderAnimations(true);
+	scaler->end();
 
 	// render game state.
-	int lives = gameState->getLives();
-	int score = gameState->getScore();
+	int lives = snapshot->lives;
+	int score = snapshot->score;
 
 
 	// Update the textures used for the number of player lives and current scores.
@@ -515,8 +413,8 @@ void Level::render() {
 		lastScore = score;
 	}
 
-	const int bw = config->getDisplayWidth() / bricksWidth;
-	const int bh = config->getDisplayHeight() / bricksHigh;
+	const int bw = config->getRenderWidth() / bricksWidth;
+	const int bh = config->getRenderHeight() / bricksHigh;
 
 	// render lives and score
 	livesTexture->render(renderer, bw / 3, bh / 10);
@@ -524,53 +422,49 @@ void Level::render() {
 	                     (bw * bricksWidth) - scoreTexture->getWidth() - (bw / 3),
 	                     bh / 10);
 
-	// render any animations
+	// render any text animations
+	renderAnimations(false);
+	WorkCounters::set(WORK_ANIMATIONS, animations.size());
+
+	// If out of lives and all animations finished, exit.
+	if ((snapshot->lives == 0) && animations.empty() && doneEndGameAnimation) {
+		simulation->end();
+	}
+
+}
+
+void Level::renderAnimations(bool playfield) {
 	for (std::vector<GameAnimation*>::iterator anItr = animations.begin(); anItr != animations.end();) {
 		GameAnimation* animation = *anItr;
-		if (animation->isComplete()) {
+		if (animation->isPlayfield() != playfield) {
+			++anItr;
+		} else if (animation->isComplete(*clock)) {
 			anItr = animations.erase(anItr);
 			delete animation;
 		} else {
-			animation->render(renderer);
+			animation->render(renderer, *clock);
 			++anItr;
 		}
 	}
-
-	// If out of lives and all animations finished, exit.
-	if ((gameState->getLives() == 0) && animations.empty() && doneEndGameAnimation) {
-		gameState->setState(GAME_END);
-	}
-
 }
 
 void Level::updateState() {
-	double elapsed = (SDL_GetTicks() - timeElapsed) / 1000.0f;
-	paddle->move(elapsed);
-	if (bumpBall) {
-		double direction = ((ball->getDirection() / M_PI) * 180.0);
-		if (direction < 0.0) {
-			direction += 360.0;
-		}
-		direction += 10;
-		if (direction > 360.0) {
-			direction -= 360.0;
-		}
-		ball->setDirection(direction);
-		bumpBall = false;
-		g_info("%s[%d] : Bump ball.", __FILE__, __LINE__);
-		std::string value = _("Bump!");
-		createBonusAnimation(value, ball->getX(), ball->getY(), gameConfig->getBonusScoreFadeTime());
-
+	simulation->setAnimating(!animations.empty());
+	if (!simulation->isRunning()) {
+		simulation->update(clock->getDelta());
 	}
-	if (gameState->getLives() == 0) {
+	// Take the latest state, and start the sounds and animations for what happened since the last.
+	snapshot = &simulation->acquire(this);
+	if (snapshot->lives == 0) {
 		// enable end game animation...
 		if (!doneEndGameAnimation) {
 			/*
 			 * Game Over text
 			 */
+			Ball* ball = playfield->getBall();
 			std::string gameOver = _("Game Over");
 			Texture *text = new Texture();
-			if (!text->loadFromText(renderer, gameOver, fontTitle, gameConfig->getFontColour(), gameConfig->getTitleFontColour())) {
+			if (!text->loadFromText(renderer, gameOver, fontTitle, fontTitleOutline, gameConfig->getFontColour(), gameConfig->getTitleFontColour())) {
 				g_info("%s[%d] : Failed to create game over texture, setting as missing texture.", __FILE__, __LINE__);
 				text->loadFromColour(renderer, Texture::getColour(),
 				                     ball->getWidth() * gameConfig->getTitleSizeRatio(),
@@ -578,168 +472,17 @@ void Level::updateState() {
 
 			}
 			text->setBlendMode(SDL_BLENDMODE_BLEND);
-			int x = config->getDisplayWidth() / 2 - text->getWidth() / 2;
-			int y = config->getDisplayHeight() / 2 - text->getHeight() / 2;
-			animations.push_back(new TextureFadeAnimation(text, x, y, gameConfig->getGameOverFadeTime())); // 4 secs.
+			int x = config->getRenderWidth() / 2 - text->getWidth() / 2;
+			int y = config->getRenderHeight() / 2 - text->getHeight() / 2;
+			animations.push_back(new TextureFadeAnimation(*clock, text, x, y, gameConfig->getGameOverFadeTime())); // 4 secs.
 
 			doneEndGameAnimation = true;
 		}
-		timeElapsed = SDL_GetTicks();
-		return;
-	} else if (!ballInPlay) {
-		const int x = paddle->getX() + (paddle->getWidth() / 2) - (ball->getWidth() / 2);
-		const int y = paddle->getY();
-		ball->setXY(x, y - ball->getHeight() - 1);
-		// Set initial direction...
-		double direction = (double) x / (double) (config->getDisplayWidth());
-		// range is between 200 and 340.
-		direction = 340.0 - (direction * 160.0);
-		ball->setDirection(direction);
-		// set initial speed...
-		double speed = (double) config->getDisplayHeight() * gameConfig->getDefaultStartSpeed();
-		speed = speed * initialSpeed;
-		ball->setSpeed(speed);
-		if ((getActiveBricks() == 0) && animations.empty()) {
-			gameState->setState(NEXT_LEVEL);
-			elapsed = 0.0;
-			g_info("%s[%d] : Next level!", __FILE__, __LINE__);
-		}
-	} else {
-
-		// see if the ball left the field of play.
-		if (ball->getY() > config->getDisplayHeight() || ball->getY() < 0
-		        || ball->getX() > config->getDisplayWidth() || ball->getX() < 0) {
-			ballInPlay = false;
-			if (getActiveBricks() != 0) {
-				gameState->addLives(-1);
-				g_info("%s[%d] : Lost ball. Lives = %d ", __FILE__, __LINE__, gameState->getLives());
-
-				if (ballLossSound != nullptr) {
-					Mix_PlayChannel(-1, ballLossSound, 0);
-				}
-			} else {
-				g_info("%s[%d] : Ignore lost ball, no active bricks", __FILE__, __LINE__);
-				elapsed = 0.0;
-			}
-		} else {
-			while (elapsed > 0.0) {
-				// Determine if the ball moving will collide with something?
-				double ctime = 0.0;
-				int activeBricks = 0;
-				int cBrickX = 0;
-				int cBrickY = 0;
-				Brick* cBrick = findCollision(activeBricks, ctime, elapsed, cBrickX, cBrickY);
-				// If no more bricks, then set next level...
-				if (activeBricks == 0 && animations.empty()) {
-					gameState->setState(NEXT_LEVEL);
-					elapsed = 0.0;
-					g_info("%s[%d] : Next level!", __FILE__, __LINE__);
-
-				} else if (cBrick != nullptr) {
-					// We have a collision.
-					if (brickHitSound != nullptr) {
-						Mix_PlayChannel(-1, brickHitSound, 0);
-					}
-					handleCollision(cBrick);
-					// Quad destroy
-					if (cBrick->isQuadDestroy()) {
-#if DEBUG
-						g_info("%s[%d] : Quad Hit Brick Collision %d %d", __FILE__, __LINE__, cBrickY, cBrickX);
-#endif
-						handleCollision(bricks[(cBrickY - 1) * bricksWidth + (cBrickX - 1)]);
-						handleCollision(bricks[(cBrickY - 1) * bricksWidth + (cBrickX)]);
-						handleCollision(bricks[(cBrickY - 1) * bricksWidth + (cBrickX + 1)]);
-						handleCollision(bricks[(cBrickY) * bricksWidth + (cBrickX - 1)]);
-						handleCollision(bricks[(cBrickY) * bricksWidth + (cBrickX + 1)]);
-						handleCollision(bricks[(cBrickY + 1) * bricksWidth + (cBrickX - 1)]);
-						handleCollision(bricks[(cBrickY + 1) * bricksWidth + (cBrickX)]);
-						handleCollision(bricks[(cBrickY + 1) * bricksWidth + (cBrickX + 1)]);
-					} else if (cBrick->isAllBrickDestroy()) {
-						// All Brick hit
-#if DEBUG
-						g_info("%s[%d] : All Hit Brick Collision %d %d", __FILE__, __LINE__, cBrickY, cBrickX);
-#endif
-						const int n = bricksWidth * bricksHigh;
-						for (int i = 0; i != n; i++) {
-							Brick* b = bricks[i];
-							handleCollision(b);
-						}
-					}
-
-					ball->move(elapsed * ctime);
-					ball->collision(cBrick);
-					elapsed = elapsed * (1.0 - ctime);
-					// Increase the speed by a factor of initial speed / total possible bricks.
-					if (!cBrick->isWall()) {
-						ball->setSpeed(ball->getSpeed() +
-						               (gameConfig->getBrickHitSpeedIncreaseRatio() *
-						                (((double)config->getDisplayHeight() * gameConfig->getDefaultStartSpeed())
-						                 / (double) (bricksWidth * bricksHigh))));
-					}
-				} else {
-					// Check for paddle collision.
-					ctime = ball->collision(paddle, elapsed);
-					if ((ctime > 0.0) && (ctime < 1.0)) {
-						// paddle collision...
-						if (paddleHitSound != nullptr) {
-							Mix_PlayChannel(-1, paddleHitSound, 0);
-						}
-#if DEBUG
-						g_info("%s[%d] : Paddle Collision %f", __FILE__, __LINE__, ctime);
-#endif
-						ball->move(elapsed * ctime);
-						ball->collision(paddle);
-						elapsed = elapsed * (1.0 - ctime);
-					} else if (ctime <= 0.0 || ball->overlaps(paddle)) {
-						// ball overlaps the paddle.
-						ball->collision(paddle);
-						// paddle collision...
-						if (paddleHitSound != nullptr) {
-							Mix_PlayChannel(-1, paddleHitSound, 0);
-						}
-#if DEBUG
-						g_info("%s[%d] : Paddle Overlap/Collision %f", __FILE__, __LINE__, ctime);
-						if (ctime <= 0.0) {
-							g_info("%s[%d] : Paddle %d x %d : %d x %d", __FILE__, __LINE__,
-							       paddle->getX(), paddle->getY(), paddle->getWidth(), paddle->getHeight());
-							g_info("%s[%d] : Ball %d x %d : %d x %d", __FILE__, __LINE__,
-							       ball->getX(), ball->getY(), ball->getWidth(), ball->getHeight());
-						}
-#endif
-					} else {
-						// No brick collision, do full movement.
-						ball->move(elapsed);
-						elapsed = 0.0;
-					}
-				}
-			}
-		}
 	}
-	timeElapsed = SDL_GetTicks();
 }
 
 void Level::event(SDL_Event & event) {
-	paddle->event(event);
-	// if we pressed fire, set ball in play to true;
-	if (event.type == SDL_MOUSEBUTTONUP) {
-		if (!ballInPlay) {
-			ballInPlay = true;
-		}
-	} else if ((event.type == SDL_KEYUP) && (event.key.repeat == 0)) {
-		//Adjust the velocity
-		switch (event.key.keysym.sym) {
-		case SDLK_SPACE:
-			ballInPlay = true;
-			break;
-		case SDLK_F11:
-			bumpBall = true;
-			break;
-		}
-	} else if (event.type == SDL_CONTROLLERBUTTONUP) {
-		if (!ballInPlay) {
-			ballInPlay = true;
-		}
-	}
+	simulation->post(event);
 }
 
 Texture* Level::createStringTexture(const std::string & str, const int value, TTF_Font * font) {
@@ -763,7 +506,7 @@ Texture* Level::createStringTexture(const std::string & str, const int value, TT
 
 void Level::createBonusAnimation(const std::string& str, Brick* brick, uint32_t animationTime) {
 	Texture *text = new Texture();
-	if (!text->loadFromText(renderer, str, fontBonus, gameConfig->getFontColour(), gameConfig->getTitleFontColour())) {
+	if (!text->loadFromText(renderer, str, fontBonus, fontBonusOutline, gameConfig->getFontColour(), gameConfig->getTitleFontColour())) {
 		g_info("%s[%d] : Failed to create string texture, setting as missing texture.", __FILE__, __LINE__);
 		text->loadFromColour(renderer, Texture::getColour(), 16, 16);
 
@@ -771,136 +514,40 @@ void Level::createBonusAnimation(const std::string& str, Brick* brick, uint32_t
 	text->setBlendMode(SDL_BLENDMODE_BLEND);
 	int x = brick->getX() + (brick->getWidth() / 2 - text->getWidth() / 2);
 	int y = brick->getY() + (brick->getHeight() / 2 - text->getHeight() / 2);
-	animations.push_back(new TextureFadeAnimation(text, x, y, animationTime, config->getDisplayHeight() / bricksHigh));
+	animations.push_back(new TextureFadeAnimation(*clock, text, x, y, animationTime, config->getRenderHeight() / bricksHigh));
 }
 
 void Level::createBonusAnimation(const std::string& str, int x, int y, uint32_t animationTime) {
 	Texture *text = new Texture();
-	if (!text->loadFromText(renderer, str, fontBonus, gameConfig->getFontColour(), gameConfig->getTitleFontColour())) {
+	if (!text->loadFromText(renderer, str, fontBonus, fontBonusOutline, gameConfig->getFontColour(), gameConfig->getTitleFontColour())) {
 		g_info("%s[%d] : Failed to create bonus animation string texture, setting as missing texture.", __FILE__, __LINE__);
 		text->loadFromColour(renderer, Texture::getColour(), 16, 16);
 	}
 	text->setBlendMode(SDL_BLENDMODE_BLEND);
-	animations.push_back(new TextureFadeAnimation(text, x, y, animationTime, config->getDisplayHeight() / bricksHigh));
+	animations.push_back(new TextureFadeAnimation(*clock, text, x, y, animationTime, config->getRenderHeight() / bricksHigh));
 
 }
 
-Brick* Level::findCollision(int &activeBricks, double &ctime, double elapsed, int &cBrickX, int &cBrickY) {
-	double direction = ball->getDirection();
-	double xDelta = std::cos(direction);
-	double yDelta = std::sin(direction);
-	Brick* cBrick = nullptr;
-	int iStart = 0;
-	int iEnd = 0;
-	int iDelta = 1;
-	int jStart = 0;
-	int jEnd = 0;
-	int jDelta = 1;
-	// Determine the scan order testing against bricks.
-	if (yDelta > 0) {
-		// scan top to bottom;
-		iEnd = bricksHigh;
-	} else {
-		iStart = bricksHigh - 1;
-		iEnd = -1;
-		iDelta = -1;
-	}
-	if (xDelta > 0) {
-		// Scan left to right;
-		jEnd = bricksWidth;
-	} else {
-		jStart = bricksWidth - 1;
-		jEnd = -1;
-		jDelta = -1;
-	}
-
-	// Count the number of destructable bricks
-	double ltime = 1.0;
-	for (int i = iStart; i != iEnd; i += iDelta) {
-		for (int j = jStart; j != jEnd; j += jDelta) {
-			Brick* b = bricks[(i * bricksWidth) + j];
-			if ((b != nullptr)) {
-				ctime = ball->collision(b, elapsed);
-				if (ctime < 1.0) {
-					// The ball on the move will collide with this brick;
-					if (cBrick == nullptr) {
-						// no collision so far.
-						cBrick = b;
-						cBrickX = j;
-						cBrickY = i;
-						ltime = ctime;
-					} else {
-						// already have a collision, check if this one is earlier!
-						if (ctime < ltime) {
-							cBrick = b;
-							cBrickX = j;
-							cBrickY = i;
-							ltime = ctime;
-						}
-					}
-#if DEBUG
-					g_info("%s[%d] : Collision %f @ %d x %d", __FILE__, __LINE__, ctime, i, j);
-#endif
-				}
-			}
-			if (b != nullptr) {
-				if (!b->isWall() && b->getHitCount() > 0) {
-					activeBricks++;
-				}
-			}
-		}
-	}
-	ctime = ltime;
-	return cBrick;
-}
-
-int Level::getBonus() {
-	int bonus = std::rand() % 101;
-	if (bonus < bonusProbabilities[0]) {
-		return OCCILLO_BRICK_FLAG_DOUBLE_SCORE ;
-	}
-	if (bonus < bonusProbabilities[1]) {
-		return OCCILLO_BRICK_FLAG_TRIPLE_SCORE ;
-	}
-	if (bonus < bonusProbabilities[2]) {
-		return OCCILLO_BRICK_FLAG_QUAD_SCORE ;
-	}
-	if (bonus < bonusProbabilities[3]) {
-		return OCCILLO_BRICK_FLAG_TEN_SCORE ;
-	}
-	if (bonus < bonusProbabilities[4]) {
-		return OCCILLO_BRICK_FLAG_HUNDRED_SCORE ;
-	}
-	if (bonus < bonusProbabilities[5]) {
-		return OCCILLO_BRICK_FLAG_BOMB_QUAD ;
+void Level::brickCollision(Brick* brick) {
+	UNUSED(brick);
+	if (brickHitSound != nullptr) {
+		display->getVoiceManager()->play(brickHitSound, gameConfig->getBrickHitPriority());
 	}
-	return OCCILLO_BRICK_FLAG_EXTRA_LIFE ;
 }
 
-
-void Level::handleCollision(Brick* brick) {
-
-	if (brick == nullptr) {
-		return;
-	}
-	if ((brick->getHitCount() == 0) || (brick->isWall())) {
-		return;
-	}
-
-	brick->collision();
-	gameState->addScore(brick->getValue());
-
+void Level::brickHit(Brick* brick) {
+	const int baseValue = playfield->getBaseValue();
 	if (brick->getHitCount() == 0) {
 		// destruction animination.
 		int time = gameConfig->getBrickDestroyTime();
 		if (brick->getValue() > baseValue) {
 			time *= 2; // double the time if a bonus score brick
 		}
-		animations.push_back(new BrickDestructionAnimation(brick->getTexture(),
+		animations.push_back(new BrickDestructionAnimation(*clock, brick->getTexture(),
 		                     brick->getX(), brick->getY(), time, brick->getWidth()));
 	} else if (!brick->isWall()) {
 		// hit animation.
-		animations.push_back(new BrickDestructionAnimation(brick->getTexture(),
+		animations.push_back(new BrickDestructionAnimation(*clock, brick->getTexture(),
 		                     brick->getX(), brick->getY(), gameConfig->getBrickHitTime(), brick->getHeight(), true));
 	}
 
@@ -918,49 +565,39 @@ void Level::handleCollision(Brick* brick) {
 	if (brick->isExtraLife()) {
 		std::string value = _("+1 Life");
 		createBonusAnimation(value, brick, gameConfig->getBonusLifeFadeTime());
-		gameState->addLives(1);
 	}
+}
 
-	// See if bonus life is to be awarded.
-	int bonus = gameConfig->getAwardBonusLife();
-	if (bonus != -1) {
-		int score = gameState->getScore();
-		int multiple = score / bonus;
-		int awarded = gameState->getBonusLivesAwarded();
-		if (multiple > awarded) {
-			gameState->addBonusLivesAwarded(multiple - awarded);
-			gameState->addLives(multiple - awarded);
-
-			Texture *text = new Texture();
-			std::string value = _("+1 Life");
-			if (!text->loadFromText(renderer, value, fontTitle, gameConfig->getFontColour(), gameConfig->getTitleFontColour())) {
-				g_info("%s[%d] : Failed to create bonus life texture, setting as missing texture.", __FILE__, __LINE__);
-				text->loadFromColour(renderer, Texture::getColour(),
-				                     brick->getWidth() * gameConfig->getTitleSizeRatio(),
-				                     brick->getHeight() * gameConfig->getTitleSizeRatio());
+void Level::bonusLife(Brick* brick) {
+	Texture *text = new Texture();
+	std::string value = _("+1 Life");
+	if (!text->loadFromText(renderer, value, fontTitle, fontTitleOutline, gameConfig->getFontColour(), gameConfig->getTitleFontColour())) {
+		g_info("%s[%d] : Failed to create bonus life texture, setting as missing texture.", __FILE__, __LINE__);
+		text->loadFromColour(renderer, Texture::getColour(),
+		                     brick->getWidth() * gameConfig->getTitleSizeRatio(),
+		                     brick->getHeight() * gameConfig->getTitleSizeRatio());
 
-			}
-			text->setBlendMode(SDL_BLENDMODE_BLEND);
-			int x = config->getDisplayWidth() / 2 - text->getWidth() / 2;
-			int y = config->getDisplayHeight() / 2 - text->getHeight() / 2;
-			animations.push_back(new TextureFadeAnimation(text, x, y, gameConfig->getBonusScoreFadeTime(),
-			                     config->getDisplayHeight() / bricksHigh));
-		}
 	}
+	text->setBlendMode(SDL_BLENDMODE_BLEND);
+	int x = config->getRenderWidth() / 2 - text->getWidth() / 2;
+	int y = config->getRenderHeight() / 2 - text->getHeight() / 2;
+	animations.push_back(new TextureFadeAnimation(*clock, text, x, y, gameConfig->getBonusScoreFadeTime(),
+	                     config->getRenderHeight() / bricksHigh));
+}
 
+void Level::paddleCollision() {
+	if (paddleHitSound != nullptr) {
+		display->getVoiceManager()->play(paddleHitSound, gameConfig->getPaddleHitPriority());
+	}
 }
 
-int Level::getActiveBricks() {
-	int activeBricks = 0;
-	const int n = bricksWidth * bricksHigh;
-	for (int i = 0; i != n; i++) {
-		Brick* b = bricks[i];
-		if (b != nullptr) {
-			if (!b->isWall() && b->getHitCount() > 0) {
-				activeBricks++;
-			}
-		}
+void Level::ballLost() {
+	if (ballLossSound != nullptr) {
+		display->getVoiceManager()->play(ballLossSound, gameConfig->getBallLossPriority());
 	}
-	return activeBricks;
 }
 
+void Level::ballBumped(int x, int y) {
+	std::string value = _("Bump!");
+	createBonusAnimation(value, x, y, gameConfig->getBonusScoreFadeTime());
+}
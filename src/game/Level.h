@@ -33,10 +33,17 @@
 #include "GameConfiguration.h"
 #include "GameState.h"
 #include "Display.h"
+#include "DynamicResolution.h"
 #include "TextureRepository.h"
 #include "Brick.h"
 #include "Paddle.h"
 #include "Ball.h"
+#include "AutoPilot.h"
+#include "LevelDefinition.h"
+#include "LevelPrefetch.h"
+#include "Playfield.h"
+#include "IPlayfieldListener.h"
+#include "Simulation.h"
 #include "GameAnimation.h"
 #include "TextureFadeAnimation.h"
 #include "BrickDestructionAnimation.h"
@@ -46,7 +53,7 @@
 /**
  * @brief Class that represents the Level.
  */
-class Level : public IAppState {
+class Level : public IAppState, public IPlayfieldListener {
   public:
 	/**
 	 * Initialise a Level with the given configuration and display.
@@ -55,14 +62,23 @@ class Level : public IAppState {
 	 * @param display The SDL Display used to assist in rendering to display.
 	 * @param state The game state.
 	 * @param path The location of the file that defines the level.
+	 * @param prefetch The level loaded in the background, (owned by the level once given, may be nullptr).
 	 */
-	Level(Configuration* config, GameConfiguration* game, Display* display, GameState* state, const std::string& path);
+	Level(Configuration* config, GameConfiguration* game, Display* display, GameState* state, const std::string& path,
+	      LevelPrefetch* prefetch = nullptr);
 	virtual ~Level();
 
 	bool Run();
 	bool Activate();
 	void Deactivate();
 
+	void brickCollision(Brick* brick);
+	void brickHit(Brick* brick);
+	void bonusLife(Brick* brick);
+	void paddleCollision();
+	void ballLost();
+	void ballBumped(int x, int y);
+
   private:
 	/**
 	 * @brief The application/engine configuration
@@ -84,6 +100,10 @@ class Level : public IAppState {
 	 * @brief The filename of the level definition.
 	 */
 	std::string levelPath;
+	/**
+	 * @brief The level loaded in the background, (nullptr once used).
+	 */
+	LevelPrefetch* prefetch;
 	/**
 	 * @brief The texture repository for the game elements.
 	 */
@@ -127,45 +147,45 @@ class Level : public IAppState {
 	 */
 	std::string levelName;
 	/**
-	 * @brief The initial speed of the ball.
+	 * @brief The simulation of the level, (bricks, paddle, ball and scoring).
 	 */
-	double initialSpeed;
+	Playfield* playfield;
 	/**
-	 * @brief the base value for all bricks.
+	 * @brief The auto pilot steering the paddle, (nullptr if the player has control).
 	 */
-	int baseValue;
+	AutoPilot* autoPilot;
 	/**
-	 * @brief The basic probability that a brick will have a bonus
+	 * @brief Steps the playfield and auto pilot, (on its own thread if a simulation rate is set).
 	 */
-	int bonusProbability;
+	Simulation* simulation;
 	/**
-	 * The bonus probabilities
+	 * @brief The playfield snapshot being rendered.
 	 */
-	int bonusProbabilities[6];
+	const PlayfieldSnapshot* snapshot;
 	/**
-	 * @brief The array of all bricks in the level.
+	 * @brief Renders the playfield at a scale adapted to the frame time.
 	 */
-	Brick** bricks;
+	DynamicResolution* scaler;
 	/**
-	 * @brief The paddle instance.
+	 * @brief The font to use to render the score and lives texture, (owned by the font cache).
 	 */
-	Paddle* paddle;
+	TTF_Font* fontScore;
 	/**
-	 * @brief The ball instance
+	 * @brief The font to use to render the level name and game over settings, (owned by the font cache).
 	 */
-	Ball* ball;
+	TTF_Font* fontTitle;
 	/**
-	 * @brief The font to use to render the score and lives texture.
+	 * @brief The outline of the title font, (owned by the font cache).
 	 */
-	TTF_Font* fontScore;
+	TTF_Font* fontTitleOutline;
 	/**
-	 * @brief The font to use to render the level name and game over settings.
+	 * @brief The font to use to render the game bonus elements, (owned by the font cache).
 	 */
-	TTF_Font* fontTitle;
+	TTF_Font* fontBonus;
 	/**
-	 * @brief The font to use to render the game bonus elements.
+	 * @brief The outline of the bonus font, (owned by the font cache).
 	 */
-	TTF_Font* fontBonus;
+	TTF_Font* fontBonusOutline;
 	/**
 	 * @brief The texture that shows the score of the player.
 	 */
@@ -182,31 +202,16 @@ class Level : public IAppState {
 	 * @brief The value that the livesTexture denotes.
 	 */
 	int lastLives;
-	/**
-	 * @brief Flag to indicate if the ball is in free movement.
-	 */
-	bool ballInPlay;
-	/**
-	 * Flag to indicate that the ball should be bumped 10'.
-	 */
-	bool bumpBall;
 	/**
 	 * @brief Flag to indicate if we have finished displaying the level name.
 	 */
 	bool doneEndGameAnimation;
 	/**
-	 * @brief The time elapsed since the last frame.
+	 * @brief The display's frame clock, which times the playfield and animations.
 	 */
-	uint32_t timeElapsed;
+	FrameClock* clock;
 
 	std::vector<GameAnimation*> animations;
-	/**
-	 * Process the line as a row of bricks.
-	 * @param i The row id
-	 * @param line The line
-	 * @return TRUE if the line processed correctly.
-	 */
-	bool processLine(int i, const std::string& line);
 	/**
 	 * @brief Cleanup all resources for the level
 	 */
@@ -221,10 +226,22 @@ class Level : public IAppState {
 	 * @return TRUE if the level loaded correctly.
 	 */
 	bool loadFromFile(const std::string& path);
+	/**
+	 * Load the resources of the given level definition.
+	 * @param level The level definition.
+	 * @param prefetched The level loaded in the background to take the surfaces from, (or nullptr to load them).
+	 * @return TRUE if the level loaded correctly.
+	 */
+	bool loadLevel(LevelDefinition* level, LevelPrefetch* prefetched);
 	/**
 	 * Render the level.
 	 */
 	void render();
+	/**
+	 * Render the animations, removing those that are complete.
+	 * @param playfield TRUE to render the playfield animations, FALSE for the overlays.
+	 */
+	void renderAnimations(bool playfield);
 	/**
 	 * Process the current sdl event
 	 * @param event the event to process;
@@ -258,35 +275,6 @@ class Level : public IAppState {
 	 * @param animationTime The time for animation.
 	 */
 	void createBonusAnimation(const std::string& str, int x, int y, uint32_t animationTime);
-
-	/**
-	 *
-	 * @param activeBricks
-	 * @param ctime
-	 * @param elapsed
-	     * @param cBrickX
-	     * @param cBrickY
-	 * @return
-	 */
-	Brick* findCollision(int &activeBricks, double &ctime, double elapsed, int &cBrickX, int &cBrickY);
-
-	/**
-	 * Get the bonus to apply
-	 * @return The bonus to apply.
-	 */
-	int getBonus();
-
-	/**
-	 * Perform the animation/state changes on the given brick for a collision event.
-	 *
-	 * @param brick the brick that collided.
-	 */
-	void handleCollision(Brick* brick);
-	/**
-	 * Get the number of active bricks in the game of play.
-	 * @return The number of destructable bricks.
-	 */
-	int getActiveBricks();
 };
 
 #endif  /* LEVEL_H */
@@ -0,0 +1,248 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "LevelDefinition.h"
+
+LevelDefinition::LevelDefinition(int bricksWidth, int bricksHigh) :
+	bricksWidth(bricksWidth), bricksHigh(bricksHigh), layout(bricksWidth * bricksHigh, 0) {
+	baseValue = 10;
+	initialSpeed = 1.0;
+	bonusProbability = 10;
+	bonusProbabilities[0] = 40;
+	bonusProbabilities[1] = 60;
+	bonusProbabilities[2] = 80;
+	bonusProbabilities[3] = 90;
+	bonusProbabilities[4] = 94;
+	bonusProbabilities[5] = 99;
+}
+
+LevelDefinition::~LevelDefinition() {
+	// NOP
+}
+
+bool LevelDefinition::loadFromFile(const std::string& filename) {
+	const char* data = nullptr;
+	size_t size = 0;
+	if (ResourcePack::find(filename, &data, &size)) {
+		std::istringstream packed(std::string(data, size));
+		return load(packed);
+	}
+	std::ifstream lvl(filename.c_str());
+	// ensure we have the file.
+	if (!lvl.is_open()) {
+		return false;
+	}
+	bool res = load(lvl);
+	lvl.close();
+	return res;
+}
+
+bool LevelDefinition::load(std::istream& lvl) {
+	std::string line;
+
+	// Level name
+	std::getline(lvl, name);
+	g_info("%s[%d] : Level name: %s", __FILE__, __LINE__, name.c_str());
+	// If the level name starts and ends with "<name>" quotes, then strip the quotes.
+	int l = name.size();
+	if ((l >= 2) && (name.front() == '"') && (name.back() == '"')) {
+		name = name.substr(1, l - 2);
+	}
+
+	// base value for bricks.
+	std::getline(lvl, line);
+	g_info("%s[%d] : Base brick hit value ratio : %s", __FILE__, __LINE__, line.c_str());
+	try {
+		baseValue = std::stoi(line);
+	} catch (...) {
+		// ignore.
+		g_info("%s[%d] : Base brick hit value failed to convert", __FILE__, __LINE__);
+	}
+
+	// bonus probabilities.
+	std::getline(lvl, line);
+	g_info("%s[%d] : Base brick bonus probability : %s", __FILE__, __LINE__, line.c_str());
+	try {
+		std::istringstream iss(line);
+		std::string probValue;
+		iss >> probValue;
+		g_info("%s[%d] : Base brick apply bonus value ratio : %s", __FILE__, __LINE__, probValue.c_str());
+		bonusProbability = std::stoi(probValue);
+		// do bonus probabilities.
+		int count = 0;
+		while (iss && (count < OCCILLO_LEVEL_BONUS_COUNT)) {
+			iss >> probValue;
+			try {
+				bonusProbabilities[count] = std::stoi(probValue);
+				g_info("%s[%d] : Base brick bonus value ratio : %d = %d", __FILE__, __LINE__, count,
+				       bonusProbabilities[count]);
+			} catch (...) {
+				g_info("%s[%d] : Base brick bonus value failed to convert", __FILE__, __LINE__);
+			}
+			count++;
+		}
+
+	} catch (...) {
+		// ignore.
+		g_info("%s[%d] : Base brick bonus value failed to convert", __FILE__, __LINE__);
+	}
+
+	// initial speed;
+	std::getline(lvl, line);
+	g_info("%s[%d] : Initial Speed ratio : %s", __FILE__, __LINE__, line.c_str());
+	try {
+		initialSpeed = std::stod(line);
+	} catch (...) {
+		// ignore.
+		g_info("%s[%d] : Initial Speed ratio failed to convert", __FILE__, __LINE__);
+	}
+
+	// Background Music
+	std::getline(lvl, music);
+	g_info("%s[%d] : Background Music : %s", __FILE__, __LINE__, music.c_str());
+
+	// Brick Hit
+	std::getline(lvl, brickHitSound);
+	g_info("%s[%d] : Brick Hit Sound : %s", __FILE__, __LINE__, brickHitSound.c_str());
+
+	// Paddle Hit
+	std::getline(lvl, paddleHitSound);
+	g_info("%s[%d] : Paddle Hit Sound : %s", __FILE__, __LINE__, paddleHitSound.c_str());
+
+	// Loss of ball sound
+	std::getline(lvl, ballLossSound);
+	g_info("%s[%d] : Ball Loss Sound : %s", __FILE__, __LINE__, ballLossSound.c_str());
+
+	// Number of textures.
+	std::getline(lvl, line);
+	const int textureCount = atoi(line.c_str());
+	if (textureCount < 2) {
+		return false;
+	}
+
+	// Textures, texture 0 is background
+	textures.clear();
+	for (int i = 0; i < textureCount; i++) {
+		if (!std::getline(lvl, line) && (i != 0)) {
+			return false;
+		}
+		g_info("%s[%d] : Texture %d name: %s", __FILE__, __LINE__, i, line.c_str());
+		textures.push_back(line);
+	}
+
+	// Level layout. (OCCILLO_BRICK_UNIT_HEIGHT lines)
+	for (int i = 0; i < bricksHigh; i++) {
+		if (!std::getline(lvl, line)) {
+			g_info("%s[%d] : Line %u missing?", __FILE__, __LINE__, i);
+			return false;
+		}
+		// build the line.
+		g_info("%s[%d] : Line %d Row: %s", __FILE__, __LINE__, i, line.c_str());
+		if (!processLine(i, line)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Convert a single hex encoded nibble to int.
+ * @param c A sing hex character
+ * @return The int representation.
+ */
+static uint8_t hextCharToInt(char c) {
+	uint8_t value = (uint8_t) c;
+	if (value >= 'a') {
+		return (value - 'a' + 10) & 0xf;
+	}
+	if (value >= 'A') {
+		return (value - 'A' + 10) & 0xf;
+	}
+	return (value - '0') & 0xf;
+}
+
+bool LevelDefinition::processLine(int i, const std::string& l) {
+	// If the length of the line is less that number of bricks wide, then exit.
+	if (l.size() < (size_t)(bricksWidth * 4)) {
+		g_info("%s[%d] : Line too short? %lu ", __FILE__, __LINE__, l.size());
+		return false;
+	}
+	for (int j = 0; j < bricksWidth; j++) {
+		// each 4 chars are texture index and flags;
+		uint8_t ti = ((hextCharToInt(l[4 * j])) << 4) + hextCharToInt((l[(4 * j) + 1]));
+		uint8_t flags = ((hextCharToInt(l[(4 * j) + 2])) << 4) + hextCharToInt(l[(4 * j) + 3]);
+		layout[(i * bricksWidth) + j] = (ti << 8) | flags;
+	}
+	return true;
+}
+
+const std::string& LevelDefinition::getName() {
+	return name;
+}
+
+int LevelDefinition::getBaseValue() {
+	return baseValue;
+}
+
+int LevelDefinition::getBonusProbability() {
+	return bonusProbability;
+}
+
+void LevelDefinition::setBonusProbability(int probability) {
+	bonusProbability = probability;
+}
+
+int* LevelDefinition::getBonusProbabilities() {
+	return bonusProbabilities;
+}
+
+double LevelDefinition::getInitialSpeed() {
+	return initialSpeed;
+}
+
+void LevelDefinition::setInitialSpeed(double speed) {
+	initialSpeed = speed;
+}
+
+const std::string& LevelDefinition::getMusic() {
+	return music;
+}
+
+const std::string& LevelDefinition::getBrickHitSound() {
+	return brickHitSound;
+}
+
+const std::string& LevelDefinition::getPaddleHitSound() {
+	return paddleHitSound;
+}
+
+const std::string& LevelDefinition::getBallLossSound() {
+	return ballLossSound;
+}
+
+std::vector<std::string>* LevelDefinition::getTextures() {
+	return &textures;
+}
+
+uint8_t LevelDefinition::getTexture(int i, int j) {
+	return layout[(i * bricksWidth) + j] >> 8;
+}
+
+uint8_t LevelDefinition::getFlags(int i, int j) {
+	return layout[(i * bricksWidth) + j] & 0xff;
+}
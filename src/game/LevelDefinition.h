@@ -0,0 +1,203 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef GAME_LEVELDEFINITION_H
+#define GAME_LEVELDEFINITION_H
+
+#include "config.h"
+
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <glib.h>
+
+#include "ResourcePack.h"
+
+/**
+ * @brief The number of bonus probabilities in a level definition.
+ */
+#define OCCILLO_LEVEL_BONUS_COUNT 6
+
+/**
+ * @brief The contents of a level file, (name, scoring, sounds, textures and brick layout).
+ *
+ * The definition holds no SDL resources, so may be loaded off the main thread or without a display.
+ */
+class LevelDefinition {
+  public:
+	/**
+	 * @brief Create an empty level definition.
+	 * @param bricksWidth The number of bricks wide the play area is.
+	 * @param bricksHigh The number of bricks high the play area is.
+	 */
+	LevelDefinition(int bricksWidth, int bricksHigh);
+	virtual ~LevelDefinition();
+	/**
+	 * Load the level from the given file.
+	 * @param filename The location of the file.
+	 * @return TRUE if the level loaded correctly.
+	 */
+	bool loadFromFile(const std::string& filename);
+	/**
+	 * Load the level from the given stream.
+	 * @param lvl The stream holding the level definition.
+	 * @return TRUE if the level loaded correctly.
+	 */
+	bool load(std::istream& lvl);
+	/**
+	 * @brief Get the name of the level.
+	 * @return The level name.
+	 */
+	const std::string& getName();
+	/**
+	 * @brief Get the base value for all bricks.
+	 * @return The base value.
+	 */
+	int getBaseValue();
+	/**
+	 * @brief Get the basic probability that a brick will have a bonus.
+	 * @return The probability (0-100).
+	 */
+	int getBonusProbability();
+	/**
+	 * @brief Set the basic probability that a brick will have a bonus.
+	 * @param probability The probability (0-100).
+	 */
+	void setBonusProbability(int probability);
+	/**
+	 * @brief Get the bonus probabilities, (OCCILLO_LEVEL_BONUS_COUNT values).
+	 * @return The bonus probabilities.
+	 */
+	int* getBonusProbabilities();
+	/**
+	 * @brief Get the initial speed ratio of the ball.
+	 * @return The initial speed ratio.
+	 */
+	double getInitialSpeed();
+	/**
+	 * @brief Set the initial speed ratio of the ball.
+	 * @param speed The initial speed ratio.
+	 */
+	void setInitialSpeed(double speed);
+	/**
+	 * @brief Get the background music resource.
+	 * @return The music resource, (empty if none).
+	 */
+	const std::string& getMusic();
+	/**
+	 * @brief Get the brick hit sound resource.
+	 * @return The sound resource, (empty if none).
+	 */
+	const std::string& getBrickHitSound();
+	/**
+	 * @brief Get the paddle hit sound resource.
+	 * @return The sound resource, (empty if none).
+	 */
+	const std::string& getPaddleHitSound();
+	/**
+	 * @brief Get the ball loss sound resource.
+	 * @return The sound resource, (empty if none).
+	 */
+	const std::string& getBallLossSound();
+	/**
+	 * @brief Get the texture resources, (texture 0 is the background).
+	 * @return The texture resources.
+	 */
+	std::vector<std::string>* getTextures();
+	/**
+	 * @brief Get the texture index of the brick at the given location, (0 = no brick).
+	 * @param i The row.
+	 * @param j The column.
+	 * @return The texture index.
+	 */
+	uint8_t getTexture(int i, int j);
+	/**
+	 * @brief Get the flags of the brick at the given location.
+	 * @param i The row.
+	 * @param j The column.
+	 * @return The brick flags.
+	 */
+	uint8_t getFlags(int i, int j);
+
+  private:
+	/**
+	* @brief The number of bricks wide the play area is.
+	*/
+	const int bricksWidth;
+	/**
+	* @brief The number of bricks high the play area is.
+	*/
+	const int bricksHigh;
+	/**
+	 * @brief The name of the level.
+	 */
+	std::string name;
+	/**
+	 * @brief the base value for all bricks.
+	 */
+	int baseValue;
+	/**
+	 * @brief The basic probability that a brick will have a bonus
+	 */
+	int bonusProbability;
+	/**
+	 * The bonus probabilities
+	 */
+	int bonusProbabilities[OCCILLO_LEVEL_BONUS_COUNT];
+	/**
+	 * @brief The initial speed of the ball.
+	 */
+	double initialSpeed;
+	/**
+	 * @brief The background music resource.
+	 */
+	std::string music;
+	/**
+	 * @brief The brick hit sound resource.
+	 */
+	std::string brickHitSound;
+	/**
+	 * @brief The paddle hit sound resource.
+	 */
+	std::string paddleHitSound;
+	/**
+	 * @brief The ball loss sound resource.
+	 */
+	std::string ballLossSound;
+	/**
+	 * @brief The texture resources.
+	 */
+	std::vector<std::string> textures;
+	/**
+	 * @brief The brick layout, (texture index << 8 | flags), row by row.
+	 */
+	std::vector<uint16_t> layout;
+	/**
+	 * Process the line as a row of bricks.
+	 * @param i The row id
+	 * @param line The line
+	 * @return TRUE if the line processed correctly.
+	 */
+	bool processLine(int i, const std::string& line);
+};
+
+#endif /* GAME_LEVELDEFINITION_H */
@@ -0,0 +1,125 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "LevelPrefetch.h"
+
+LevelPrefetch::LevelPrefetch(Configuration* config, GameConfiguration* game, SoundCache* sounds, const std::string& path) :
+	config(config), game(game), sounds(sounds), path(path),
+	definition(game->getNumberBricksWide(), game->getNumberBricksHigh()) {
+	displayWidth = config->getRenderWidth();
+	displayHeight = config->getRenderHeight();
+	loaded = false;
+	// A background job, so a thread waiting on other work doesn't pick it up.
+	JobSystem::submit(&loading, loadWorker, this, "prefetch", JOB_BACKGROUND);
+}
+
+LevelPrefetch::~LevelPrefetch() {
+	wait();
+	for (unsigned int i = 0; i < textures.size(); i++) {
+		freeSurfaces(textures[i]);
+	}
+	freeSurfaces(paddle);
+	freeSurfaces(ball);
+}
+
+void LevelPrefetch::loadWorker(void* data) {
+	LevelPrefetch* prefetch = static_cast<LevelPrefetch*>(data);
+	prefetch->loaded = prefetch->load();
+}
+
+void LevelPrefetch::rasterizeWorker(void* data) {
+	Rasterize* image = static_cast<Rasterize*>(data);
+	Texture::rasterizeFile(image->path, image->width, image->height, *(image->frames));
+}
+
+bool LevelPrefetch::load() {
+	g_info("%s[%d] : Prefetching level file %s", __FILE__, __LINE__, path.c_str());
+	if (!definition.loadFromFile(config->locateResource(path))) {
+		return false;
+	}
+	prefetchSound(definition.getBrickHitSound());
+	prefetchSound(definition.getPaddleHitSound());
+	prefetchSound(definition.getBallLossSound());
+
+	const int brickWidth = displayWidth / game->getNumberBricksWide();
+	const int brickHeight = displayHeight / game->getNumberBricksHigh();
+	std::vector<std::string>* names = definition.getTextures();
+	const int textureCount = names->size();
+	textures.resize(textureCount);
+	// Rasterize the images as separate jobs, (texture 0 is background).
+	std::vector<Rasterize> images(textureCount + 2);
+	for (int i = 0; i < textureCount; i++) {
+		images[i] = { config->locateResource((*names)[i]),
+		              (i == 0) ? displayWidth : brickWidth,
+		              (i == 0) ? displayHeight : brickHeight, &textures[i] };
+	}
+	images[textureCount] = { config->locateResource(*(game->getPaddleImage())),
+	                         (int)(brickWidth * game->getPaddleWidthRatio()),
+	                         (int)(brickHeight * game->getPaddleHeightRatio()), &paddle };
+	images[textureCount + 1] = { config->locateResource(*(game->getBallImage())),
+	                             (int)(brickHeight * game->getBallSizeRatio()),
+	                             (int)(brickHeight * game->getBallSizeRatio()), &ball };
+	JobGroup group;
+	for (Rasterize& image : images) {
+		JobSystem::submit(&group, rasterizeWorker, &image, "rasterize");
+	}
+	JobSystem::wait(&group);
+	g_info("%s[%d] : Prefetched level file %s", __FILE__, __LINE__, path.c_str());
+	return true;
+}
+
+void LevelPrefetch::prefetchSound(const std::string& sound) {
+	if (!sound.empty() && sounds != nullptr) {
+		sounds->prefetch(config->locateResource(sound));
+	}
+}
+
+bool LevelPrefetch::wait() {
+	JobSystem::wait(&loading);
+	return loaded;
+}
+
+bool LevelPrefetch::matches(const std::string& path, int width, int height) {
+	return (this->path == path) && (displayWidth == width) && (displayHeight == height);
+}
+
+LevelDefinition* LevelPrefetch::getDefinition() {
+	return &definition;
+}
+
+std::vector<SDL_Surface*>& LevelPrefetch::getTexture(int index) {
+	if (index < 0 || index >= (int) textures.size()) {
+		return none;
+	}
+	return textures[index];
+}
+
+std::vector<SDL_Surface*>& LevelPrefetch::getPaddle() {
+	return paddle;
+}
+
+std::vector<SDL_Surface*>& LevelPrefetch::getBall() {
+	return ball;
+}
+
+void LevelPrefetch::freeSurfaces(std::vector<SDL_Surface*>& frames) {
+	for (unsigned int i = 0; i < frames.size(); i++) {
+		SDL_FreeSurface(frames[i]);
+	}
+	frames.clear();
+}
@@ -0,0 +1,193 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef GAME_LEVELPREFETCH_H
+#define GAME_LEVELPREFETCH_H
+
+#include "config.h"
+
+#include <string>
+#include <vector>
+#include <SDL.h>
+#include <glib.h>
+
+#include "Configuration.h"
+#include "GameConfiguration.h"
+#include "SoundCache.h"
+#include "Texture.h"
+#include "LevelDefinition.h"
+#include "JobSystem.h"
+
+/**
+ * @brief A level loaded on a background thread, ready for the level to be created without waiting.
+ *
+ * The level file is parsed, its sounds decoded into the sound cache, and its textures, paddle and ball
+ * rasterized to surfaces. Only the creation of the SDL textures and the level name is left to the main
+ * thread.
+ */
+class LevelPrefetch {
+  public:
+	/**
+	 * @brief Start loading the given level in the background.
+	 * @param config The application configuration.
+	 * @param game The game configuration.
+	 * @param sounds The sound cache to decode the sounds into.
+	 * @param path The level file, (as listed in the game configuration).
+	 */
+	LevelPrefetch(Configuration* config, GameConfiguration* game, SoundCache* sounds, const std::string& path);
+	/**
+	 * @brief Wait for the load to finish and free anything not taken.
+	 */
+	virtual ~LevelPrefetch();
+	/**
+	 * @brief Wait for the load to finish.
+	 * @return TRUE if the level loaded.
+	 */
+	bool wait();
+	/**
+	 * @brief Determine if this is the given level, loaded for the given display size.
+	 * @param path The level file.
+	 * @param width The display width.
+	 * @param height The display height.
+	 * @return TRUE if the prefetched level can be used.
+	 */
+	bool matches(const std::string& path, int width, int height);
+	/**
+	 * @brief Get the level definition.
+	 * @return The level definition, (owned by the prefetch).
+	 */
+	LevelDefinition* getDefinition();
+	/**
+	 * @brief Get the surfaces of the given level texture, (texture 0 is the background).
+	 * @param index The texture index.
+	 * @return The surfaces, (empty if the texture failed to load).
+	 */
+	std::vector<SDL_Surface*>& getTexture(int index);
+	/**
+	 * @brief Get the surfaces of the paddle.
+	 * @return The surfaces, (empty if the paddle failed to load).
+	 */
+	std::vector<SDL_Surface*>& getPaddle();
+	/**
+	 * @brief Get the surfaces of the ball.
+	 * @return The surfaces, (empty if the ball failed to load).
+	 */
+	std::vector<SDL_Surface*>& getBall();
+
+  private:
+	/**
+	 * @brief The application configuration.
+	 */
+	Configuration* config;
+	/**
+	 * @brief The game configuration.
+	 */
+	GameConfiguration* game;
+	/**
+	 * @brief The sound cache.
+	 */
+	SoundCache* sounds;
+	/**
+	 * @brief The level file.
+	 */
+	std::string path;
+	/**
+	 * @brief The display width the textures are sized for.
+	 */
+	int displayWidth;
+	/**
+	 * @brief The display height the textures are sized for.
+	 */
+	int displayHeight;
+	/**
+	 * @brief The level definition.
+	 */
+	LevelDefinition definition;
+	/**
+	 * @brief The surfaces of each level texture.
+	 */
+	std::vector<std::vector<SDL_Surface*> > textures;
+	/**
+	 * @brief The surfaces of the paddle.
+	 */
+	std::vector<SDL_Surface*> paddle;
+	/**
+	 * @brief The surfaces of the ball.
+	 */
+	std::vector<SDL_Surface*> ball;
+	/**
+	 * @brief An empty list, for textures out of range.
+	 */
+	std::vector<SDL_Surface*> none;
+	/**
+	 * @brief TRUE if the level loaded.
+	 */
+	bool loaded;
+	/**
+	 * @brief The loading job.
+	 */
+	JobGroup loading;
+	/**
+	 * @brief An image to rasterize, (a job of the load).
+	 */
+	struct Rasterize {
+		/**
+		 * @brief The resolved path.
+		 */
+		std::string path;
+		/**
+		 * @brief The width.
+		 */
+		int width;
+		/**
+		 * @brief The height.
+		 */
+		int height;
+		/**
+		 * @brief The surfaces to fill.
+		 */
+		std::vector<SDL_Surface*>* frames;
+	};
+	/**
+	 * @brief The loading job entry.
+	 * @param data The prefetch.
+	 */
+	static void loadWorker(void* data);
+	/**
+	 * @brief The rasterize job entry.
+	 * @param data The Rasterize.
+	 */
+	static void rasterizeWorker(void* data);
+	/**
+	 * @brief Load the level, (as a background job).
+	 * @return TRUE if the level loaded.
+	 */
+	bool load();
+	/**
+	 * @brief Decode the given sound into the sound cache.
+	 * @param sound The sound resource, (may be empty).
+	 */
+	void prefetchSound(const std::string& sound);
+	/**
+	 * @brief Free the given surfaces.
+	 * @param frames The surfaces.
+	 */
+	static void freeSurfaces(std::vector<SDL_Surface*>& frames);
+};
+
+#endif /* GAME_LEVELPREFETCH_H */
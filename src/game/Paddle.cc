@@ -23,6 +23,8 @@ Paddle::Paddle(Texture* texture, int x, int y, int pxPerSec, int minX, int maxX,
     sx = texture->getWidth();
     sy = texture->getHeight();
     velocityX = 0;
+    steering = false;
+    targetX = x;
 }
 
 Paddle::~Paddle() {
@@ -51,6 +53,10 @@ void Paddle::render(SDL_Renderer* renderer) {
     texture->render(renderer, (int) x, (int) y);
 }
 
+void Paddle::render(SDL_Renderer* renderer, int x, int y) {
+    texture->render(renderer, x, y);
+}
+
 void Paddle::event(SDL_Event& e) {
     //If a key was pressed
     if ((e.type == SDL_KEYDOWN) && (e.key.repeat == 0)) {
@@ -75,11 +81,8 @@ void Paddle::event(SDL_Event& e) {
                 break;
         }
     } else if (e.type == SDL_MOUSEMOTION) {
-        int mouseX = 0;
-        int mouseY = 0;
-        //Get mouse position
-        SDL_GetMouseState(&mouseX, &mouseY);
-        x = mouseX;
+        // Use the position carried by the event, (it may be handled after the mouse has moved on).
+        x = e.motion.x;
         if (x < minX) {
             x = minX;
         } else if (x > maxX - sx) {
@@ -99,8 +102,20 @@ void Paddle::event(SDL_Event& e) {
 }
 
 void Paddle::move(float timeElapsed) {
-    //Move the paddle left or right
-    x += velocityX * timeElapsed;
+    if (steering) {
+        // Move towards the target, but don't overshoot it.
+        double delta = targetX - x;
+        double step = pxPerSec * timeElapsed;
+        if (delta > step) {
+            delta = step;
+        } else if (delta < -step) {
+            delta = -step;
+        }
+        x += delta;
+    } else {
+        //Move the paddle left or right
+        x += velocityX * timeElapsed;
+    }
     //If the paddle went too far to the left or right
     if (x < minX) {
         x = minX;
@@ -109,3 +124,8 @@ void Paddle::move(float timeElapsed) {
     }
 }
 
+
+void Paddle::steer(int targetX) {
+    steering = true;
+    this->targetX = targetX;
+}
@@ -71,6 +71,14 @@ class Paddle {
 	*/
 	void render(SDL_Renderer* renderer);
 	/**
+	* @brief Render the paddle at the given position, (eg as recorded in a snapshot).
+	*
+	* @param renderer The renderer to use.
+	* @param x The x co-ordinate.
+	* @param y The y co-ordinate.
+	*/
+	void render(SDL_Renderer* renderer, int x, int y);
+	/**
 	* @brief Have the paddle handle the given SDL event
 	*
 	* @param e The event.
@@ -82,6 +90,13 @@ class Paddle {
 	* @param timeElapsed The time elapsed.
 	*/
 	void move(float timeElapsed);
+	/**
+	* @brief Steer the paddle towards the given x co-ordinate, (in place of user input). The paddle
+	* will move at no more than the keyboard rate and will stop at the target.
+	*
+	* @param targetX The x co-ordinate for the left most position of the paddle.
+	*/
+	void steer(int targetX);
   private:
 	/**
 	* @brief The texture of the paddle.
@@ -119,6 +134,14 @@ class Paddle {
 	* @brief The current velocity along the X axis.
 	*/
 	int velocityX;
+	/**
+	* @brief Flag to indicate the paddle is being steered to targetX rather than using velocityX.
+	*/
+	bool steering;
+	/**
+	* @brief The x co-ordinate the paddle is being steered to.
+	*/
+	double targetX;
         /**
          * @brief Controller deadzone
          */
@@ -0,0 +1,472 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "Playfield.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846 /* pi */
+#endif
+
+Playfield::Playfield(GameConfiguration* game, GameState* state, int displayWidth, int displayHeight, unsigned int seed) :
+	gameState(state), displayWidth(displayWidth), displayHeight(displayHeight),
+	bricksWidth(game->getNumberBricksWide()), bricksHigh(game->getNumberBricksHigh()), random(seed) {
+	listener = nullptr;
+	defaultStartSpeed = game->getDefaultStartSpeed();
+	brickHitSpeedIncreaseRatio = game->getBrickHitSpeedIncreaseRatio();
+	awardBonusLife = game->getAwardBonusLife();
+	initialSpeed = 1.0;
+	baseValue = 10;
+	bonusProbability = 10;
+	for (int i = 0; i < OCCILLO_LEVEL_BONUS_COUNT; i++) {
+		bonusProbabilities[i] = 0;
+	}
+	bricks = nullptr;
+	paddle = nullptr;
+	ball = nullptr;
+	ballInPlay = false;
+	bumpBall = false;
+}
+
+Playfield::~Playfield() {
+	cleanup();
+}
+
+void Playfield::cleanup() {
+	if (ball != nullptr) {
+		delete ball;
+		ball = nullptr;
+	}
+	if (paddle != nullptr) {
+		delete paddle;
+		paddle = nullptr;
+	}
+	const int n = bricksWidth * bricksHigh;
+	if (bricks != nullptr) {
+		for (int i = 0; i < n; i++) {
+			Brick* b = bricks[i];
+			if (b != nullptr) {
+				delete b;
+			}
+			bricks[i] = nullptr;
+		}
+		delete[] bricks;
+		bricks = nullptr;
+	}
+}
+
+bool Playfield::load(LevelDefinition* level, TextureRepository* textures, Texture* paddleTexture, Texture* ballTexture, int deadZone) {
+	cleanup();
+	const int brickWidth = displayWidth / bricksWidth;
+	const int brickHeight = displayHeight / bricksHigh;
+
+	initialSpeed = level->getInitialSpeed();
+	baseValue = level->getBaseValue();
+	bonusProbability = level->getBonusProbability();
+	for (int i = 0; i < OCCILLO_LEVEL_BONUS_COUNT; i++) {
+		bonusProbabilities[i] = level->getBonusProbabilities()[i];
+	}
+
+	const int n = bricksWidth * bricksHigh;
+	bricks = new Brick*[n];
+	for (int i = 0; i < bricksHigh; i++) {
+		for (int j = 0; j < bricksWidth; j++) {
+			uint8_t ti = level->getTexture(i, j);
+			uint8_t flags = level->getFlags(i, j);
+			if ((flags == 0) && (ti != 0)) {
+				int apply = random() % 101;
+				if (apply <= bonusProbability) {
+					flags = getBonus();
+#if DEBUG
+					g_info("%s[%d] : Bonus being applied to %d x %d = %d", __FILE__, __LINE__, i , j, flags);
+#endif
+				}
+			}
+			if (ti != 0 && textures->get(ti) != nullptr) {
+				bricks[(i * bricksWidth) + j] = new Brick(textures->get(ti), j * brickWidth, i * brickHeight, flags, baseValue);
+			} else {
+				bricks[(i * bricksWidth) + j] = nullptr;
+			}
+		}
+	}
+
+	paddle = new Paddle(paddleTexture,
+	                    displayWidth / 2 - paddleTexture->getWidth() / 2,
+	                    (brickHeight * bricksHigh) - paddleTexture->getHeight(),
+	                    displayWidth * 2,
+	                    brickWidth,
+	                    brickWidth * (bricksWidth - 1),
+	                    deadZone);
+	ball = new Ball(ballTexture, brickWidth, brickHeight, (displayHeight * 2) / 3);
+	ballInPlay = false;
+	bumpBall = false;
+	return true;
+}
+
+void Playfield::setListener(IPlayfieldListener* listener) {
+	this->listener = listener;
+}
+
+void Playfield::serve() {
+	ballInPlay = true;
+}
+
+bool Playfield::isBallInPlay() {
+	return ballInPlay;
+}
+
+void Playfield::bump() {
+	bumpBall = true;
+}
+
+Brick** Playfield::getBricks() {
+	return bricks;
+}
+
+int Playfield::getBricksWidth() {
+	return bricksWidth;
+}
+
+int Playfield::getBricksHigh() {
+	return bricksHigh;
+}
+
+Paddle* Playfield::getPaddle() {
+	return paddle;
+}
+
+Ball* Playfield::getBall() {
+	return ball;
+}
+
+int Playfield::getBaseValue() {
+	return baseValue;
+}
+
+void Playfield::setBrickHitSpeedIncreaseRatio(double ratio) {
+	brickHitSpeedIncreaseRatio = ratio;
+}
+
+void Playfield::input(SDL_Event& event, bool paddle) {
+	if (paddle) {
+		this->paddle->event(event);
+	}
+	// if we pressed fire, set ball in play to true;
+	if (event.type == SDL_MOUSEBUTTONUP) {
+		serve();
+	} else if ((event.type == SDL_KEYUP) && (event.key.repeat == 0)) {
+		switch (event.key.keysym.sym) {
+		case SDLK_SPACE:
+			serve();
+			break;
+		case SDLK_F11:
+			bump();
+			break;
+		}
+	} else if (event.type == SDL_CONTROLLERBUTTONUP) {
+		serve();
+	}
+}
+
+void Playfield::update(double elapsed, bool animating) {
+	paddle->move(elapsed);
+	if (bumpBall) {
+		double direction = ((ball->getDirection() / M_PI) * 180.0);
+		if (direction < 0.0) {
+			direction += 360.0;
+		}
+		direction += 10;
+		if (direction > 360.0) {
+			direction -= 360.0;
+		}
+		ball->setDirection(direction);
+		bumpBall = false;
+		g_info("%s[%d] : Bump ball.", __FILE__, __LINE__);
+		if (listener != nullptr) {
+			listener->ballBumped(ball->getX(), ball->getY());
+		}
+	}
+	if (gameState->getLives() == 0) {
+		return;
+	} else if (!ballInPlay) {
+		const int x = paddle->getX() + (paddle->getWidth() / 2) - (ball->getWidth() / 2);
+		const int y = paddle->getY();
+		ball->setXY(x, y - ball->getHeight() - 1);
+		// Set initial direction...
+		double direction = (double) x / (double) (displayWidth);
+		// range is between 200 and 340.
+		direction = 340.0 - (direction * 160.0);
+		ball->setDirection(direction);
+		// set initial speed...
+		double speed = (double) displayHeight * defaultStartSpeed;
+		speed = speed * initialSpeed;
+		ball->setSpeed(speed);
+		if ((getActiveBricks() == 0) && !animating) {
+			gameState->setState(NEXT_LEVEL);
+			g_info("%s[%d] : Next level!", __FILE__, __LINE__);
+		}
+		return;
+	}
+
+	// see if the ball left the field of play.
+	if (ball->getY() > displayHeight || ball->getY() < 0
+	        || ball->getX() > displayWidth || ball->getX() < 0) {
+		ballInPlay = false;
+		if (getActiveBricks() != 0) {
+			gameState->addLives(-1);
+			g_info("%s[%d] : Lost ball. Lives = %d ", __FILE__, __LINE__, gameState->getLives());
+			if (listener != nullptr) {
+				listener->ballLost();
+			}
+		} else {
+			g_info("%s[%d] : Ignore lost ball, no active bricks", __FILE__, __LINE__);
+		}
+		return;
+	}
+
+	while (elapsed > 0.0) {
+		// Determine if the ball moving will collide with something?
+		double ctime = 0.0;
+		int activeBricks = 0;
+		int cBrickX = 0;
+		int cBrickY = 0;
+		Brick* cBrick = findCollision(activeBricks, ctime, elapsed, cBrickX, cBrickY);
+		// If no more bricks, then set next level...
+		if (activeBricks == 0 && !animating) {
+			gameState->setState(NEXT_LEVEL);
+			elapsed = 0.0;
+			g_info("%s[%d] : Next level!", __FILE__, __LINE__);
+
+		} else if (cBrick != nullptr) {
+			// We have a collision.
+			if (listener != nullptr) {
+				listener->brickCollision(cBrick);
+			}
+			handleCollision(cBrick);
+			// Quad destroy
+			if (cBrick->isQuadDestroy()) {
+#if DEBUG
+				g_info("%s[%d] : Quad Hit Brick Collision %d %d", __FILE__, __LINE__, cBrickY, cBrickX);
+#endif
+				for (int i = cBrickY - 1; i <= cBrickY + 1; i++) {
+					for (int j = cBrickX - 1; j <= cBrickX + 1; j++) {
+						if ((i >= 0) && (i < bricksHigh) && (j >= 0) && (j < bricksWidth)
+						        && !((i == cBrickY) && (j == cBrickX))) {
+							handleCollision(bricks[(i * bricksWidth) + j]);
+						}
+					}
+				}
+			} else if (cBrick->isAllBrickDestroy()) {
+				// All Brick hit
+#if DEBUG
+				g_info("%s[%d] : All Hit Brick Collision %d %d", __FILE__, __LINE__, cBrickY, cBrickX);
+#endif
+				const int n = bricksWidth * bricksHigh;
+				for (int i = 0; i != n; i++) {
+					Brick* b = bricks[i];
+					handleCollision(b);
+				}
+			}
+
+			ball->move(elapsed * ctime);
+			ball->collision(cBrick);
+			elapsed = elapsed * (1.0 - ctime);
+			// Increase the speed by a factor of initial speed / total possible bricks.
+			if (!cBrick->isWall()) {
+				ball->setSpeed(ball->getSpeed() +
+				               (brickHitSpeedIncreaseRatio *
+				                (((double) displayHeight * defaultStartSpeed)
+				                 / (double) (bricksWidth * bricksHigh))));
+			}
+		} else {
+			// Check for paddle collision.
+			ctime = ball->collision(paddle, elapsed);
+			if ((ctime > 0.0) && (ctime < 1.0)) {
+				// paddle collision...
+				if (listener != nullptr) {
+					listener->paddleCollision();
+				}
+#if DEBUG
+				g_info("%s[%d] : Paddle Collision %f", __FILE__, __LINE__, ctime);
+#endif
+				ball->move(elapsed * ctime);
+				ball->collision(paddle);
+				elapsed = elapsed * (1.0 - ctime);
+			} else if (ctime <= 0.0 || ball->overlaps(paddle)) {
+				// ball overlaps the paddle.
+				ball->collision(paddle);
+				// paddle collision...
+				if (listener != nullptr) {
+					listener->paddleCollision();
+				}
+#if DEBUG
+				g_info("%s[%d] : Paddle Overlap/Collision %f", __FILE__, __LINE__, ctime);
+				if (ctime <= 0.0) {
+					g_info("%s[%d] : Paddle %d x %d : %d x %d", __FILE__, __LINE__,
+					       paddle->getX(), paddle->getY(), paddle->getWidth(), paddle->getHeight());
+					g_info("%s[%d] : Ball %d x %d : %d x %d", __FILE__, __LINE__,
+					       ball->getX(), ball->getY(), ball->getWidth(), ball->getHeight());
+				}
+#endif
+			} else {
+				// No brick collision, do full movement.
+				ball->move(elapsed);
+				elapsed = 0.0;
+			}
+		}
+	}
+}
+
+Brick* Playfield::findCollision(int &activeBricks, double &ctime, double elapsed, int &cBrickX, int &cBrickY) {
+	WorkCounters::add(WORK_BRICK_SCANS);
+	double direction = ball->getDirection();
+	double xDelta = std::cos(direction);
+	double yDelta = std::sin(direction);
+	Brick* cBrick = nullptr;
+	int iStart = 0;
+	int iEnd = 0;
+	int iDelta = 1;
+	int jStart = 0;
+	int jEnd = 0;
+	int jDelta = 1;
+	// Determine the scan order testing against bricks.
+	if (yDelta > 0) {
+		// scan top to bottom;
+		iEnd = bricksHigh;
+	} else {
+		iStart = bricksHigh - 1;
+		iEnd = -1;
+		iDelta = -1;
+	}
+	if (xDelta > 0) {
+		// Scan left to right;
+		jEnd = bricksWidth;
+	} else {
+		jStart = bricksWidth - 1;
+		jEnd = -1;
+		jDelta = -1;
+	}
+
+	// Count the number of destructable bricks
+	double ltime = 1.0;
+	for (int i = iStart; i != iEnd; i += iDelta) {
+		for (int j = jStart; j != jEnd; j += jDelta) {
+			Brick* b = bricks[(i * bricksWidth) + j];
+			if ((b != nullptr)) {
+				ctime = ball->collision(b, elapsed);
+				if (ctime < 1.0) {
+					// The ball on the move will collide with this brick;
+					if (cBrick == nullptr) {
+						// no collision so far.
+						cBrick = b;
+						cBrickX = j;
+						cBrickY = i;
+						ltime = ctime;
+					} else {
+						// already have a collision, check if this one is earlier!
+						if (ctime < ltime) {
+							cBrick = b;
+							cBrickX = j;
+							cBrickY = i;
+							ltime = ctime;
+						}
+					}
+#if DEBUG
+					g_info("%s[%d] : Collision %f @ %d x %d", __FILE__, __LINE__, ctime, i, j);
+#endif
+				}
+			}
+			if (b != nullptr) {
+				if (!b->isWall() && b->getHitCount() > 0) {
+					activeBricks++;
+				}
+			}
+		}
+	}
+	ctime = ltime;
+	return cBrick;
+}
+
+int Playfield::getBonus() {
+	int bonus = random() % 101;
+	if (bonus < bonusProbabilities[0]) {
+		return OCCILLO_BRICK_FLAG_DOUBLE_SCORE ;
+	}
+	if (bonus < bonusProbabilities[1]) {
+		return OCCILLO_BRICK_FLAG_TRIPLE_SCORE ;
+	}
+	if (bonus < bonusProbabilities[2]) {
+		return OCCILLO_BRICK_FLAG_QUAD_SCORE ;
+	}
+	if (bonus < bonusProbabilities[3]) {
+		return OCCILLO_BRICK_FLAG_TEN_SCORE ;
+	}
+	if (bonus < bonusProbabilities[4]) {
+		return OCCILLO_BRICK_FLAG_HUNDRED_SCORE ;
+	}
+	if (bonus < bonusProbabilities[5]) {
+		return OCCILLO_BRICK_FLAG_BOMB_QUAD ;
+	}
+	return OCCILLO_BRICK_FLAG_EXTRA_LIFE ;
+}
+
+void Playfield::handleCollision(Brick* brick) {
+
+	if (brick == nullptr) {
+		return;
+	}
+	if ((brick->getHitCount() == 0) || (brick->isWall())) {
+		return;
+	}
+
+	brick->collision();
+	gameState->addScore(brick->getValue());
+	if (brick->isExtraLife()) {
+		gameState->addLives(1);
+	}
+	if (listener != nullptr) {
+		listener->brickHit(brick);
+	}
+
+	// See if bonus life is to be awarded.
+	if (awardBonusLife != -1) {
+		int score = gameState->getScore();
+		int multiple = score / awardBonusLife;
+		int awarded = gameState->getBonusLivesAwarded();
+		if (multiple > awarded) {
+			gameState->addBonusLivesAwarded(multiple - awarded);
+			gameState->addLives(multiple - awarded);
+			if (listener != nullptr) {
+				listener->bonusLife(brick);
+			}
+		}
+	}
+}
+
+int Playfield::getActiveBricks() {
+	int activeBricks = 0;
+	const int n = bricksWidth * bricksHigh;
+	for (int i = 0; i != n; i++) {
+		Brick* b = bricks[i];
+		if (b != nullptr) {
+			if (!b->isWall() && b->getHitCount() > 0) {
+				activeBricks++;
+			}
+		}
+	}
+	return activeBricks;
+}
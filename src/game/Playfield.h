@@ -0,0 +1,239 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef GAME_PLAYFIELD_H
+#define GAME_PLAYFIELD_H
+
+#include "config.h"
+
+#include <cmath>
+#include <random>
+
+#include "GameConfiguration.h"
+#include "GameState.h"
+#include "LevelDefinition.h"
+#include "TextureRepository.h"
+#include "Brick.h"
+#include "Paddle.h"
+#include "Ball.h"
+#include "IPlayfieldListener.h"
+
+/**
+ * @brief The game simulation for a single level, (ball movement, collisions and scoring).
+ *
+ * The playfield does no rendering, loading or sound, these are left to the listener, so it can be
+ * driven by the Level for play or stepped directly for simulation.
+ */
+class Playfield {
+  public:
+	/**
+	 * @brief Create a new playfield.
+	 * @param game The game configuration.
+	 * @param state The game state to update.
+	 * @param displayWidth The width of the field of play.
+	 * @param displayHeight The height of the field of play.
+	 * @param seed The seed for the bonus brick randomisation.
+	 */
+	Playfield(GameConfiguration* game, GameState* state, int displayWidth, int displayHeight, unsigned int seed);
+	virtual ~Playfield();
+	/**
+	 * @brief Build the bricks, paddle and ball for the given level.
+	 * @param level The level definition.
+	 * @param textures The brick textures, (indexed as per the level definition).
+	 * @param paddleTexture The texture for the paddle, (owned by the paddle).
+	 * @param ballTexture The texture for the ball, (owned by the ball).
+	 * @param deadZone The deadzone to use for the controller axis input.
+	 * @return TRUE if the level was built.
+	 */
+	bool load(LevelDefinition* level, TextureRepository* textures, Texture* paddleTexture, Texture* ballTexture, int deadZone);
+	/**
+	 * @brief Set the listener to receive playfield events.
+	 * @param listener The listener, (or nullptr for none).
+	 */
+	void setListener(IPlayfieldListener* listener);
+	/**
+	 * @brief Update the state of the playfield. (Move paddle, move ball, check collisions, etc).
+	 * @param elapsed The time elapsed in seconds since the last update.
+	 * @param animating TRUE if animations are still running, (delays moving to the next level).
+	 */
+	void update(double elapsed, bool animating);
+	/**
+	 * @brief Apply player input, (paddle movement, serve and bump).
+	 * @param event The input event.
+	 * @param paddle TRUE if the player controls the paddle, (rather than the auto pilot).
+	 */
+	void input(SDL_Event& event, bool paddle);
+	/**
+	 * @brief Put the ball into play.
+	 */
+	void serve();
+	/**
+	 * @brief Determine if the ball is in free movement.
+	 * @return TRUE if the ball is in play.
+	 */
+	bool isBallInPlay();
+	/**
+	 * @brief Have the ball bumped 10' on the next update.
+	 */
+	void bump();
+	/**
+	 * @brief Get the array of all bricks in the level.
+	 * @return The bricks, (bricksWidth * bricksHigh, row by row).
+	 */
+	Brick** getBricks();
+	/**
+	 * @brief Get the number of bricks wide the play area is.
+	 * @return The number of bricks.
+	 */
+	int getBricksWidth();
+	/**
+	 * @brief Get the number of bricks high the play area is.
+	 * @return The number of bricks.
+	 */
+	int getBricksHigh();
+	/**
+	 * @brief Get the paddle.
+	 * @return The paddle.
+	 */
+	Paddle* getPaddle();
+	/**
+	 * @brief Get the ball.
+	 * @return The ball.
+	 */
+	Ball* getBall();
+	/**
+	 * @brief Get the base value for all bricks.
+	 * @return The base value.
+	 */
+	int getBaseValue();
+	/**
+	 * Get the number of active bricks in the game of play.
+	 * @return The number of destructable bricks.
+	 */
+	int getActiveBricks();
+	/**
+	 * @brief Set the ratio of the start speed to add to the ball over all bricks.
+	 * @param ratio The speed increase ratio.
+	 */
+	void setBrickHitSpeedIncreaseRatio(double ratio);
+
+  private:
+	/**
+	 * @brief The current game state. (score, lives, etc).
+	 */
+	GameState* gameState;
+	/**
+	 * @brief The listener for playfield events.
+	 */
+	IPlayfieldListener* listener;
+	/**
+	 * @brief The width of the field of play.
+	 */
+	const int displayWidth;
+	/**
+	 * @brief The height of the field of play.
+	 */
+	const int displayHeight;
+	/**
+	* @brief The number of bricks wide the play area is.
+	*/
+	const int bricksWidth;
+	/**
+	* @brief The number of bricks high the play area is.
+	*/
+	const int bricksHigh;
+	/**
+	 * @brief The default start speed ratio of the ball.
+	 */
+	double defaultStartSpeed;
+	/**
+	 * @brief The ratio of the start speed to add to the ball over all bricks.
+	 */
+	double brickHitSpeedIncreaseRatio;
+	/**
+	 * @brief The score multiple at which to award a bonus life, (-1 for none).
+	 */
+	int awardBonusLife;
+	/**
+	 * @brief The initial speed of the ball.
+	 */
+	double initialSpeed;
+	/**
+	 * @brief the base value for all bricks.
+	 */
+	int baseValue;
+	/**
+	 * @brief The basic probability that a brick will have a bonus
+	 */
+	int bonusProbability;
+	/**
+	 * The bonus probabilities
+	 */
+	int bonusProbabilities[OCCILLO_LEVEL_BONUS_COUNT];
+	/**
+	 * @brief The array of all bricks in the level.
+	 */
+	Brick** bricks;
+	/**
+	 * @brief The paddle instance.
+	 */
+	Paddle* paddle;
+	/**
+	 * @brief The ball instance
+	 */
+	Ball* ball;
+	/**
+	 * @brief Flag to indicate if the ball is in free movement.
+	 */
+	bool ballInPlay;
+	/**
+	 * Flag to indicate that the ball should be bumped 10'.
+	 */
+	bool bumpBall;
+	/**
+	 * @brief The random source for bonus bricks.
+	 */
+	std::minstd_rand random;
+	/**
+	 * @brief Free the bricks, paddle and ball.
+	 */
+	void cleanup();
+	/**
+	 * Get the bonus to apply
+	 * @return The bonus to apply.
+	 */
+	int getBonus();
+	/**
+	 *
+	 * @param activeBricks
+	 * @param ctime
+	 * @param elapsed
+	 * @param cBrickX
+	 * @param cBrickY
+	 * @return
+	 */
+	Brick* findCollision(int &activeBricks, double &ctime, double elapsed, int &cBrickX, int &cBrickY);
+	/**
+	 * Perform the scoring/state changes on the given brick for a collision event.
+	 *
+	 * @param brick the brick that collided.
+	 */
+	void handleCollision(Brick* brick);
+};
+
+#endif /* GAME_PLAYFIELD_H */
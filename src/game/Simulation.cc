@@ -0,0 +1,259 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "Simulation.h"
+
+Simulation::Simulation(Playfield* playfield, AutoPilot* autoPilot, GameState* state) :
+	playfield(playfield), autoPilot(autoPilot), gameState(state) {
+	lastEvent = 0;
+	SDL_AtomicSet(&replayed, 0);
+	inputLock = SDL_CreateMutex();
+	worker = nullptr;
+	rate = 0;
+	scale = 1.0;
+	SDL_AtomicSet(&stopping, 0);
+	SDL_AtomicSet(&ending, 0);
+	SDL_AtomicSet(&paused, 0);
+	SDL_AtomicSet(&animating, 0);
+	playfield->setListener(this);
+	// So there is a snapshot before the first step.
+	publish();
+}
+
+Simulation::~Simulation() {
+	stop();
+	playfield->setListener(nullptr);
+	if (inputLock != nullptr) {
+		SDL_DestroyMutex(inputLock);
+	}
+}
+
+bool Simulation::start(int rate, double scale) {
+	if (worker != nullptr) {
+		return true;
+	}
+	this->rate = (rate > 0) ? rate : 1;
+	this->scale = (scale > 0.0) ? scale : 0.0;
+	SDL_AtomicSet(&stopping, 0);
+	worker = SDL_CreateThread(simulationWorker, "simulation", this);
+	if (worker == nullptr) {
+		g_warning("%s[%d] : Unable to start simulation thread: %s", __FILE__, __LINE__, SDL_GetError());
+		return false;
+	}
+	g_info("%s[%d] : Simulation thread at %d Hz", __FILE__, __LINE__, this->rate);
+	return true;
+}
+
+void Simulation::stop() {
+	if (worker != nullptr) {
+		SDL_AtomicSet(&stopping, 1);
+		SDL_WaitThread(worker, nullptr);
+		worker = nullptr;
+	}
+}
+
+bool Simulation::isRunning() {
+	return worker != nullptr;
+}
+
+int Simulation::simulationWorker(void* data) {
+	Simulation* sim = (Simulation*) data;
+	const Uint64 frequency = SDL_GetPerformanceFrequency();
+	const Uint64 period = frequency / sim->rate;
+	const double elapsed = sim->scale / sim->rate;
+	Uint64 next = SDL_GetPerformanceCounter();
+	while (SDL_AtomicGet(&sim->stopping) == 0) {
+		sim->step((SDL_AtomicGet(&sim->paused) != 0) ? 0.0 : elapsed);
+		sim->publish();
+		if (sim->gameState->getState() != GAME_CONTINUE) {
+			break;
+		}
+		next += period;
+		Uint64 now = SDL_GetPerformanceCounter();
+		if (now < next) {
+			SDL_Delay((Uint32)(((next - now) * 1000) / frequency));
+		} else if ((now - next) > (period * OCCILLO_SIMULATION_MAX_CATCHUP)) {
+			// Too far behind to catch up, so drop the time rather than spiral.
+			next = now;
+		}
+	}
+	return 0;
+}
+
+void Simulation::update(double elapsed) {
+	step(elapsed);
+	publish();
+}
+
+void Simulation::post(const SDL_Event& event) {
+	if (worker == nullptr) {
+		SDL_Event e = event;
+		playfield->input(e, autoPilot == nullptr);
+		return;
+	}
+	SDL_LockMutex(inputLock);
+	input.push_back(event);
+	SDL_UnlockMutex(inputLock);
+}
+
+void Simulation::end() {
+	SDL_AtomicSet(&ending, 1);
+}
+
+void Simulation::setPaused(bool paused) {
+	SDL_AtomicSet(&this->paused, paused ? 1 : 0);
+}
+
+void Simulation::setAnimating(bool animating) {
+	SDL_AtomicSet(&this->animating, animating ? 1 : 0);
+}
+
+void Simulation::step(double elapsed) {
+	std::vector<SDL_Event> events;
+	SDL_LockMutex(inputLock);
+	events.swap(input);
+	SDL_UnlockMutex(inputLock);
+	for (SDL_Event& e : events) {
+		playfield->input(e, autoPilot == nullptr);
+	}
+	if (SDL_AtomicGet(&ending) != 0) {
+		gameState->setState(GAME_END);
+		return;
+	}
+	if (autoPilot != nullptr) {
+		autoPilot->update(elapsed, playfield->isBallInPlay(), gameState->getScore());
+		if (!playfield->isBallInPlay() && autoPilot->serve() && (playfield->getActiveBricks() != 0)) {
+			playfield->serve();
+		}
+		if (autoPilot->bump()) {
+			playfield->bump();
+		}
+	}
+	playfield->update(elapsed, SDL_AtomicGet(&animating) != 0);
+}
+
+void Simulation::publish() {
+	// Drop the events the reader has replayed.
+	const int done = SDL_AtomicGet(&replayed);
+	if (!pending.empty() && (pending.front().id <= done)) {
+		std::vector<SimulationEvent> events;
+		std::vector<Brick> bricks;
+		for (SimulationEvent e : pending) {
+			if (e.id > done) {
+				if (e.brick >= 0) {
+					bricks.push_back(pendingBricks[e.brick]);
+					e.brick = bricks.size() - 1;
+				}
+				events.push_back(e);
+			}
+		}
+		pending.swap(events);
+		pendingBricks.swap(bricks);
+	}
+
+	PlayfieldSnapshot& snapshot = snapshots.getBack();
+	Brick** bricks = playfield->getBricks();
+	const int n = playfield->getBricksWidth() * playfield->getBricksHigh();
+	snapshot.hitCounts.resize(n);
+	for (int i = 0; i < n; i++) {
+		snapshot.hitCounts[i] = (bricks[i] != nullptr) ? bricks[i]->getHitCount() : 0;
+	}
+	snapshot.events = pending;
+	snapshot.bricks = pendingBricks;
+	snapshot.ballX = playfield->getBall()->getX();
+	snapshot.ballY = playfield->getBall()->getY();
+	snapshot.paddleX = playfield->getPaddle()->getX();
+	snapshot.paddleY = playfield->getPaddle()->getY();
+	snapshot.score = gameState->getScore();
+	snapshot.lives = gameState->getLives();
+	snapshot.state = gameState->getState();
+	snapshots.publish();
+}
+
+const PlayfieldSnapshot& Simulation::acquire(IPlayfieldListener* listener) {
+	snapshots.consume();
+	PlayfieldSnapshot& snapshot = snapshots.getFront();
+	int done = SDL_AtomicGet(&replayed);
+	for (SimulationEvent& e : snapshot.events) {
+		if (e.id <= done) {
+			continue;
+		}
+		Brick* brick = (e.brick >= 0) ? &snapshot.bricks[e.brick] : nullptr;
+		switch (e.type) {
+		case SIMULATION_BRICK_COLLISION:
+			listener->brickCollision(brick);
+			break;
+		case SIMULATION_BRICK_HIT:
+			listener->brickHit(brick);
+			break;
+		case SIMULATION_BONUS_LIFE:
+			listener->bonusLife(brick);
+			break;
+		case SIMULATION_PADDLE_COLLISION:
+			listener->paddleCollision();
+			break;
+		case SIMULATION_BALL_LOST:
+			listener->ballLost();
+			break;
+		case SIMULATION_BALL_BUMPED:
+			listener->ballBumped(e.x, e.y);
+			break;
+		}
+		done = e.id;
+	}
+	SDL_AtomicSet(&replayed, done);
+	return snapshot;
+}
+
+void Simulation::record(SimulationEventType type, Brick* brick, int x, int y) {
+	SimulationEvent e;
+	e.id = ++lastEvent;
+	e.type = type;
+	e.brick = -1;
+	e.x = x;
+	e.y = y;
+	if (brick != nullptr) {
+		pendingBricks.push_back(*brick);
+		e.brick = pendingBricks.size() - 1;
+	}
+	pending.push_back(e);
+}
+
+void Simulation::brickCollision(Brick* brick) {
+	record(SIMULATION_BRICK_COLLISION, brick);
+}
+
+void Simulation::brickHit(Brick* brick) {
+	record(SIMULATION_BRICK_HIT, brick);
+}
+
+void Simulation::bonusLife(Brick* brick) {
+	record(SIMULATION_BONUS_LIFE, brick);
+}
+
+void Simulation::paddleCollision() {
+	record(SIMULATION_PADDLE_COLLISION, nullptr);
+}
+
+void Simulation::ballLost() {
+	record(SIMULATION_BALL_LOST, nullptr);
+}
+
+void Simulation::ballBumped(int x, int y) {
+	record(SIMULATION_BALL_BUMPED, nullptr, x, y);
+}
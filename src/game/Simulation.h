@@ -0,0 +1,293 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef GAME_SIMULATION_H
+#define GAME_SIMULATION_H
+
+#include "config.h"
+
+#include <vector>
+#include <SDL.h>
+#include <glib.h>
+
+#include "GameState.h"
+#include "Playfield.h"
+#include "AutoPilot.h"
+#include "IPlayfieldListener.h"
+#include "TripleBuffer.h"
+
+/**
+ * @brief The most simulation steps to catch up on before the simulation thread drops the time, (eg after a stall).
+ */
+#define OCCILLO_SIMULATION_MAX_CATCHUP 8
+
+/**
+ * @brief The playfield events, as recorded in a snapshot.
+ */
+enum SimulationEventType {
+	SIMULATION_BRICK_COLLISION,  /**< IPlayfieldListener::brickCollision() */
+	SIMULATION_BRICK_HIT,        /**< IPlayfieldListener::brickHit() */
+	SIMULATION_BONUS_LIFE,       /**< IPlayfieldListener::bonusLife() */
+	SIMULATION_PADDLE_COLLISION, /**< IPlayfieldListener::paddleCollision() */
+	SIMULATION_BALL_LOST,        /**< IPlayfieldListener::ballLost() */
+	SIMULATION_BALL_BUMPED       /**< IPlayfieldListener::ballBumped() */
+};
+
+/**
+ * @brief A playfield event, to be replayed to the level on the render thread.
+ */
+struct SimulationEvent {
+	/**
+	 * @brief The event sequence number.
+	 */
+	int id;
+	/**
+	 * @brief The event.
+	 */
+	SimulationEventType type;
+	/**
+	 * @brief The index of the copy of the brick in the snapshot, (or -1 for none).
+	 */
+	int brick;
+	/**
+	 * @brief The x co-ordinate, (bumps only).
+	 */
+	int x;
+	/**
+	 * @brief The y co-ordinate, (bumps only).
+	 */
+	int y;
+};
+
+/**
+ * @brief An immutable copy of the playfield state, taken after a simulation step.
+ */
+struct PlayfieldSnapshot {
+	/**
+	 * @brief The hit count of each brick, (as per Playfield::getBricks(), 0 once destroyed).
+	 */
+	std::vector<int> hitCounts;
+	/**
+	 * @brief The events not yet known to be replayed, (oldest first).
+	 */
+	std::vector<SimulationEvent> events;
+	/**
+	 * @brief Copies of the bricks the events refer to, as they were at the event.
+	 */
+	std::vector<Brick> bricks;
+	/**
+	 * @brief The ball x co-ordinate.
+	 */
+	int ballX;
+	/**
+	 * @brief The ball y co-ordinate.
+	 */
+	int ballY;
+	/**
+	 * @brief The paddle x co-ordinate.
+	 */
+	int paddleX;
+	/**
+	 * @brief The paddle y co-ordinate.
+	 */
+	int paddleY;
+	/**
+	 * @brief The score.
+	 */
+	int score;
+	/**
+	 * @brief The number of lives.
+	 */
+	int lives;
+	/**
+	 * @brief The game run state.
+	 */
+	GAME_RUNSTATE state;
+};
+
+/**
+ * @brief Steps the playfield and publishes a snapshot of it after each step.
+ *
+ * By default the level steps the simulation once per frame. Once started, the simulation steps at a
+ * fixed rate on its own thread instead, taking input through post() and publishing snapshots through
+ * a lock free triple buffer, so physics and input are not held up by the renderer. Either way the
+ * level renders from the snapshot and replays its events, so the playfield, auto pilot and game
+ * state are only touched by the simulation.
+ */
+class Simulation : public IPlayfieldListener {
+  public:
+	/**
+	 * @brief Create a new simulation.
+	 * @param playfield The playfield to step.
+	 * @param autoPilot The auto pilot, (or nullptr if the player controls the paddle).
+	 * @param state The game state.
+	 */
+	Simulation(Playfield* playfield, AutoPilot* autoPilot, GameState* state);
+	/**
+	 * @brief Stop the simulation thread, if running.
+	 */
+	virtual ~Simulation();
+	/**
+	 * @brief Start stepping on a separate thread.
+	 * @param rate The number of steps per second.
+	 * @param scale The rate at which game time passes, (1 for real time).
+	 * @return TRUE if the thread started.
+	 */
+	bool start(int rate, double scale);
+	/**
+	 * @brief Stop the simulation thread and wait for it to exit.
+	 */
+	void stop();
+	/**
+	 * @brief Determine if stepping on a separate thread.
+	 * @return TRUE if the simulation thread is running.
+	 */
+	bool isRunning();
+	/**
+	 * @brief Step the simulation and publish a snapshot, (when not running on a thread).
+	 * @param elapsed The time elapsed in seconds since the last step.
+	 */
+	void update(double elapsed);
+	/**
+	 * @brief Pass an input event to the playfield.
+	 * @param event The event.
+	 */
+	void post(const SDL_Event& event);
+	/**
+	 * @brief End the game on the next step.
+	 */
+	void end();
+	/**
+	 * @brief Pause or unpause the simulation thread.
+	 * @param paused TRUE to pause.
+	 */
+	void setPaused(bool paused);
+	/**
+	 * @brief Set if animations are running, (delays moving to the next level).
+	 * @param animating TRUE if animations are running.
+	 */
+	void setAnimating(bool animating);
+	/**
+	 * @brief Take the latest snapshot, and replay any events not yet replayed to the given listener.
+	 * @param listener The listener.
+	 * @return The snapshot, (valid until the next call).
+	 */
+	const PlayfieldSnapshot& acquire(IPlayfieldListener* listener);
+
+	void brickCollision(Brick* brick);
+	void brickHit(Brick* brick);
+	void bonusLife(Brick* brick);
+	void paddleCollision();
+	void ballLost();
+	void ballBumped(int x, int y);
+
+  private:
+	/**
+	 * @brief The playfield.
+	 */
+	Playfield* playfield;
+	/**
+	 * @brief The auto pilot, (or nullptr).
+	 */
+	AutoPilot* autoPilot;
+	/**
+	 * @brief The game state.
+	 */
+	GameState* gameState;
+	/**
+	 * @brief The snapshots.
+	 */
+	TripleBuffer<PlayfieldSnapshot> snapshots;
+	/**
+	 * @brief The events not yet known to be replayed.
+	 */
+	std::vector<SimulationEvent> pending;
+	/**
+	 * @brief Copies of the bricks the pending events refer to.
+	 */
+	std::vector<Brick> pendingBricks;
+	/**
+	 * @brief The sequence number of the last event recorded.
+	 */
+	int lastEvent;
+	/**
+	 * @brief The sequence number of the last event replayed, (set by the reader).
+	 */
+	SDL_atomic_t replayed;
+	/**
+	 * @brief The input events posted to the simulation thread.
+	 */
+	std::vector<SDL_Event> input;
+	/**
+	 * @brief Lock for the input events.
+	 */
+	SDL_mutex* inputLock;
+	/**
+	 * @brief The simulation thread, (nullptr when stepped by the level).
+	 */
+	SDL_Thread* worker;
+	/**
+	 * @brief The number of steps per second on the simulation thread.
+	 */
+	int rate;
+	/**
+	 * @brief The rate at which game time passes on the simulation thread.
+	 */
+	double scale;
+	/**
+	 * @brief Non zero to stop the simulation thread.
+	 */
+	SDL_atomic_t stopping;
+	/**
+	 * @brief Non zero to end the game.
+	 */
+	SDL_atomic_t ending;
+	/**
+	 * @brief Non zero if the simulation thread is paused.
+	 */
+	SDL_atomic_t paused;
+	/**
+	 * @brief Non zero if animations are running.
+	 */
+	SDL_atomic_t animating;
+	/**
+	 * @brief Step the simulation.
+	 * @param elapsed The time elapsed in seconds.
+	 */
+	void step(double elapsed);
+	/**
+	 * @brief Copy the playfield into the back snapshot and publish it.
+	 */
+	void publish();
+	/**
+	 * @brief Record an event.
+	 * @param type The event.
+	 * @param brick The brick, (or nullptr).
+	 * @param x The x co-ordinate.
+	 * @param y The y co-ordinate.
+	 */
+	void record(SimulationEventType type, Brick* brick, int x = 0, int y = 0);
+	/**
+	 * @brief The simulation thread.
+	 * @param data The simulation.
+	 * @return 0.
+	 */
+	static int simulationWorker(void* data);
+};
+
+#endif /* GAME_SIMULATION_H */
@@ -18,29 +18,29 @@
 
 #include "TextureFadeAnimation.h"
 
-TextureFadeAnimation::TextureFadeAnimation(Texture *texture, int x, int y, uint32_t animationTime, uint32_t gravity)
+TextureFadeAnimation::TextureFadeAnimation(const FrameClock& clock, Texture *texture, int x, int y, uint32_t animationTime, uint32_t gravity)
 : UIImage(texture) {
     setX(x);
     setY(y);
     this->animationTime = animationTime;
     this->gravity = gravity;
-    this->startTime = SDL_GetTicks();
+    this->startTime = clock.getTime();
 }
 
 TextureFadeAnimation::~TextureFadeAnimation() {
 }
 
-bool TextureFadeAnimation::isComplete() {
-    return ((SDL_GetTicks() - startTime) > animationTime);
+bool TextureFadeAnimation::isComplete(const FrameClock& clock) {
+    return ((clock.getTime() - startTime) > animationTime);
 }
 
-bool TextureFadeAnimation::reset() {
-    this->startTime = SDL_GetTicks();
+bool TextureFadeAnimation::reset(const FrameClock& clock) {
+    this->startTime = clock.getTime();
     return true;
 }
 
-void TextureFadeAnimation::render(SDL_Renderer* renderer) {
-    float timeDelta = (float) (SDL_GetTicks() - startTime);
+void TextureFadeAnimation::render(SDL_Renderer* renderer, const FrameClock& clock) {
+    float timeDelta = (float) (clock.getTime() - startTime);
     float alpha = 255.0f - (timeDelta / (float) animationTime * 255.0f);
     texture->setAlpha((Uint8) alpha);
     int oldY = getY();
@@ -28,21 +28,22 @@ class TextureFadeAnimation : public GameAnimation , public UIImage {
   public:
 	/**
 	 * Create a new title animation sequence.
+	 * @param clock The frame clock, (the animation starts at the current frame).
 	 * @param texture The texture to animate. (Is owned by this object).
 	 * @param x The x co-ordinate to display.
 	 * @param y The y co-ordinate to display.
 	 * @param animationTime The time to animate the fade to transparent.
 	     * @param gravity The vertical drop rate.
 	 */
-	TextureFadeAnimation(Texture *texture, int x, int y, uint32_t animationTime, uint32_t gravity = 0);
+	TextureFadeAnimation(const FrameClock& clock, Texture *texture, int x, int y, uint32_t animationTime, uint32_t gravity = 0);
 
 	virtual ~TextureFadeAnimation();
 
-	bool isComplete();
+	bool isComplete(const FrameClock& clock);
 
-	bool reset();
+	bool reset(const FrameClock& clock);
 
-	void render(SDL_Renderer* renderer);
+	void render(SDL_Renderer* renderer, const FrameClock& clock);
 
   private:
 	/**
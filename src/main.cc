@@ -27,6 +27,11 @@
 #include "TextureRepository.h"
 #include "Level.h"
 #include "MainMenu.h"
+#include "Game.h"
+#include "BenchmarkTour.h"
+#include "JobSystem.h"
+
+#include <fstream>
 
 /*
  * Private method definitions.
@@ -34,11 +39,13 @@
 
 /**
  * Main application initialisation function<P>
- * Reads the application configuration, sets up the display, and
+ * Reads the application configuration and command line, sets up the display, and
  * creates the initial menu application state.
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
  * @return TRUE if initialized correctly
  */
-bool MainInit();
+bool MainInit(int argc, char** argv);
 /**
  * @brief Main application exit/cleanup code.
  */
@@ -65,20 +72,165 @@ GameConfiguration* game = nullptr;
  */
 std::stack<IAppState*>* applicationState = nullptr;
 
+/*
+ * Command line options, these override the configuration for this session only.
+ */
+static gchar* optLevel = nullptr;
+static gint optWidth = 0;
+static gint optHeight = 0;
+static gboolean optFullscreen = FALSE;
+static gboolean optWindowed = FALSE;
+static gint optSeed = -1;
+static gint optBenchmark = 0;
+static gboolean optHeadless = FALSE;
+static gboolean optAutoPlay = FALSE;
+static gboolean optProfile = FALSE;
+static gchar* optTrace = nullptr;
+static gchar* optTour = nullptr;
+static gboolean optSoftware = FALSE;
+static gboolean optStats = FALSE;
+static gchar* optCounters = nullptr;
+static gdouble optTimeStep = 0.0;
+static gdouble optTimeScale = 1.0;
+static gint optSimulationRate = -1;
+static gint optWorkers = -1;
+static gchar* optJobTrace = nullptr;
+static gchar* optRecord = nullptr;
+static gint optRecordFps = OCCILLO_RECORDER_DEFAULT_FPS;
+static gboolean optRecordThrottle = FALSE;
+static gint optLogicalWidth = -1;
+static gint optLogicalHeight = -1;
+static gboolean optLowDpi = FALSE;
+static gboolean optSoftwareCursor = FALSE;
+static gint optDynamicScale = 0;
+static gint optDynamicFps = 0;
+
+static GOptionEntry entries[] = {
+	{ "level", 'l', 0, G_OPTION_ARG_FILENAME, &optLevel, "Play the given level file directly", "FILE" },
+	{ "width", 'W', 0, G_OPTION_ARG_INT, &optWidth, "Display width", "PX" },
+	{ "height", 'H', 0, G_OPTION_ARG_INT, &optHeight, "Display height", "PX" },
+	{ "fullscreen", 'f', 0, G_OPTION_ARG_NONE, &optFullscreen, "Run fullscreen", nullptr },
+	{ "windowed", 'w', 0, G_OPTION_ARG_NONE, &optWindowed, "Run in a window", nullptr },
+	{ "seed", 's', 0, G_OPTION_ARG_INT, &optSeed, "Random seed, (for repeatable runs)", "N" },
+	{ "benchmark", 'b', 0, G_OPTION_ARG_INT, &optBenchmark, "Auto play the given number of frames, then exit and report frame times", "FRAMES" },
+	{ "headless", 0, 0, G_OPTION_ARG_NONE, &optHeadless, "Use the dummy video and audio drivers", nullptr },
+	{ "autoplay", 'a', 0, G_OPTION_ARG_NONE, &optAutoPlay, "Have the auto pilot control the paddle", nullptr },
+	{ "profile", 'p', 0, G_OPTION_ARG_NONE, &optProfile, "Log the frame rate and frame times every second", nullptr },
+	{ "trace", 't', 0, G_OPTION_ARG_FILENAME, &optTrace, "Write the time of every frame to the given CSV file", "FILE" },
+	{ "tour", 0, 0, G_OPTION_ARG_FILENAME, &optTour, "Run each menu and level for a fixed number of frames, (--benchmark, default 300), and write the results to the given CSV file", "FILE" },
+	{ "software", 0, 0, G_OPTION_ARG_NONE, &optSoftware, "Use the software renderer", nullptr },
+	{ "stats", 0, 0, G_OPTION_ARG_NONE, &optStats, "Show the work counters panel, (toggle with F10)", nullptr },
+	{ "counters", 0, 0, G_OPTION_ARG_FILENAME, &optCounters, "Write the work counters every second to the given JSON lines file", "FILE" },
+	{ "timestep", 0, 0, G_OPTION_ARG_DOUBLE, &optTimeStep, "Advance game time by a fixed step each frame, (for deterministic runs)", "MS" },
+	{ "time-scale", 0, 0, G_OPTION_ARG_DOUBLE, &optTimeScale, "Scale the rate at which game time passes, (eg 0.25 for slow motion)", "SCALE" },
+	{ "sim-rate", 0, 0, G_OPTION_ARG_INT, &optSimulationRate, "Simulate levels on their own thread at the given steps per second, (0 to simulate on the render thread)", "HZ" },
+	{ "workers", 0, 0, G_OPTION_ARG_INT, &optWorkers, "Number of job system worker threads, (0 for one less than the number of cores)", "N" },
+	{ "job-trace", 0, 0, G_OPTION_ARG_FILENAME, &optJobTrace, "Write the name, worker and time of every job to the given CSV file", "FILE" },
+	{ "logical-width", 0, 0, G_OPTION_ARG_INT, &optLogicalWidth, "Render the game at the given width and scale it to the display, (0 for the display width)", "PX" },
+	{ "logical-height", 0, 0, G_OPTION_ARG_INT, &optLogicalHeight, "Render the game at the given height and scale it to the display, (0 for the display height)", "PX" },
+	{ "low-dpi", 0, 0, G_OPTION_ARG_NONE, &optLowDpi, "Render HiDPI displays at the window size, (upscaled by the system)", nullptr },
+	{ "software-cursor", 0, 0, G_OPTION_ARG_NONE, &optSoftwareCursor, "Draw the menu pointer with the renderer rather than as a hardware cursor", nullptr },
+	{ "dynamic-scale", 0, 0, G_OPTION_ARG_INT, &optDynamicScale, "Lower the level resolution to as little as the given percent when frames are slow, (100 to disable)", "PERCENT" },
+	{ "dynamic-fps", 0, 0, G_OPTION_ARG_INT, &optDynamicFps, "The frame rate dynamic resolution aims for, (default 60)", "FPS" },
+	{ "record", 0, 0, G_OPTION_ARG_FILENAME, &optRecord, "Record every frame to the given file, (.y4m, .png for a numbered sequence, or raw ARGB8888 frames)", "FILE" },
+	{ "record-fps", 0, 0, G_OPTION_ARG_INT, &optRecordFps, "Frame rate written to the recording, (Y4M only, default 60)", "FPS" },
+	{ "record-throttle", 0, 0, G_OPTION_ARG_NONE, &optRecordThrottle, "Slow rendering to the recording writer rather than drop frames", nullptr },
+	{ nullptr, 0, 0, G_OPTION_ARG_NONE, nullptr, nullptr, nullptr }
+};
+
+/**
+ * The job trace, (written by any worker).
+ */
+static std::ofstream jobTrace;
+/**
+ * Lock for the job trace.
+ */
+static SDL_SpinLock jobTraceLock = 0;
+
+/**
+ * Job system timing hook, writing each job to the job trace.
+ * @param name The job name.
+ * @param worker The worker index, (-1 for a thread that is not a worker).
+ * @param start The performance counter at the start of the job.
+ * @param end The performance counter at the end of the job.
+ */
+static void traceJob(const char* name, int worker, Uint64 start, Uint64 end) {
+	const double frequency = (double) SDL_GetPerformanceFrequency();
+	SDL_AtomicLock(&jobTraceLock);
+	jobTrace << name << "," << worker << "," << (start * 1000.0 / frequency) << "," << ((end - start) * 1000.0 / frequency) << "\n";
+	SDL_AtomicUnlock(&jobTraceLock);
+}
+
+/**
+ * Apply the command line overrides to the configuration.
+ */
+static void applyOverrides() {
+	if (optWidth > 0) {
+		config->setDisplayWidth(optWidth);
+		config->setOverride(OCCILLO_CONFIGURATION_SETTING_DISPLAY_WIDTH);
+	}
+	if (optHeight > 0) {
+		config->setDisplayHeight(optHeight);
+		config->setOverride(OCCILLO_CONFIGURATION_SETTING_DISPLAY_HEIGHT);
+	}
+	if (optLogicalWidth >= 0) {
+		config->setLogicalWidth(optLogicalWidth);
+		config->setOverride(OCCILLO_CONFIGURATION_SETTING_LOGICAL_WIDTH);
+	}
+	if (optLogicalHeight >= 0) {
+		config->setLogicalHeight(optLogicalHeight);
+		config->setOverride(OCCILLO_CONFIGURATION_SETTING_LOGICAL_HEIGHT);
+	}
+	if (optLowDpi) {
+		config->setLowDpi(true);
+		config->setOverride(OCCILLO_CONFIGURATION_SETTING_LOW_DPI);
+	}
+	if (optSoftwareCursor) {
+		config->setSoftwareCursor(true);
+		config->setOverride(OCCILLO_CONFIGURATION_SETTING_SOFTWARE_CURSOR);
+	}
+	if (optDynamicScale > 0) {
+		config->setDynamicScaleMin(optDynamicScale);
+		config->setOverride(OCCILLO_CONFIGURATION_SETTING_DYNAMIC_SCALE_MIN);
+	}
+	if (optDynamicFps > 0) {
+		config->setDynamicScaleFps(optDynamicFps);
+		config->setOverride(OCCILLO_CONFIGURATION_SETTING_DYNAMIC_SCALE_FPS);
+	}
+	if (optFullscreen || optWindowed) {
+		config->setFullscreen(optFullscreen);
+		config->setOverride(OCCILLO_CONFIGURATION_SETTING_FULLSCREEN);
+	}
+	if (optAutoPlay || (optBenchmark > 0) || (optTour != nullptr)) {
+		config->setAutoPlay(true);
+		config->setOverride(OCCILLO_CONFIGURATION_SETTING_AUTOPLAY);
+	}
+	if (optSimulationRate >= 0) {
+		config->setSimulationRate(optSimulationRate);
+		config->setOverride(OCCILLO_CONFIGURATION_SETTING_SIMULATION_RATE);
+	}
+	if (optWorkers >= 0) {
+		config->setWorkerThreads(optWorkers);
+		config->setOverride(OCCILLO_CONFIGURATION_SETTING_WORKER_THREADS);
+	}
+}
+
 // ****************************************************************************
 
 
 
 /**
  * Main Function
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
  * @return exit code
  */
-int main(void) {
-	bool res = MainInit();
+int main(int argc, char** argv) {
+	bool res = MainInit(argc, argv);
 	// Start main outer loop
 	if (res) {
-		// Keep running whilst we have an application state.
-		while (!applicationState->empty()) {
+		// Keep running whilst we have an application state, (or until the benchmark frame limit is reached).
+		while (!applicationState->empty() && !display->isQuitRequested()) {
 			// Get the current application state, activate and run it. If it's complete, deactivate it, and
 			// pop the application state stack.
 			IAppState* state = applicationState->top();
@@ -96,6 +248,10 @@ int main(void) {
 		}
 	}
 
+	if (res && (optTour == nullptr) && ((optBenchmark > 0) || optProfile)) {
+		display->getFrameStats()->report();
+	}
+
 	//Free resources and close SDL
 	MainExit();
 	if (res) {
@@ -115,7 +271,7 @@ int CALLBACK WinMain(
     _In_ LPSTR     lpCmdLine,
     _In_ int       nCmdShow
 ) {
-	return main();
+	return main(__argc, __argv);
 }
 
 #endif
@@ -129,11 +285,13 @@ std::stack<IAppState*>* getApplicationState() {
 
 /**
  * Main application initialisation function<P>
- * Reads the application configuration, sets up the display, and
+ * Reads the application configuration and command line, sets up the display, and
  * creates the initial menu application state.
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
  * @return TRUE if initialized correctly
  */
-bool MainInit() {
+bool MainInit(int argc, char** argv) {
 #ifdef ENABLE_NLS
 	setlocale(LC_ALL, "");
 	bindtextdomain(PACKAGE_NAME, LOCALEDIR);
@@ -142,8 +300,33 @@ bool MainInit() {
 #endif
 	g_info("%s[%d] : %s", __FILE__, __LINE__, PACKAGE_NAME " v" PACKAGE_VERSION);
 
+	GError* error = nullptr;
+	GOptionContext* context = g_option_context_new(nullptr);
+	g_option_context_set_translation_domain(context, PACKAGE_NAME);
+	g_option_context_add_main_entries(context, entries, PACKAGE_NAME);
+	if (!g_option_context_parse(context, &argc, &argv, &error)) {
+		g_printerr("%s\n", error->message);
+		g_error_free(error);
+		g_option_context_free(context);
+		return false;
+	}
+	g_option_context_free(context);
+
 	// rand..
-	std::srand(std::time(NULL));
+	if (optSeed >= 0) {
+		std::srand(optSeed);
+	} else {
+		std::srand(std::time(NULL));
+	}
+
+	if (optHeadless) {
+		// Must be set before SDL is initialised.
+		g_setenv("SDL_VIDEODRIVER", "dummy", TRUE);
+		g_setenv("SDL_AUDIODRIVER", "dummy", TRUE);
+	}
+	if (optSoftware) {
+		SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+	}
 
 	config = new Configuration();
 	display = new Display();
@@ -151,6 +334,7 @@ bool MainInit() {
 	configFile = PACKAGE_NAME".ini";
 	g_info("%s[%d] : %s %s", __FILE__, __LINE__, _("Configuration File "), configFile.c_str());
 	config->load(configFile);
+	applyOverrides();
 	g_info("%s[%d] : %s %s", __FILE__, __LINE__, _("Data directory is "), (config->getDataPath()->c_str()));
 	g_info("%s[%d] : %s %s", __FILE__, __LINE__, _("Game definition file is "), (config->getGameConfiguration()->c_str()));
 
@@ -163,12 +347,48 @@ bool MainInit() {
 	game = new GameConfiguration();
 	game->load(gameConfig);
 
+	if (optLevel != nullptr) {
+		// Play only the given level, (repeated on completion).
+		std::vector<std::string>* levels = game->getLevels();
+		levels->clear();
+		levels->push_back(optLevel);
+	}
+
+	FrameStats* stats = display->getFrameStats();
+	if (optTour == nullptr) {
+		stats->setFrameLimit(optBenchmark);
+	}
+	stats->setProfile(optProfile);
+	if ((optTrace != nullptr) && !stats->setTrace(optTrace)) {
+		return false;
+	}
+	if ((optCounters != nullptr) && !WorkCounters::setDump(optCounters)) {
+		return false;
+	}
+	display->setStatsVisible(optStats);
+	FrameClock* clock = display->getFrameClock();
+	clock->setFixedStep(optTimeStep);
+	clock->setScale(optTimeScale);
+
+	if (optJobTrace != nullptr) {
+		jobTrace.open(optJobTrace, std::ofstream::out);
+		if (!jobTrace.is_open()) {
+			g_warning("%s[%d] : Unable to open job trace file %s", __FILE__, __LINE__, optJobTrace);
+			return false;
+		}
+		jobTrace << "name,worker,start_ms,duration_ms" << std::endl;
+		JobSystem::setTimingHook(traceJob);
+	}
+	JobSystem::init(config->getWorkerThreads());
 
 	//Start up SDL and create window
 	if (!display->init(config, game)) {
 		g_warning("%s[%d] : %s", __FILE__, __LINE__, _("Failed to initialize, exiting application"));
 		return false;
 	}
+	if ((optRecord != nullptr) && !display->startRecording(optRecord, optRecordFps, optRecordThrottle)) {
+		return false;
+	}
 
 	//Set textdomain if set.
 	std::string* td = game->getTextDomain();
@@ -181,10 +401,21 @@ bool MainInit() {
 	// Setup the initial application state stack.
 	applicationState = new std::stack<IAppState*>();
 
+	// The benchmark tour runs the menus and levels itself.
+	if (optTour != nullptr) {
+		applicationState->push(new BenchmarkTour(config, game, display, optTour, (optBenchmark > 0) ? optBenchmark : OCCILLO_TOUR_FRAMES));
+		return true;
+	}
+
 	// Add in the Menu Application State.
 	IAppState* state = new MainMenu(config, game, display);
 	applicationState->push(state);
 
+	// Auto play, or a given level goes straight into a game, returning to the menu when the player quits.
+	if (config->isAutoPlay() || (optLevel != nullptr)) {
+		applicationState->push(new Game(config, game, display));
+	}
+
 	/* Note, the menu will create the Game Application State on demand and
 	 will place it on the top of the application state stack as needed. */
 	return true;
@@ -194,8 +425,8 @@ bool MainInit() {
  * Free application resources;
  */
 void MainExit() {
-	display->close();
-	config->store(configFile);
+	WorkCounters::close();
+	// The states go first, as they hold textures and sounds, (and may be loading a level in the background).
 	if (applicationState != nullptr) {
 		while (!applicationState->empty()) {
 			IAppState* state = applicationState->top();
@@ -206,11 +437,29 @@ void MainExit() {
 			}
 		}
 	}
+	// Both are null if the command line could not be parsed.
+	if (display != nullptr) {
+		display->close();
+	}
+	if (config != nullptr) {
+		config->store(configFile);
+	}
 	if (game != nullptr) {
 		delete game;
 	}
-	delete config;
-	delete display;
+	if (config != nullptr) {
+		delete config;
+	}
+	if (display != nullptr) {
+		delete display;
+	}
+	// No jobs remain, (the states and caches wait on their own).
+	JobSystem::shutdown();
+	if (jobTrace.is_open()) {
+		jobTrace.close();
+	}
+	// Nothing reads from the resource pack now.
+	ResourcePack::close();
 	if (applicationState != nullptr) {
 		delete applicationState;
 	}
@@ -25,16 +25,16 @@ CreditsMenu::CreditsMenu(Configuration* config, GameConfiguration* game, Display
 
 bool CreditsMenu::Activate() {
 	if (widgets == nullptr) {
-		const int dh = config->getDisplayHeight();
-		const int dw = config->getDisplayWidth();
+		const int dh = config->getRenderHeight();
+		const int dw = config->getRenderWidth();
 		const int bh = dh / MENU_ROWS;
 		//const int bw = dw / MENU_COLUMNS;
 		const int menuA = config->getMenuFocusAlpha();
 		const int menuNA = config->getMenuNonFocusAlpha();
 
-		TTF_Font* fontTitle = TTF_OpenFont(config->locateResource(*(game->getFontBold())).c_str(), bh);
-		TTF_Font* font = TTF_OpenFont(config->locateResource(*(game->getFont())).c_str(), bh);
-		TTF_Font* fontLabel = TTF_OpenFont(config->locateResource(*(game->getFont())).c_str(), bh * 2 / 3);
+		TTF_Font* fontTitle = display->getFontCache()->getFont(config->locateResource(*(game->getFontBold())), bh);
+		TTF_Font* font = display->getFontCache()->getFont(config->locateResource(*(game->getFont())), bh);
+		TTF_Font* fontLabel = display->getFontCache()->getFont(config->locateResource(*(game->getFont())), bh * 2 / 3);
 
 		widgets = new std::vector<IUIWidget*>();
 
@@ -49,18 +49,28 @@ bool CreditsMenu::Activate() {
 		// Credits.
 		std::string creditsFilename = config->locateResource(*(game->getCreditsFilename()));
 		if (!creditsFilename.empty()) {
-			std::ifstream filestream(creditsFilename);
-			if (filestream.is_open()) {
+			// Read from the resource pack, or the loose file.
+			std::ifstream file;
+			std::istringstream packed;
+			std::istream* filestream = &file;
+			const char* data = nullptr;
+			size_t size = 0;
+			if (ResourcePack::find(creditsFilename, &data, &size)) {
+				packed.str(std::string(data, size));
+				filestream = &packed;
+			} else {
+				file.open(creditsFilename);
+			}
+			if (filestream->good()) {
 				std::string line;
 				int i = 4;
-				while (std::getline(filestream, line)) {
+				while (std::getline(*filestream, line)) {
 					if (!line.empty()) {
 						newLabel(_(line.c_str()), fontLabel, i++);
 					} else {
 						i++;
 					}
 				}
-				filestream.close();
 			}
 		} else {
 			newLabel(_("Dedicated to"), fontLabel, 4);
@@ -78,19 +88,14 @@ bool CreditsMenu::Activate() {
 		                                 menuA, menuNA);
 		widgets->push_back(widget);
 		widget->addEventListener(this);
-
-		// Free the font.
-		TTF_CloseFont(font);
-		TTF_CloseFont(fontTitle);
-		TTF_CloseFont(fontLabel);
 	}
 	runstate = CONTINUE;
 	return true;
 }
 
 void CreditsMenu::newLabel(const std::string & text, TTF_Font * font, int y) {
-	const int dw = config->getDisplayWidth();
-	const int dh = config->getDisplayHeight();
+	const int dw = config->getRenderWidth();
+	const int dh = config->getRenderHeight();
 	const int bh = dh / MENU_ROWS;
 
 	if (!text.empty()) {
@@ -22,9 +22,13 @@
 
 #include "config.h"
 
+#include <fstream>
+#include <sstream>
+
 // main.h includes the gettext, sdl, etc items
 #include "Menu.h"
 #include "MainMenu.h"
+#include "ResourcePack.h"
 
 /**
 * @brief The Credits Menu
@@ -28,15 +28,15 @@ HiScoreMenu::HiScoreMenu(Configuration* config, GameConfiguration* game, Display
 bool HiScoreMenu::Activate() {
 	if (widgets == nullptr) {
 
-		const int dw = config->getDisplayWidth();
-		const int dh = config->getDisplayHeight();
+		const int dw = config->getRenderWidth();
+		const int dh = config->getRenderHeight();
 		const int bh = dh / MENU_ROWS;
 		const int menuA = config->getMenuFocusAlpha();
 		const int menuNA = config->getMenuNonFocusAlpha();
 
-		TTF_Font* fontTitle = TTF_OpenFont(config->locateResource(*(game->getFontBold())).c_str(), bh);
-		TTF_Font* font = TTF_OpenFont(config->locateResource(*(game->getFont())).c_str(), bh);
-		TTF_Font* fontLabel = TTF_OpenFont(config->locateResource(*(game->getFont())).c_str(), bh * 2 / 3);
+		TTF_Font* fontTitle = display->getFontCache()->getFont(config->locateResource(*(game->getFontBold())), bh);
+		TTF_Font* font = display->getFontCache()->getFont(config->locateResource(*(game->getFont())), bh);
+		TTF_Font* fontLabel = display->getFontCache()->getFont(config->locateResource(*(game->getFont())), bh * 2 / 3);
 
 		widgets = new std::vector<IUIWidget*>();
 
@@ -68,11 +68,6 @@ bool HiScoreMenu::Activate() {
 		IUIWidget* widget = new UIButton(text, (dw / 2) - (text->getWidth() / 2), bh * (MENU_ROWS - 3), menuA, menuNA);
 		widgets->push_back(widget);
 		widget->addEventListener(this);
-
-		// Free the font.
-		TTF_CloseFont(font);
-		TTF_CloseFont(fontTitle);
-		TTF_CloseFont(fontLabel);
 	}
 	runstate = CONTINUE;
 	return true;
@@ -80,8 +75,8 @@ bool HiScoreMenu::Activate() {
 
 void HiScoreMenu::newLabel(const std::string& text, TTF_Font *font, int y) {
 	
-	const int dw = config->getDisplayWidth();
-	const int dh = config->getDisplayHeight();
+	const int dw = config->getRenderWidth();
+	const int dh = config->getRenderHeight();
 	const int bh = dh / MENU_ROWS;
 
 	if (!text.empty()) {
@@ -92,8 +87,8 @@ void HiScoreMenu::newLabel(const std::string& text, TTF_Font *font, int y) {
 }
 
 void HiScoreMenu::newScoreLine(const HighScore& score, TTF_Font *font, int y) {
-	const int dw = config->getDisplayWidth();
-	const int dh = config->getDisplayHeight();
+	const int dw = config->getRenderWidth();
+	const int dh = config->getRenderHeight();
 	const int bh = dh / MENU_ROWS;
 	const int bw = dw / MENU_COLUMNS;
 
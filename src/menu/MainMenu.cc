@@ -37,17 +37,17 @@ bool MainMenu::Activate() {
 			backgroundMusic = nullptr;
 		}
 
-		const int dw = config->getDisplayWidth();
-		const int dh = config->getDisplayHeight();
+		const int dw = config->getRenderWidth();
+		const int dh = config->getRenderHeight();
 		const int bh = dh / MENU_ROWS;
 		const int menuA = config->getMenuFocusAlpha();
 		const int menuNA = config->getMenuNonFocusAlpha();
 		// Set the height of the version string to be 10, or half of brick height.
 		const int vh = (bh / 2) > 10 ? 10 : (bh / 2);
 
-		TTF_Font* fontTitle = TTF_OpenFont(config->locateResource(*(game->getFontBold())).c_str(), (bh * game->getTitleSizeRatio()));
-		TTF_Font* font = TTF_OpenFont(config->locateResource(*(game->getFont())).c_str(), bh);
-		TTF_Font* fontVersion = TTF_OpenFont(config->locateResource(*(game->getFont())).c_str(), vh);
+		TTF_Font* fontTitle = display->getFontCache()->getFont(config->locateResource(*(game->getFontBold())), (bh * game->getTitleSizeRatio()));
+		TTF_Font* font = display->getFontCache()->getFont(config->locateResource(*(game->getFont())), bh);
+		TTF_Font* fontVersion = display->getFontCache()->getFont(config->locateResource(*(game->getFont())), vh);
 
 		widgets = new std::vector<IUIWidget*>();
 
@@ -66,6 +66,9 @@ bool MainMenu::Activate() {
 			text->loadFromColour(renderer, Texture::getColour(), bh, bh);
 		}
 		cursor = new UICursor(text, dw, dh);
+		if (!config->isSoftwareCursor()) {
+			cursor->setHardwareCursor(renderer, config->locateResource(*(game->getCursor())), bh);
+		}
 
 		// Title.
 		std::string* name = game->getGameName();
@@ -130,27 +133,15 @@ bool MainMenu::Activate() {
 		widget->setXY(dw - (widget->getWidth() + 1), dh - (widget->getHeight() + 1));
 		widgets->push_back(widget);
 
-
-		// Free the font.
-		TTF_CloseFont(font);
-		TTF_CloseFont(fontTitle);
-		TTF_CloseFont(fontVersion);
-
-		// Set the mouse to be hidden since we are drawing it ourselves.
-		SDL_ShowCursor(SDL_DISABLE);
-
 		// Setup the music.
 		if (game->getTitleMusic() != nullptr) {
-			backgroundMusic = Mix_LoadMUS(config->locateResource(*(game->getTitleMusic())).c_str());
+			backgroundMusic = display->getMusicCache()->load(config->locateResource(*(game->getTitleMusic())));
 			if (backgroundMusic == nullptr) {
 				g_info("%s[%d] Could not load background music! SDL_Mixer Error: %s", __FILE__, __LINE__, Mix_GetError());
 			}
 			// Start music.
 			if (backgroundMusic != nullptr) {
-				if (Mix_PlayingMusic() != 0) {
-					Mix_HaltMusic();
-				}
-				Mix_PlayMusic(backgroundMusic, -1);
+				display->getMusicCache()->play(backgroundMusic, -1);
 			}
 			// Set the music volume
 			Mix_VolumeMusic(config->getMusicVolume());
@@ -170,7 +161,7 @@ void MainMenu::event(IUIWidget * widget) {
 
 		// stop the audio.
 		reactivateRequired = true;
-		Mix_HaltMusic();
+		display->getMusicCache()->halt();
 		return;
 	}
 
@@ -206,7 +197,7 @@ void MainMenu::event(IUIWidget * widget) {
 		runstate = EXIT_TRUE;
 		g_info("%s[%d]: Exit game", __FILE__, __LINE__);
 		// Stop music...
-		Mix_HaltMusic();
+		display->getMusicCache()->halt();
 		if (backgroundMusic != nullptr) {
 			Mix_FreeMusic(backgroundMusic);
 			backgroundMusic = nullptr;
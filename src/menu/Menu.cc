@@ -26,8 +26,7 @@ config(config), game(game), display(display) {
     cursor = nullptr;
     runstate = CONTINUE;
     reactivateRequired = false;
-    timeElapsed = SDL_GetTicks();
-    pxPerSec = config->getDisplayWidth() * 2;
+    pxPerSec = config->getRenderWidth() * 2;
 }
 
 Menu::~Menu() {
@@ -35,7 +34,8 @@ Menu::~Menu() {
 }
 
 bool Menu::Run() {
-    timeElapsed = SDL_GetTicks();
+    FrameClock* clock = display->getFrameClock();
+    clock->resume();
 
     //Main loop flag
     runstate = CONTINUE;
@@ -58,11 +58,16 @@ bool Menu::Run() {
     //Event handler
     SDL_Event e;
     int numWidgets = widgets->size();
+    cursor->setVisible(true);
     //While application is running
     while (runstate == CONTINUE) {
+        // A frame is rendered unless the only events were pointer motion the frame would not show.
+        bool polled = false;
+        bool redraw = false;
 
         //Handle events on queue
         while (SDL_PollEvent(&e) != 0) {
+            polled = true;
             //User requests quit
             if (e.type == SDL_QUIT) {
                 runstate = EXIT_TRUE;
@@ -72,17 +77,27 @@ bool Menu::Run() {
             if (e.type == SDL_KEYDOWN) {
                 if ((e.key.repeat == 0) && (e.key.keysym.sym == SDLK_F12)) {
                     display->screenshot();
+                } else if ((e.key.repeat == 0) && (e.key.keysym.sym == SDLK_F10)) {
+                    display->toggleStats();
                 }
             }
-            // Process Event
+            // Process Event, (mouse motion with the hardware cursor and no button held only needs a
+            // frame if it changes the focused widget).
+            const bool motion = (e.type == SDL_MOUSEMOTION) && (e.motion.state == 0) && cursor->isHardware();
+            IUIWidget* focused = motion ? getFocused(widgets) : nullptr;
             processEvent(determineEvent(&e), widgets, &e);
+            if (!motion || (getFocused(widgets) != focused)) {
+                redraw = true;
+            }
         }
         // Handle cursor velocity based movement
-        uint32_t time = SDL_GetTicks();
-        if (cursor->move((time - timeElapsed) / 1000.0f)) {
+        if (cursor->move(clock->getDelta())) {
             processEvent(cursor->locationEvent(), widgets, nullptr);
+            redraw = true;
+        }
+        if (polled && !redraw) {
+            continue;
         }
-        timeElapsed = time;
 
         //Clear screen
         display->clear();
@@ -95,6 +110,8 @@ bool Menu::Run() {
         cursor->render(renderer);
         display->render();
     }
+    // Hidden while a level is played, (the next menu shows its own).
+    cursor->setVisible(false);
     return runstate == EXIT_TRUE;
 }
 
@@ -152,18 +169,21 @@ Event Menu::determineEvent(SDL_Event* e) {
     int dz = config->getControllerDeadZone();
     switch (e->type) {
         case SDL_MOUSEMOTION:
-            //Get mouse position
-            SDL_GetMouseState(&event.x, &event.y);
+            //Get mouse position, (from the event, as SDL maps it to the logical size).
+            event.x = e->motion.x;
+            event.y = e->motion.y;
             event.event = CURSOR_MOVEMENT;
             break;
 
         case SDL_MOUSEBUTTONDOWN:
-            SDL_GetMouseState(&event.x, &event.y);
+            event.x = e->button.x;
+            event.y = e->button.y;
             event.event = CURSOR_ACTIVATE;
             break;
 
         case SDL_MOUSEBUTTONUP:
-            SDL_GetMouseState(&event.x, &event.y);
+            event.x = e->button.x;
+            event.y = e->button.y;
             event.event = CURSOR_RELEASE;
             break;
 
@@ -138,10 +138,6 @@ protected:
      * @brief Flag to indicate if the internal state is invalid and requires to be reactived.
      */
     bool reactivateRequired;
-    /**
-    * @brief The time elapsed since the last frame.
-    */
-    uint32_t timeElapsed;
     /**
      * The number of pixels to move per second.
      */
@@ -31,17 +31,17 @@ OptionsMenu::OptionsMenu(Configuration* config, GameConfiguration* game, Display
 
 bool OptionsMenu::Activate() {
 	if (widgets == nullptr) {
-		const int dh = config->getDisplayHeight();
-		const int dw = config->getDisplayWidth();
+		const int dh = config->getRenderHeight();
+		const int dw = config->getRenderWidth();
 		const int bh = dh / MENU_ROWS;
 		const int btnH = (bh * 3) / 4;
 		const int bw = dw / MENU_COLUMNS;
 		const int menuA = config->getMenuFocusAlpha();
 		const int menuNA = config->getMenuNonFocusAlpha();
 
-		TTF_Font* fontTitle = TTF_OpenFont(config->locateResource(*(game->getFontBold())).c_str(), bh);
-		TTF_Font* font = TTF_OpenFont(config->locateResource(*(game->getFont())).c_str(), bh);
-		TTF_Font* fontLabel = TTF_OpenFont(config->locateResource(*(game->getFont())).c_str(), bh * 2 / 3);
+		TTF_Font* fontTitle = display->getFontCache()->getFont(config->locateResource(*(game->getFontBold())), bh);
+		TTF_Font* font = display->getFontCache()->getFont(config->locateResource(*(game->getFont())), bh);
+		TTF_Font* fontLabel = display->getFontCache()->getFont(config->locateResource(*(game->getFont())), bh * 2 / 3);
 
 		widgets = new std::vector<IUIWidget*>();
 
@@ -176,19 +176,14 @@ bool OptionsMenu::Activate() {
 		btnReturn = new UIButton(text, (dw / 2) + (bh / 2), bh * (MENU_ROWS - 3), menuA, menuNA);
 		btnReturn->addEventListener(this);
 		widgets->push_back(btnReturn);
-
-		// Free the font.
-		TTF_CloseFont(font);
-		TTF_CloseFont(fontTitle);
-		TTF_CloseFont(fontLabel);
 	}
 	runstate = CONTINUE;
 	return true;
 }
 
 void OptionsMenu::newLabel(const std::string& text, TTF_Font *font, int x, int y) {
-	const int dh = config->getDisplayHeight();
-	const int dw = config->getDisplayWidth();
+	const int dh = config->getRenderHeight();
+	const int dw = config->getRenderWidth();
 	const int bh = dh / MENU_ROWS;
 	const int bw = dw / MENU_COLUMNS;
 
@@ -221,7 +216,7 @@ void OptionsMenu::event(IUIWidget *widget) {
 		config->setMusicVolume(volumeMusicControl->getValue());
 		// Update the display !
 		if (display->update(config)) {
-			// display changed, we need to deactivate main menu to rebuild...
+			// render size changed, we need to deactivate main menu to rebuild...
 			mainMenu->Reactivate();
 		}
 		// Exit
@@ -0,0 +1,415 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/*
+ * occillo-balance : Monte Carlo level balancing.
+ *
+ * Plays each level many times with the auto pilot, using the game's own
+ * simulation (Playfield) with no display, and reports how long levels take
+ * to clear, the scores reached and how often the ball is lost.
+ */
+
+#include "config.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <glib.h>
+#include <SDL.h>
+
+#include "Configuration.h"
+#include "GameConfiguration.h"
+#include "GameState.h"
+#include "LevelDefinition.h"
+#include "Playfield.h"
+#include "AutoPilot.h"
+#include "TextureRepository.h"
+#include "JobSystem.h"
+
+/**
+ * @brief The simulation time step in seconds.
+ */
+#define OCCILLO_BALANCE_STEP (1.0 / 120.0)
+
+/**
+ * @brief The outcome of a single simulated play of a level.
+ */
+struct SimulationResult {
+	/**
+	 * @brief TRUE if the level was cleared.
+	 */
+	bool cleared;
+	/**
+	 * @brief The simulated time in seconds the play lasted.
+	 */
+	double time;
+	/**
+	 * @brief The score at the end of the play.
+	 */
+	int score;
+	/**
+	 * @brief The number of balls lost.
+	 */
+	int ballsLost;
+};
+
+/**
+ * @brief The set of plays of a level, each run as a job.
+ */
+struct SimulationJob {
+	GameConfiguration* game;
+	LevelDefinition* level;
+	int width;
+	int height;
+	int lives;
+	double timeLimit;
+	double speedIncrease;
+	unsigned int seed;
+	int runs;
+	/**
+	 * @brief The brick textures, (sized, but empty, and only read by the runs).
+	 */
+	TextureRepository* textures;
+	/**
+	 * @brief The results, one per run.
+	 */
+	std::vector<SimulationResult> results;
+};
+
+/**
+ * @brief A single play of the level, (the data of one job).
+ */
+struct SimulationRun {
+	SimulationJob* job;
+	int run;
+};
+
+/**
+ * @brief Playfield listener that counts the balls lost, ignoring everything else.
+ */
+class SimulationListener : public IPlayfieldListener {
+  public:
+	SimulationListener() : ballsLost(0) {
+	}
+	void brickCollision(Brick* brick) {
+		UNUSED(brick);
+	}
+	void brickHit(Brick* brick) {
+		UNUSED(brick);
+	}
+	void bonusLife(Brick* brick) {
+		UNUSED(brick);
+	}
+	void paddleCollision() {
+	}
+	void ballLost() {
+		ballsLost++;
+	}
+	void ballBumped(int x, int y) {
+		UNUSED(x);
+		UNUSED(y);
+	}
+	/**
+	 * @brief The number of balls lost.
+	 */
+	int ballsLost;
+};
+
+/**
+ * @brief Play a single run of the level.
+ * @param job The job.
+ * @param textures The brick textures, (sized, but empty).
+ * @param run The run index.
+ */
+static void simulate(SimulationJob* job, TextureRepository* textures, int run) {
+	GameConfiguration* game = job->game;
+	const int brickWidth = job->width / game->getNumberBricksWide();
+	const int brickHeight = job->height / game->getNumberBricksHigh();
+	const unsigned int seed = job->seed + run;
+
+	GameState state;
+	state.addLives(job->lives);
+	state.setState(GAME_CONTINUE);
+
+	Texture* paddleTexture = new Texture();
+	paddleTexture->setEmptyTexture(brickWidth * game->getPaddleWidthRatio(), brickHeight * game->getPaddleHeightRatio());
+	Texture* ballTexture = new Texture();
+	ballTexture->setEmptyTexture(brickHeight * game->getBallSizeRatio(), brickHeight * game->getBallSizeRatio());
+
+	SimulationListener listener;
+	Playfield field(game, &state, job->width, job->height, seed);
+	field.setListener(&listener);
+	if (job->speedIncrease >= 0.0) {
+		field.setBrickHitSpeedIncreaseRatio(job->speedIncrease);
+	}
+	field.load(job->level, textures, paddleTexture, ballTexture, 0);
+	AutoPilot pilot(field.getBall(), field.getPaddle(), field.getBricks(), field.getBricksWidth(), field.getBricksHigh(), seed);
+
+	double time = 0.0;
+	while ((state.getState() == GAME_CONTINUE) && (state.getLives() > 0) && (time < job->timeLimit)) {
+		pilot.update(OCCILLO_BALANCE_STEP, field.isBallInPlay(), state.getScore());
+		if (!field.isBallInPlay() && pilot.serve()) {
+			field.serve();
+		}
+		if (pilot.bump()) {
+			field.bump();
+		}
+		field.update(OCCILLO_BALANCE_STEP, false);
+		time += OCCILLO_BALANCE_STEP;
+	}
+
+	SimulationResult& result = job->results[run];
+	result.cleared = (state.getState() == NEXT_LEVEL);
+	result.time = time;
+	result.score = state.getScore();
+	result.ballsLost = listener.ballsLost;
+}
+
+/**
+ * @brief Job entry, plays a single run.
+ * @param data The SimulationRun.
+ */
+static void simulationWorker(void* data) {
+	SimulationRun* run = (SimulationRun*) data;
+	simulate(run->job, run->job->textures, run->run);
+}
+
+/**
+ * @brief Get the value at the given percentile of the sorted values.
+ * @param values The sorted values.
+ * @param p The percentile (0.0 - 1.0).
+ * @return The value.
+ */
+static double percentile(const std::vector<double>& values, double p) {
+	if (values.empty()) {
+		return 0.0;
+	}
+	return values[(size_t) ((values.size() - 1) * p + 0.5)];
+}
+
+/**
+ * @brief Get the mean of the values.
+ * @param values The values.
+ * @return The mean.
+ */
+static double mean(const std::vector<double>& values) {
+	if (values.empty()) {
+		return 0.0;
+	}
+	double total = 0.0;
+	for (double v : values) {
+		total += v;
+	}
+	return total / values.size();
+}
+
+/**
+ * @brief Print a distribution summary line.
+ * @param label The label for the line.
+ * @param values The values, (will be sorted).
+ */
+static void printDistribution(const char* label, std::vector<double>& values) {
+	std::sort(values.begin(), values.end());
+	printf("  %-16s min %9.1f  p10 %9.1f  p50 %9.1f  p90 %9.1f  max %9.1f  mean %9.1f\n", label,
+	       percentile(values, 0.0), percentile(values, 0.1), percentile(values, 0.5),
+	       percentile(values, 0.9), percentile(values, 1.0), mean(values));
+}
+
+/*
+ * Command line options.
+ */
+static gint optRuns = 1000;
+static gint optThreads = 0;
+static gint optSeed = -1;
+static gint optWidth = 1280;
+static gint optHeight = 720;
+static gint optLives = -1;
+static gdouble optTimeLimit = 600.0;
+static gint optBonusProbability = -1;
+static gchar* optBonusProbabilities = nullptr;
+static gdouble optInitialSpeed = -1.0;
+static gdouble optSpeedIncrease = -1.0;
+static gchar* optGame = nullptr;
+static gchar* optData = nullptr;
+static gboolean optCSV = FALSE;
+static gchar** optLevels = nullptr;
+
+static GOptionEntry entries[] = {
+	{ "runs", 'r', 0, G_OPTION_ARG_INT, &optRuns, "Number of plays per level (default 1000)", "N" },
+	{ "threads", 'j', 0, G_OPTION_ARG_INT, &optThreads, "Number of worker threads (default all cores)", "N" },
+	{ "seed", 's', 0, G_OPTION_ARG_INT, &optSeed, "Random seed (default time)", "N" },
+	{ "width", 'W', 0, G_OPTION_ARG_INT, &optWidth, "Width of the field of play (default 1280)", "PX" },
+	{ "height", 'H', 0, G_OPTION_ARG_INT, &optHeight, "Height of the field of play (default 720)", "PX" },
+	{ "lives", 'l', 0, G_OPTION_ARG_INT, &optLives, "Lives per play (default game initial lives)", "N" },
+	{ "time-limit", 't', 0, G_OPTION_ARG_DOUBLE, &optTimeLimit, "Maximum simulated seconds per play (default 600)", "SECS" },
+	{ "bonus-probability", 0, 0, G_OPTION_ARG_INT, &optBonusProbability, "Override the level bonus probability", "N" },
+	{ "bonus-probabilities", 0, 0, G_OPTION_ARG_STRING, &optBonusProbabilities, "Override the level bonus probabilities", "N,N,N,N,N,N" },
+	{ "initial-speed", 0, 0, G_OPTION_ARG_DOUBLE, &optInitialSpeed, "Override the level initial speed", "RATIO" },
+	{ "speed-increase", 0, 0, G_OPTION_ARG_DOUBLE, &optSpeedIncrease, "Override the brick hit speed increase ratio", "RATIO" },
+	{ "game", 'g', 0, G_OPTION_ARG_FILENAME, &optGame, "Game definition file (default game/game.ini)", "FILE" },
+	{ "data", 'd', 0, G_OPTION_ARG_FILENAME, &optData, "Data directory", "DIR" },
+	{ "csv", 'c', 0, G_OPTION_ARG_NONE, &optCSV, "Output as CSV", nullptr },
+	{ G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &optLevels, nullptr, "[LEVEL...]" },
+	{ nullptr, 0, 0, G_OPTION_ARG_NONE, nullptr, nullptr, nullptr }
+};
+
+int main(int argc, char* argv[]) {
+	GError* error = nullptr;
+	GOptionContext* context = g_option_context_new("[LEVEL...] - Occillo level balancing");
+	g_option_context_set_summary(context, "Simulates plays of each level (default all levels in the game definition) "
+	                             "with the auto pilot and reports clear times, scores and ball losses.");
+	g_option_context_add_main_entries(context, entries, nullptr);
+	if (!g_option_context_parse(context, &argc, &argv, &error)) {
+		g_printerr("%s\n", error->message);
+		g_error_free(error);
+		g_option_context_free(context);
+		return EXIT_FAILURE;
+	}
+	g_option_context_free(context);
+	if ((optRuns <= 0) || (optWidth <= 0) || (optHeight <= 0)) {
+		g_printerr("Invalid runs or playfield size\n");
+		return EXIT_FAILURE;
+	}
+
+	Configuration config;
+	if (optData != nullptr) {
+		config.setDataPath(optData);
+	}
+	std::string gameFile = config.locateResource(optGame != nullptr ? optGame : *(config.getGameConfiguration()));
+	GameConfiguration game;
+	if (gameFile.empty() || !game.load(gameFile)) {
+		g_printerr("Unable to load game definition %s\n", gameFile.c_str());
+		return EXIT_FAILURE;
+	}
+
+	std::vector<std::string> levels;
+	if (optLevels != nullptr) {
+		for (int i = 0; optLevels[i] != nullptr; i++) {
+			levels.push_back(optLevels[i]);
+		}
+	} else {
+		levels = *(game.getLevels());
+	}
+
+	const int threads = (optThreads > 0) ? optThreads : SDL_GetCPUCount();
+	// The main thread runs jobs while it waits, so is one of the threads.
+	if (threads > 1) {
+		JobSystem::init(threads - 1);
+	}
+	const unsigned int seed = (optSeed >= 0) ? optSeed : (unsigned int) std::time(nullptr);
+	const int lives = (optLives > 0) ? optLives : game.getInitialLives();
+
+	if (optCSV) {
+		printf("level,runs,cleared,time_p10,time_p50,time_p90,time_mean,score_p10,score_p50,score_p90,score_mean,"
+		       "balls_lost_per_run,balls_lost_per_minute\n");
+	} else {
+		printf("Seed %u, %d runs per level, %d threads, %dx%d, %d lives\n", seed, optRuns, threads, optWidth, optHeight, lives);
+	}
+
+	for (const std::string& path : levels) {
+		LevelDefinition level(game.getNumberBricksWide(), game.getNumberBricksHigh());
+		if (!level.loadFromFile(config.locateResource(path))) {
+			g_printerr("Unable to load level %s\n", path.c_str());
+			continue;
+		}
+		if (optBonusProbability >= 0) {
+			level.setBonusProbability(optBonusProbability);
+		}
+		if (optBonusProbabilities != nullptr) {
+			gchar** values = g_strsplit(optBonusProbabilities, ",", OCCILLO_LEVEL_BONUS_COUNT);
+			for (int i = 0; (values[i] != nullptr) && (i < OCCILLO_LEVEL_BONUS_COUNT); i++) {
+				level.getBonusProbabilities()[i] = atoi(values[i]);
+			}
+			g_strfreev(values);
+		}
+		if (optInitialSpeed >= 0.0) {
+			level.setInitialSpeed(optInitialSpeed);
+		}
+
+		SimulationJob job;
+		job.game = &game;
+		job.level = &level;
+		job.width = optWidth;
+		job.height = optHeight;
+		job.lives = lives;
+		job.timeLimit = optTimeLimit;
+		job.speedIncrease = optSpeedIncrease;
+		job.seed = seed;
+		job.runs = optRuns;
+		job.results.resize(optRuns);
+
+		// Bricks only need the size of their texture.
+		const int brickWidth = optWidth / game.getNumberBricksWide();
+		const int brickHeight = optHeight / game.getNumberBricksHigh();
+		const int count = level.getTextures()->size();
+		TextureRepository textures(count);
+		for (int i = 1; i < count; i++) {
+			Texture* t = new Texture();
+			t->setEmptyTexture(brickWidth, brickHeight);
+			textures.add(i, t);
+		}
+		job.textures = &textures;
+
+		Uint32 start = SDL_GetTicks();
+		std::vector<SimulationRun> runs(optRuns);
+		JobGroup group;
+		for (int i = 0; i < optRuns; i++) {
+			runs[i] = { &job, i };
+			JobSystem::submit(&group, simulationWorker, &runs[i], "balance");
+		}
+		JobSystem::wait(&group);
+		Uint32 duration = SDL_GetTicks() - start;
+
+		// Gather the results.
+		std::vector<double> clearTimes;
+		std::vector<double> scores;
+		double totalTime = 0.0;
+		int ballsLost = 0;
+		for (const SimulationResult& result : job.results) {
+			if (result.cleared) {
+				clearTimes.push_back(result.time);
+			}
+			scores.push_back(result.score);
+			totalTime += result.time;
+			ballsLost += result.ballsLost;
+		}
+		const double cleared = (optRuns > 0) ? (double) clearTimes.size() / optRuns : 0.0;
+		const double lossPerRun = (optRuns > 0) ? (double) ballsLost / optRuns : 0.0;
+		const double lossPerMinute = (totalTime > 0.0) ? ballsLost / (totalTime / 60.0) : 0.0;
+
+		if (optCSV) {
+			std::sort(clearTimes.begin(), clearTimes.end());
+			std::sort(scores.begin(), scores.end());
+			printf("%s,%d,%.3f,%.1f,%.1f,%.1f,%.1f,%.0f,%.0f,%.0f,%.0f,%.3f,%.3f\n", path.c_str(), optRuns, cleared,
+			       percentile(clearTimes, 0.1), percentile(clearTimes, 0.5), percentile(clearTimes, 0.9), mean(clearTimes),
+			       percentile(scores, 0.1), percentile(scores, 0.5), percentile(scores, 0.9), mean(scores),
+			       lossPerRun, lossPerMinute);
+		} else {
+			printf("\n%s : %s (%.1f secs)\n", path.c_str(), level.getName().c_str(), duration / 1000.0);
+			printf("  cleared %5.1f%%, balls lost %.2f per play, %.2f per minute\n", cleared * 100.0, lossPerRun, lossPerMinute);
+			printDistribution("clear time (s)", clearTimes);
+			printDistribution("score", scores);
+		}
+		fflush(stdout);
+	}
+	JobSystem::shutdown();
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,135 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/*
+ * occillo-pack : Resource pack builder.
+ *
+ * Collects the game resources under the data directory into a single
+ * indexed file, (see ResourcePack), which the game maps at startup in place
+ * of opening each file.
+ */
+
+#include "config.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <glib.h>
+
+#include "ResourcePack.h"
+
+/**
+ * @brief The resource directories packed when none are given.
+ */
+static const char* defaultDirectories[] = { "images", "sounds", "music", "fonts", "game", nullptr };
+
+static gchar* optData = nullptr;
+static gchar* optOutput = nullptr;
+static gboolean optVerbose = FALSE;
+static gchar** optDirectories = nullptr;
+
+static GOptionEntry entries[] = {
+	{ "data", 'd', 0, G_OPTION_ARG_FILENAME, &optData, "Data directory (default current directory)", "DIR" },
+	{ "output", 'o', 0, G_OPTION_ARG_FILENAME, &optOutput, "Pack file (default DIR/" OCCILLO_RESOURCEPACK_FILE ")", "FILE" },
+	{ "verbose", 'v', 0, G_OPTION_ARG_NONE, &optVerbose, "List the packed resources", nullptr },
+	{ G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &optDirectories, nullptr, "[DIRECTORY...]" },
+	{ nullptr, 0, 0, G_OPTION_ARG_NONE, nullptr, nullptr, nullptr }
+};
+
+/**
+ * @brief Add the files under the given directory, (recursively, skipping hidden and build files).
+ * @param base The data directory.
+ * @param directory The directory, relative to the data directory.
+ * @param resources The list to add the resource names to.
+ */
+static void addDirectory(const std::string& base, const std::string& directory, std::vector<std::string>& resources) {
+	std::string path = base + G_DIR_SEPARATOR_S + directory;
+	GDir* dir = g_dir_open(path.c_str(), 0, nullptr);
+	if (dir == nullptr) {
+		g_printerr("Skipping missing directory %s\n", path.c_str());
+		return;
+	}
+	const gchar* name;
+	while ((name = g_dir_read_name(dir)) != nullptr) {
+		if ((name[0] == '.') || g_str_has_prefix(name, "Makefile")) {
+			// Hidden files and the build files of a source tree are not resources.
+			continue;
+		}
+		// Resource names always use '/', as in the game files.
+		std::string resource = directory + "/" + name;
+		std::string file = base + G_DIR_SEPARATOR_S + resource;
+		if (g_file_test(file.c_str(), G_FILE_TEST_IS_DIR)) {
+			addDirectory(base, resource, resources);
+		} else if (g_file_test(file.c_str(), G_FILE_TEST_IS_REGULAR)) {
+			resources.push_back(resource);
+		}
+	}
+	g_dir_close(dir);
+}
+
+int main(int argc, char* argv[]) {
+	GError* error = nullptr;
+	GOptionContext* context = g_option_context_new("[DIRECTORY...] - Occillo resource pack builder");
+	g_option_context_set_summary(context, "Packs the files under each directory of the data directory "
+	                             "(default images, sounds, music, fonts and game) into a single resource pack.");
+	g_option_context_add_main_entries(context, entries, nullptr);
+	if (!g_option_context_parse(context, &argc, &argv, &error)) {
+		g_printerr("%s\n", error->message);
+		g_error_free(error);
+		g_option_context_free(context);
+		return EXIT_FAILURE;
+	}
+	g_option_context_free(context);
+
+	std::string base = (optData != nullptr) ? optData : ".";
+	std::string output = (optOutput != nullptr) ? optOutput : base + G_DIR_SEPARATOR_S OCCILLO_RESOURCEPACK_FILE;
+	std::vector<std::string> resources;
+	if (optDirectories != nullptr) {
+		for (int i = 0; optDirectories[i] != nullptr; i++) {
+			addDirectory(base, optDirectories[i], resources);
+		}
+	} else {
+		for (int i = 0; defaultDirectories[i] != nullptr; i++) {
+			addDirectory(base, defaultDirectories[i], resources);
+		}
+	}
+	std::sort(resources.begin(), resources.end());
+	if (resources.empty()) {
+		g_printerr("No resources found under %s\n", base.c_str());
+		return EXIT_FAILURE;
+	}
+	if (optVerbose) {
+		for (const std::string& resource : resources) {
+			printf("%s\n", resource.c_str());
+		}
+	}
+	if (!ResourcePack::write(output, base, resources)) {
+		g_printerr("Unable to write %s\n", output.c_str());
+		return EXIT_FAILURE;
+	}
+	// Check the pack reads back.
+	if (!ResourcePack::open(output)) {
+		g_printerr("Unable to read back %s\n", output.c_str());
+		return EXIT_FAILURE;
+	}
+	ResourcePack::close();
+	printf("%s : %u resources\n", output.c_str(), (unsigned int) resources.size());
+	return EXIT_SUCCESS;
+}
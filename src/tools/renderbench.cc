@@ -0,0 +1,365 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/*
+ * occillo-renderbench : Offscreen render throughput.
+ *
+ * Renders the parts of a level frame (background, brick grid, brick fragment
+ * and text fade animations) with the SDL software renderer into an offscreen
+ * surface, and reports the frame time and draw call throughput of each. The
+ * dummy video driver is used, so no display or GPU is needed.
+ */
+
+#include "config.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <glib.h>
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+
+#include "Configuration.h"
+#include "GameConfiguration.h"
+#include "LevelDefinition.h"
+#include "TextureRepository.h"
+#include "FontCache.h"
+#include "FrameClock.h"
+#include "FrameStats.h"
+#include "WorkCounters.h"
+#include "BrickDestructionAnimation.h"
+#include "TextureFadeAnimation.h"
+
+/**
+ * @brief The frame clock step in milliseconds, (animations advance as if running at 60 fps).
+ */
+#define OCCILLO_RENDERBENCH_STEP (1000.0 / 60.0)
+
+/**
+ * @brief The number of frames rendered before each scene is measured.
+ */
+#define OCCILLO_RENDERBENCH_WARMUP 10
+
+/**
+ * @brief The scenes measured, each a part of a level frame, (and the whole).
+ */
+enum BenchScene {
+	SCENE_CLEAR,        /**< Clear and present only, (the baseline). */
+	SCENE_BACKGROUND,   /**< The background blit. */
+	SCENE_BRICKS,       /**< Every cell of the brick grid. */
+	SCENE_FRAGMENTS,    /**< The brick destruction animations. */
+	SCENE_FADES,        /**< The text fade animations. */
+	SCENE_LEVEL,        /**< All of the above. */
+	SCENE_COUNT         /**< The number of scenes. */
+};
+
+/**
+ * @brief The scene names, indexed by BenchScene.
+ */
+static const char* sceneNames[SCENE_COUNT] = {
+	"clear",
+	"background",
+	"bricks",
+	"fragments",
+	"fades",
+	"level"
+};
+
+/**
+ * @brief The textures and animations drawn by the scenes.
+ */
+struct BenchState {
+	SDL_Renderer* renderer;
+	FrameClock clock;
+	int brickWidth;
+	int brickHeight;
+	int bricksWide;
+	int bricksHigh;
+	/**
+	 * @brief The level textures, (texture 0 is the background).
+	 */
+	TextureRepository* textures;
+	/**
+	 * @brief The brick texture of each cell, (every cell is filled).
+	 */
+	std::vector<Texture*> grid;
+	/**
+	 * @brief The brick destruction animations.
+	 */
+	std::vector<GameAnimation*> fragments;
+	/**
+	 * @brief The text fade animations, (each owns its texture).
+	 */
+	std::vector<GameAnimation*> fades;
+};
+
+/**
+ * @brief Render the animations, restarting any that are complete so the count stays constant.
+ * @param state The bench state.
+ * @param animations The animations.
+ */
+static void renderAnimations(BenchState& state, std::vector<GameAnimation*>& animations) {
+	for (GameAnimation* animation : animations) {
+		if (animation->isComplete(state.clock)) {
+			animation->reset(state.clock);
+		}
+		animation->render(state.renderer, state.clock);
+	}
+}
+
+/**
+ * @brief Render a single frame of the scene.
+ * @param state The bench state.
+ * @param scene The scene.
+ */
+static void renderScene(BenchState& state, BenchScene scene) {
+	state.clock.tick();
+	Texture::setClock(state.clock.getTime());
+	SDL_SetRenderDrawColor(state.renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+	SDL_RenderClear(state.renderer);
+	if ((scene == SCENE_BACKGROUND) || (scene == SCENE_LEVEL)) {
+		state.textures->get(0)->render(state.renderer, 0, 0);
+	}
+	if ((scene == SCENE_BRICKS) || (scene == SCENE_LEVEL)) {
+		for (int i = 0; i < state.bricksHigh; i++) {
+			for (int j = 0; j < state.bricksWide; j++) {
+				state.grid[i * state.bricksWide + j]->render(state.renderer, j * state.brickWidth, i * state.brickHeight);
+			}
+		}
+	}
+	if ((scene == SCENE_FRAGMENTS) || (scene == SCENE_LEVEL)) {
+		renderAnimations(state, state.fragments);
+	}
+	if ((scene == SCENE_FADES) || (scene == SCENE_LEVEL)) {
+		renderAnimations(state, state.fades);
+	}
+	// Present flushes the batched draws through the software renderer.
+	SDL_RenderPresent(state.renderer);
+}
+
+/*
+ * Command line options.
+ */
+static gint optFrames = 300;
+static gint optCount = 64;
+static gint optWidth = 1280;
+static gint optHeight = 720;
+static gchar* optGame = nullptr;
+static gchar* optData = nullptr;
+static gchar* optLevel = nullptr;
+static gboolean optCSV = FALSE;
+
+static GOptionEntry entries[] = {
+	{ "frames", 'f', 0, G_OPTION_ARG_INT, &optFrames, "Number of frames to measure per scene (default 300)", "N" },
+	{ "count", 'n', 0, G_OPTION_ARG_INT, &optCount, "Number of each animation kept running (default 64)", "N" },
+	{ "width", 'W', 0, G_OPTION_ARG_INT, &optWidth, "Width of the offscreen surface (default 1280)", "PX" },
+	{ "height", 'H', 0, G_OPTION_ARG_INT, &optHeight, "Height of the offscreen surface (default 720)", "PX" },
+	{ "level", 'l', 0, G_OPTION_ARG_FILENAME, &optLevel, "Level providing the textures (default first level)", "FILE" },
+	{ "game", 'g', 0, G_OPTION_ARG_FILENAME, &optGame, "Game definition file (default game/game.ini)", "FILE" },
+	{ "data", 'd', 0, G_OPTION_ARG_FILENAME, &optData, "Data directory", "DIR" },
+	{ "csv", 'c', 0, G_OPTION_ARG_NONE, &optCSV, "Output as CSV", nullptr },
+	{ nullptr, 0, 0, G_OPTION_ARG_NONE, nullptr, nullptr, nullptr }
+};
+
+int main(int argc, char* argv[]) {
+	GError* error = nullptr;
+	GOptionContext* context = g_option_context_new("- Occillo offscreen render benchmark");
+	g_option_context_set_summary(context, "Renders the background, brick grid and animations of a level with the "
+	                             "software renderer into an offscreen surface and reports the throughput of each.");
+	g_option_context_add_main_entries(context, entries, nullptr);
+	if (!g_option_context_parse(context, &argc, &argv, &error)) {
+		g_printerr("%s\n", error->message);
+		g_error_free(error);
+		g_option_context_free(context);
+		return EXIT_FAILURE;
+	}
+	g_option_context_free(context);
+	if ((optFrames <= 0) || (optCount < 0) || (optWidth <= 0) || (optHeight <= 0)) {
+		g_printerr("Invalid frames, count or surface size\n");
+		return EXIT_FAILURE;
+	}
+
+	Configuration config;
+	if (optData != nullptr) {
+		config.setDataPath(optData);
+	}
+	std::string gameFile = config.locateResource(optGame != nullptr ? optGame : *(config.getGameConfiguration()));
+	GameConfiguration game;
+	if (gameFile.empty() || !game.load(gameFile)) {
+		g_printerr("Unable to load game definition %s\n", gameFile.c_str());
+		return EXIT_FAILURE;
+	}
+	std::string levelFile;
+	if (optLevel != nullptr) {
+		levelFile = optLevel;
+	} else if (!game.getLevels()->empty()) {
+		levelFile = game.getLevels()->front();
+	}
+	LevelDefinition level(game.getNumberBricksWide(), game.getNumberBricksHigh());
+	if (levelFile.empty() || !level.loadFromFile(config.locateResource(levelFile))) {
+		g_printerr("Unable to load level %s\n", levelFile.c_str());
+		return EXIT_FAILURE;
+	}
+
+	// The software renderer needs no video device, the dummy driver keeps SDL off the display,
+	// (unless overridden by SDL_VIDEODRIVER). Must be set before SDL is initialised.
+	g_setenv("SDL_VIDEODRIVER", "dummy", FALSE);
+	if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+		g_printerr("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		return EXIT_FAILURE;
+	}
+	if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) || (TTF_Init() == -1)) {
+		g_printerr("SDL_image or SDL_ttf could not initialize! %s\n", SDL_GetError());
+		SDL_Quit();
+		return EXIT_FAILURE;
+	}
+	SDL_Surface* surface = SDL_CreateRGBSurface(0, optWidth, optHeight, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+	SDL_Renderer* renderer = (surface != nullptr) ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+	if (renderer == nullptr) {
+		g_printerr("Unable to create the software renderer! SDL Error: %s\n", SDL_GetError());
+		SDL_FreeSurface(surface);
+		TTF_Quit();
+		IMG_Quit();
+		SDL_Quit();
+		return EXIT_FAILURE;
+	}
+	Texture::setDefaultAnimation(game.getAnimationRate(), Texture::parseAnimationMode(*(game.getAnimationMode())));
+
+	BenchState state;
+	state.renderer = renderer;
+	state.clock.setFixedStep(OCCILLO_RENDERBENCH_STEP);
+	state.bricksWide = game.getNumberBricksWide();
+	state.bricksHigh = game.getNumberBricksHigh();
+	state.brickWidth = optWidth / state.bricksWide;
+	state.brickHeight = optHeight / state.bricksHigh;
+
+	// Level textures, as loaded by the level.
+	std::vector<std::string>* names = level.getTextures();
+	const int textureCount = names->size();
+	state.textures = new TextureRepository(textureCount);
+	for (int i = 0; i < textureCount; i++) {
+		const std::string path = config.locateResource((*names)[i]);
+		const bool loaded = (i == 0) ? state.textures->add(i, renderer, path, optWidth, optHeight)
+		                    : state.textures->add(i, renderer, path, state.brickWidth, state.brickHeight);
+		if (!loaded) {
+			g_info("%s[%d] : Failed to load texture %d name: %s, setting as missing texture.", __FILE__, __LINE__, i, path.c_str());
+			Texture* t = new Texture();
+			if (i == 0) {
+				t->loadFromColour(renderer, Texture::getColour(), optWidth, optHeight);
+			} else {
+				t->loadFromColour(renderer, Texture::getColour(), state.brickWidth, state.brickHeight);
+			}
+			state.textures->add(i, t);
+		}
+	}
+
+	// Fill every cell, using the level's brick where there is one and cycling the brick textures elsewhere.
+	const int cells = state.bricksWide * state.bricksHigh;
+	for (int i = 0; i < state.bricksHigh; i++) {
+		for (int j = 0; j < state.bricksWide; j++) {
+			int index = level.getTexture(i, j);
+			if ((index == 0) || (index >= textureCount)) {
+				index = (textureCount > 1) ? (((i * state.bricksWide + j) % (textureCount - 1)) + 1) : 0;
+			}
+			state.grid.push_back(state.textures->get(index));
+		}
+	}
+
+	// Animations, spread over the grid, (a stride coprime to most grid sizes scatters them).
+	FontCache fonts;
+	const int bonusSize = state.brickHeight * game.getFontSizeRatio();
+	const std::string fontBold = config.locateResource(*(game.getFontBold()));
+	TTF_Font* fontBonus = fonts.getFont(fontBold, bonusSize);
+	TTF_Font* fontBonusOutline = fonts.getFont(fontBold, bonusSize, OCCILLO_OUTLINE_SIZE);
+	for (int i = 0; i < optCount; i++) {
+		const int cell = (i * 7) % cells;
+		const int x = (cell % state.bricksWide) * state.brickWidth;
+		const int y = (cell / state.bricksWide) * state.brickHeight;
+		state.fragments.push_back(new BrickDestructionAnimation(state.clock, state.grid[cell], x, y,
+		                          game.getBrickDestroyTime(), state.brickWidth));
+
+		Texture* text = new Texture();
+		if ((fontBonus == nullptr) || (fontBonusOutline == nullptr)
+		        || !text->loadFromText(renderer, std::to_string((i + 1) * 100), fontBonus, fontBonusOutline,
+		                               game.getFontColour(), game.getTitleFontColour())) {
+			text->loadFromColour(renderer, Texture::getColour(), 16, 16);
+		}
+		text->setBlendMode(SDL_BLENDMODE_BLEND);
+		state.fades.push_back(new TextureFadeAnimation(state.clock, text, x, y, game.getBonusScoreFadeTime(),
+		                      state.brickHeight));
+	}
+
+	if (optCSV) {
+		printf("scene,frames,draws_per_frame,mean_ms,p50_ms,p95_ms,max_ms,fps,draws_per_sec,us_per_draw\n");
+	} else {
+		printf("%s, %dx%d software renderer, %d frames per scene, %d animations of each kind\n",
+		       levelFile.c_str(), optWidth, optHeight, optFrames, optCount);
+		printf("%-12s %8s %9s %9s %9s %9s %9s %12s %10s\n", "scene", "draws/f", "mean ms", "p50 ms", "p95 ms",
+		       "max ms", "fps", "draws/sec", "us/draw");
+	}
+
+	WorkCounters::setEnabled(true);
+	for (int s = 0; s < SCENE_COUNT; s++) {
+		const BenchScene scene = (BenchScene) s;
+		for (int i = 0; i < OCCILLO_RENDERBENCH_WARMUP; i++) {
+			renderScene(state, scene);
+		}
+		FrameStats stats;
+		stats.setFrameLimit(optFrames);
+		const unsigned int draws = WorkCounters::getTotal(WORK_DRAW_CALLS);
+		// The first frame only marks the start.
+		stats.frame();
+		do {
+			renderScene(state, scene);
+		} while (!stats.frame());
+
+		const double drawsPerFrame = (double)(WorkCounters::getTotal(WORK_DRAW_CALLS) - draws) / optFrames;
+		const double meanMs = stats.getMeanFrameTime();
+		const double fps = (meanMs > 0.0) ? 1000.0 / meanMs : 0.0;
+		const double drawsPerSec = drawsPerFrame * fps;
+		const double usPerDraw = (drawsPerFrame > 0.0) ? meanMs * 1000.0 / drawsPerFrame : 0.0;
+		if (optCSV) {
+			printf("%s,%d,%.1f,%.3f,%.3f,%.3f,%.3f,%.1f,%.0f,%.3f\n", sceneNames[scene], optFrames, drawsPerFrame,
+			       meanMs, stats.getFrameTime(0.5), stats.getFrameTime(0.95), stats.getFrameTime(1.0), fps,
+			       drawsPerSec, usPerDraw);
+		} else {
+			printf("%-12s %8.1f %9.3f %9.3f %9.3f %9.3f %9.1f %12.0f %10.3f\n", sceneNames[scene], drawsPerFrame,
+			       meanMs, stats.getFrameTime(0.5), stats.getFrameTime(0.95), stats.getFrameTime(1.0), fps,
+			       drawsPerSec, usPerDraw);
+		}
+		fflush(stdout);
+	}
+	WorkCounters::setEnabled(false);
+
+	for (GameAnimation* animation : state.fragments) {
+		delete animation;
+	}
+	for (GameAnimation* animation : state.fades) {
+		delete animation;
+	}
+	fonts.clear();
+	delete state.textures;
+	SDL_DestroyRenderer(renderer);
+	SDL_FreeSurface(surface);
+	TTF_Quit();
+	IMG_Quit();
+	SDL_Quit();
+	return EXIT_SUCCESS;
+}
@@ -17,6 +17,9 @@
     along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
 
 #include "UICursor.h"
+#include "AlphaUtil.h"
+
+#include <vector>
 
 UICursor::UICursor(Texture* texture, uint32_t width, uint32_t height) :
 maxX(width), maxY(height), velocityX(0.0), velocityY(0.0) {
@@ -25,6 +28,17 @@ maxX(width), maxY(height), velocityX(0.0), velocityY(0.0) {
 				y = 0;
 				listener = nullptr;
 				focus = false;
+				hardwareCursor = nullptr;
+				software = true;
+				visible = false;
+}
+
+UICursor::~UICursor() {
+    if (hardwareCursor != nullptr) {
+        // SDL restores the default cursor if this is the current one.
+        SDL_FreeCursor(hardwareCursor);
+        hardwareCursor = nullptr;
+    }
 }
 
 void UICursor::event(Event e, void* data) {
@@ -39,6 +53,11 @@ void UICursor::event(Event e, void* data) {
         case CURSOR_MOVEMENT:
             x = e.x;
             y = e.y;
+            // Moved by the mouse, (rather than a controller), so the system can draw it again.
+            if ((data != nullptr) && (hardwareCursor != nullptr) && software) {
+                software = false;
+                updateSystemCursor();
+            }
             break;
         default:
             break;
@@ -46,7 +65,9 @@ void UICursor::event(Event e, void* data) {
 }
 
 void UICursor::render(SDL_Renderer* renderer) {
-    texture->render(renderer, x - 11, y - 2);
+    if (software) {
+        texture->render(renderer, x - OCCILLO_CURSOR_HOTSPOT_X, y - OCCILLO_CURSOR_HOTSPOT_Y);
+    }
 }
 
 bool UICursor::canFocus() {
@@ -57,6 +78,11 @@ bool UICursor::move(double elapsed) {
     if (velocityX == 0.0f && velocityY == 0.0f) {
         return false;
     }
+    // The system cursor stays at the mouse position, so a controller moved pointer is drawn by the renderer.
+    if (!software) {
+        software = true;
+        updateSystemCursor();
+    }
     if (velocityX != 0.0f) {
         int nx = x + (velocityX * elapsed);
         //If the paddle went too far to the left or right
@@ -92,3 +118,53 @@ Event UICursor::locationEvent() {
     return Event(CURSOR_MOVEMENT, x, y);
 }
 
+
+bool UICursor::setHardwareCursor(SDL_Renderer* renderer, const std::string& path, int size) {
+    // The cursor is in output pixels, which the renderer scales render units to.
+    float scaleX = 1.0f;
+    float scaleY = 1.0f;
+    SDL_RenderGetScale(renderer, &scaleX, &scaleY);
+    const int pixels = (int)(size * scaleX / Texture::getPixelDensity() + 0.5f);
+    std::vector<SDL_Surface*> frames;
+    if ((pixels <= 0) || !Texture::rasterizeFile(path, pixels, pixels, frames)) {
+        g_info("%s[%d] : Failed to rasterize hardware cursor %s, drawing the pointer.", __FILE__, __LINE__, path.c_str());
+        return false;
+    }
+    // Rasterized with premultiplied alpha, the system expects straight alpha. Only the first frame of an
+    // animation is used.
+    AlphaUtil::unpremultiply(frames[0]);
+    SDL_Cursor* cursor = SDL_CreateColorCursor(frames[0], (int)(OCCILLO_CURSOR_HOTSPOT_X * scaleX + 0.5f),
+                         (int)(OCCILLO_CURSOR_HOTSPOT_Y * scaleY + 0.5f));
+    for (SDL_Surface* frame : frames) {
+        SDL_FreeSurface(frame);
+    }
+    if (cursor == nullptr) {
+        g_info("%s[%d] : Failed to create hardware cursor, drawing the pointer. SDL Error: %s", __FILE__, __LINE__, SDL_GetError());
+        return false;
+    }
+    if (hardwareCursor != nullptr) {
+        SDL_FreeCursor(hardwareCursor);
+    }
+    hardwareCursor = cursor;
+    software = false;
+    updateSystemCursor();
+    return true;
+}
+
+void UICursor::setVisible(bool visible) {
+    this->visible = visible;
+    updateSystemCursor();
+}
+
+bool UICursor::isHardware() {
+    return !software;
+}
+
+void UICursor::updateSystemCursor() {
+    if (visible && !software) {
+        SDL_SetCursor(hardwareCursor);
+        SDL_ShowCursor(SDL_ENABLE);
+    } else {
+        SDL_ShowCursor(SDL_DISABLE);
+    }
+}
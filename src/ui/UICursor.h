@@ -18,11 +18,25 @@
 
 #include "UIWidget.h"
 
+#include <string>
+
 #ifndef UICURSOR_H
 #define UICURSOR_H
 
+/**
+ * @brief The x offset of the pointer tip within the cursor image, (in render units).
+ */
+#define OCCILLO_CURSOR_HOTSPOT_X 11
+/**
+ * @brief The y offset of the pointer tip within the cursor image, (in render units).
+ */
+#define OCCILLO_CURSOR_HOTSPOT_Y 2
+
 /**
  * @brief A mouse cursor widget.
+ *
+ * The pointer is drawn by the system as a hardware cursor when one has been set, so it follows the mouse
+ * without waiting for a frame. It is drawn by the renderer otherwise, and while moved by a controller.
  */
 class UICursor : public UIWidget {
 public:
@@ -33,6 +47,7 @@ public:
      * @param height The display height
      */
     UICursor(Texture* texture, uint32_t width, uint32_t height);
+    ~UICursor();
 
     void event(Event e, void* data);
     void render(SDL_Renderer* renderer);
@@ -60,6 +75,24 @@ public:
      * @return An event for the location of the cursor.
      */
     Event locationEvent();
+    /**
+     * @brief Draw the pointer with a hardware cursor, rasterized from the given image.
+     * @param renderer The renderer, (its scale sizes the cursor to match the drawn pointer).
+     * @param path The image file.
+     * @param size The size of the image in render units.
+     * @return TRUE if the hardware cursor was created, otherwise the pointer is drawn by the renderer.
+     */
+    bool setHardwareCursor(SDL_Renderer* renderer, const std::string& path, int size);
+    /**
+     * @brief Show or hide the pointer, (the system cursor is hidden when the renderer draws it).
+     * @param visible TRUE to show.
+     */
+    void setVisible(bool visible);
+    /**
+     * @brief Determine if the pointer is currently drawn by the system.
+     * @return TRUE if a hardware cursor.
+     */
+    bool isHardware();
 private:
     /**
      * The maximum X value
@@ -77,6 +110,22 @@ private:
      * Velocity of the cursor on the Y axis
      */
     double velocityY;
+    /**
+     * The hardware cursor, (nullptr if drawn by the renderer).
+     */
+    SDL_Cursor* hardwareCursor;
+    /**
+     * TRUE if drawn by the renderer, (no hardware cursor, or the last move was by a controller).
+     */
+    bool software;
+    /**
+     * TRUE if shown.
+     */
+    bool visible;
+    /**
+     * Show or hide the system cursor to match the current state.
+     */
+    void updateSystemCursor();
 };
 
 #endif /* UICURSOR_H */
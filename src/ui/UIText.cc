@@ -28,7 +28,7 @@ UIText::UIText(TTF_Font* font, SDL_Color* colour, SDL_Renderer* renderer) {
 	this->colour = colour;
 	text = "";
 	updated = true;
-	lastTime = SDL_GetTicks() / 1000;
+	lastTime = Texture::getClock() / 1000;
 	cursor = new Texture();
 	if (!cursor->loadFromText(renderer, _("_"), font, colour)) {
 		g_info("%s[%d] : Failed to create cursor texture, setting as missing texture.", __FILE__, __LINE__);
@@ -38,8 +38,6 @@ UIText::UIText(TTF_Font* font, SDL_Color* colour, SDL_Renderer* renderer) {
 }
 
 UIText::~UIText() {
-	TTF_CloseFont(font);
-
 	// main texture will be done in the super::~
 	if (cursor != nullptr) {
 		delete cursor;
@@ -102,7 +100,8 @@ void UIText::setCenter(bool center) {
 }
 
 void UIText::render(SDL_Renderer * renderer) {
-	uint32_t time = SDL_GetTicks() / 1000;
+	// The frame time, so the cursor blinks with the frame clock, (and stops when it is paused).
+	uint32_t time = Texture::getClock() / 1000;
 
 	if (updated || texture == nullptr) {
 		if (texture != nullptr) {
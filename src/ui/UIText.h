@@ -33,7 +33,7 @@ class UIText : public UIWidget {
 	/**
 	* @brief Create a new text input widget
 	*
-	* @param font The font to use
+	* @param font The font to use, (not owned by the widget)
 	* @param colour The colour of the text to display
 	* @param renderer The SDL renderer.
 	*/
@@ -0,0 +1,161 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "AlphaUtil.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#define OCCILLO_ALPHAUTIL_SSE2
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Divide by 255, rounded, (as the SIMD kernels do).
+ */
+static inline Uint32 divide255(Uint32 value) {
+	value += 128;
+	return (value + (value >> 8)) >> 8;
+}
+
+void AlphaUtil::premultiplyScalar(Uint32* row, int width) {
+	for (int x = 0; x < width; x++) {
+		Uint32 pixel = row[x];
+		Uint32 alpha = pixel >> 24;
+		if (alpha == 0xff) {
+			continue;
+		}
+		Uint32 r = divide255(((pixel >> 16) & 0xff) * alpha);
+		Uint32 g = divide255(((pixel >> 8) & 0xff) * alpha);
+		Uint32 b = divide255((pixel & 0xff) * alpha);
+		row[x] = (alpha << 24) | (r << 16) | (g << 8) | b;
+	}
+}
+
+void AlphaUtil::unpremultiplyScalar(Uint32* row, int width) {
+	for (int x = 0; x < width; x++) {
+		Uint32 pixel = row[x];
+		Uint32 alpha = pixel >> 24;
+		if (alpha == 0xff) {
+			continue;
+		}
+		if (alpha == 0) {
+			row[x] = 0;
+			continue;
+		}
+		Uint32 r = std::min((((pixel >> 16) & 0xff) * 255 + alpha / 2) / alpha, 255u);
+		Uint32 g = std::min((((pixel >> 8) & 0xff) * 255 + alpha / 2) / alpha, 255u);
+		Uint32 b = std::min(((pixel & 0xff) * 255 + alpha / 2) / alpha, 255u);
+		row[x] = (alpha << 24) | (r << 16) | (g << 8) | b;
+	}
+}
+
+#ifdef OCCILLO_ALPHAUTIL_SSE2
+/**
+ * @brief Premultiply 2 pixels widened to 16 bit channels.
+ */
+static inline __m128i premultiplySSE2(__m128i pixels) {
+	// Alpha into every channel of its pixel, with 255 in the alpha channel so alpha is kept.
+	const __m128i keepAlpha = _mm_setr_epi16(0, 0, 0, 0xff, 0, 0, 0, 0xff);
+	__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+	__m128i product = _mm_add_epi16(_mm_mullo_epi16(pixels, _mm_or_si128(alpha, keepAlpha)), _mm_set1_epi16(128));
+	// Divide by 255, rounded.
+	return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+}
+
+static void premultiplyRowSSE2(Uint32* row, int width) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i opaque = _mm_set1_epi32((int) 0xff000000);
+	int x = 0;
+	for (; x + 4 <= width; x += 4) {
+		__m128i pixels = _mm_loadu_si128((const __m128i*)(row + x));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(pixels, opaque), opaque)) == 0xffff) {
+			// Opaque, (the usual case), so nothing to do.
+			continue;
+		}
+		__m128i low = premultiplySSE2(_mm_unpacklo_epi8(pixels, zero));
+		__m128i high = premultiplySSE2(_mm_unpackhi_epi8(pixels, zero));
+		_mm_storeu_si128((__m128i*)(row + x), _mm_packus_epi16(low, high));
+	}
+	AlphaUtil::premultiplyScalar(row + x, width - x);
+}
+
+/**
+ * @brief Unpremultiply 1 pixel widened to float channels, (to be truncated to integers).
+ */
+static inline __m128 unpremultiplySSE2(__m128 pixel) {
+	const __m128 colour = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+	const __m128 one = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+	__m128 alpha = _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(3, 3, 3, 3));
+	// Colour * 255 / alpha, dividing last so exact halves stay exact, and alpha * 1 / 1.
+	__m128 scale = _mm_or_ps(_mm_and_ps(_mm_set1_ps(255.0f), colour), one);
+	__m128 divisor = _mm_or_ps(_mm_and_ps(alpha, colour), one);
+	__m128 result = _mm_div_ps(_mm_mul_ps(pixel, scale), divisor);
+	// Rounded half up as the scalar loop does, (and 0 where transparent).
+	return _mm_and_ps(_mm_add_ps(result, _mm_set1_ps(0.5f)), _mm_cmpgt_ps(alpha, _mm_setzero_ps()));
+}
+
+static void unpremultiplyRowSSE2(Uint32* row, int width) {
+	const __m128i zero = _mm_setzero_si128();
+	int x = 0;
+	for (; x + 4 <= width; x += 4) {
+		__m128i pixels = _mm_loadu_si128((const __m128i*)(row + x));
+		__m128i low = _mm_unpacklo_epi8(pixels, zero);
+		__m128i high = _mm_unpackhi_epi8(pixels, zero);
+		__m128i p0 = _mm_cvttps_epi32(unpremultiplySSE2(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero))));
+		__m128i p1 = _mm_cvttps_epi32(unpremultiplySSE2(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero))));
+		__m128i p2 = _mm_cvttps_epi32(unpremultiplySSE2(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero))));
+		__m128i p3 = _mm_cvttps_epi32(unpremultiplySSE2(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero))));
+		_mm_storeu_si128((__m128i*)(row + x), _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3)));
+	}
+	AlphaUtil::unpremultiplyScalar(row + x, width - x);
+}
+#endif
+
+SDL_BlendMode AlphaUtil::getPremultipliedBlendMode() {
+	static const SDL_BlendMode mode = SDL_ComposeCustomBlendMode(
+	                                      SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+	                                      SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+	return mode;
+}
+
+void AlphaUtil::premultiply(SDL_Surface* surface) {
+	SDL_LockSurface(surface);
+	for (int y = 0; y < surface->h; y++) {
+		Uint32* row = (Uint32*)((Uint8*) surface->pixels + (size_t) y * surface->pitch);
+#ifdef OCCILLO_ALPHAUTIL_SSE2
+		premultiplyRowSSE2(row, surface->w);
+#else
+		AlphaUtil::premultiplyScalar(row, surface->w);
+#endif
+	}
+	SDL_UnlockSurface(surface);
+}
+
+void AlphaUtil::unpremultiply(SDL_Surface* surface) {
+	SDL_LockSurface(surface);
+	for (int y = 0; y < surface->h; y++) {
+		Uint32* row = (Uint32*)((Uint8*) surface->pixels + (size_t) y * surface->pitch);
+#ifdef OCCILLO_ALPHAUTIL_SSE2
+		unpremultiplyRowSSE2(row, surface->w);
+#else
+		AlphaUtil::unpremultiplyScalar(row, surface->w);
+#endif
+	}
+	SDL_UnlockSurface(surface);
+}
@@ -0,0 +1,65 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_ALPHAUTIL_H
+#define UTIL_ALPHAUTIL_H
+
+#include <SDL.h>
+
+namespace AlphaUtil {
+
+	/**
+	* @brief Get the blend mode for textures with premultiplied alpha.
+	*
+	* @return The blend mode, (source colour added to the destination scaled by the inverse source alpha).
+	*/
+	SDL_BlendMode getPremultipliedBlendMode();
+
+	/**
+	* @brief Multiply the colour of each pixel of an ARGB8888 surface by its alpha.
+	*
+	* @param surface The surface, (straight alpha).
+	*/
+	void premultiply(SDL_Surface* surface);
+
+	/**
+	* @brief Divide the colour of each pixel of an ARGB8888 surface by its alpha.
+	*
+	* @param surface The surface, (premultiplied alpha).
+	*/
+	void unpremultiply(SDL_Surface* surface);
+
+	/**
+	* @brief Premultiply a row of ARGB8888 pixels one at a time, (the reference for the SIMD kernel).
+	*
+	* @param row The pixels.
+	* @param width The number of pixels.
+	*/
+	void premultiplyScalar(Uint32* row, int width);
+
+	/**
+	* @brief Unpremultiply a row of ARGB8888 pixels one at a time, (the reference for the SIMD kernel).
+	*
+	* @param row The pixels.
+	* @param width The number of pixels.
+	*/
+	void unpremultiplyScalar(Uint32* row, int width);
+
+}
+
+#endif
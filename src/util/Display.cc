@@ -18,21 +18,68 @@
 
 #include "Display.h"
 
+#include <algorithm>
+
 Display::Display() {
 	displayRenderer = nullptr;
 	displayWindow = nullptr;
 	displayFullscreen = false;
 	displayHeight = 480;
 	displayWidth = 720;
+	logicalWidth = 0;
+	logicalHeight = 0;
+	pixelDensity = 1.0f;
 	sdl_init = false;
 	sdl_image_init = false;
 	sdl_mixer_init = false;
 	sdl_ttf_init = false;
 	controller = nullptr;
+	frameStats = new FrameStats();
+	frameClock = new FrameClock();
+	fontCache = new FontCache();
+	soundCache = new SoundCache();
+	musicCache = new MusicCache();
+	voiceManager = new VoiceManager();
+	screenshotWriter = new ScreenshotWriter();
+	recorder = new VideoRecorder();
+	statsOverlay = nullptr;
+	statsVisible = false;
 }
 
 Display::~Display() {
 	close();
+	if (frameStats != nullptr) {
+		delete frameStats;
+		frameStats = nullptr;
+	}
+	if (frameClock != nullptr) {
+		delete frameClock;
+		frameClock = nullptr;
+	}
+	if (fontCache != nullptr) {
+		delete fontCache;
+		fontCache = nullptr;
+	}
+	if (soundCache != nullptr) {
+		delete soundCache;
+		soundCache = nullptr;
+	}
+	if (musicCache != nullptr) {
+		delete musicCache;
+		musicCache = nullptr;
+	}
+	if (voiceManager != nullptr) {
+		delete voiceManager;
+		voiceManager = nullptr;
+	}
+	if (screenshotWriter != nullptr) {
+		delete screenshotWriter;
+		screenshotWriter = nullptr;
+	}
+	if (recorder != nullptr) {
+		delete recorder;
+		recorder = nullptr;
+	}
 }
 
 bool Display::init(Configuration *config, GameConfiguration* game) {
@@ -70,6 +117,9 @@ bool Display::init(Configuration *config, GameConfiguration* game) {
 		} else {
 			sdl_flags = SDL_WINDOW_SHOWN;
 		}
+		if (!config->isLowDpi()) {
+			sdl_flags |= SDL_WINDOW_ALLOW_HIGHDPI;
+		}
 		g_info("%s[%d] Creating Display %d %d %d", __FILE__, __LINE__, displayWidth, displayHeight, displayFullscreen);
 		displayWindow = SDL_CreateWindow(gameName.c_str(), SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, displayWidth, displayHeight, sdl_flags);
 
@@ -80,6 +130,11 @@ bool Display::init(Configuration *config, GameConfiguration* game) {
 
 			//Create renderer for window
 			displayRenderer = SDL_CreateRenderer(displayWindow, -1, SDL_RENDERER_ACCELERATED);
+			if (displayRenderer == nullptr) {
+				// No accelerated renderer, (eg the dummy video driver), so fall back to software.
+				g_info("%s[%d] Accelerated renderer could not be created, using software. SDL Error: %s", __FILE__, __LINE__, SDL_GetError());
+				displayRenderer = SDL_CreateRenderer(displayWindow, -1, SDL_RENDERER_SOFTWARE);
+			}
 
 			if (displayRenderer == nullptr) {
 				g_info("%s[%d] Renderer could not be created! SDL Error: %s", __FILE__, __LINE__, SDL_GetError());
@@ -87,6 +142,19 @@ bool Display::init(Configuration *config, GameConfiguration* game) {
 			} else {
 				//Initialize renderer color
 				SDL_SetRenderDrawColor(displayRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				// Images and text are rasterized at the pixel density, while the game keeps to window units.
+				int pw = 0;
+				int ph = 0;
+				int ww = 0;
+				int wh = 0;
+				SDL_GetWindowSize(displayWindow, &ww, &wh);
+				if ((SDL_GetRendererOutputSize(displayRenderer, &pw, &ph) == 0) && (ww > 0) && (pw > ww)) {
+					pixelDensity = (float) pw / (float) ww;
+					g_info("%s[%d] HiDPI display, %d %d pixels for a %d %d window", __FILE__, __LINE__, pw, ph, ww, wh);
+				}
+				Texture::setPixelDensity(pixelDensity);
+				fontCache->setScale(pixelDensity);
+				setLogicalSize(config);
 				//Initialize PNG loading
 				int imgFlags = IMG_INIT_PNG;
 
@@ -111,8 +179,10 @@ bool Display::init(Configuration *config, GameConfiguration* game) {
 					success = false;
 				} else {
 					sdl_mixer_init = true;
-					// Allocate 16 mixing channels.
-					Mix_AllocateChannels(16);
+					soundCache->setPersistent(config->isSoundCache());
+					musicCache->setPersistent(config->isMusicCache());
+					voiceManager->init(game->getSoundChannels(), game->getSoundCoalesceTime(), game->getSoundMaxVoices());
+					Texture::setDefaultAnimation(game->getAnimationRate(), Texture::parseAnimationMode(*(game->getAnimationMode())));
 				}
 
 				controller = nullptr;
@@ -132,13 +202,18 @@ bool Display::init(Configuration *config, GameConfiguration* game) {
 					}
 				}
 
+				if (sdl_ttf_init) {
+					statsOverlay = new StatsOverlay(fontCache->getFont(config->locateResource(*(game->getFont())), std::max(config->getRenderHeight() / 48, 10)));
+				}
+
 				if (success) {
 					// Set icon
 					std::string path = *(game->getApplicationIcon());
 					path = config->locateResource(path);
 					if (!path.empty()) {
 						g_info("%s[%d] : Setting application icon: %s", __FILE__, __LINE__, path.c_str());
-						SDL_Surface* surface = IMG_Load(path.c_str());
+						SDL_RWops* packed = ResourcePack::openRW(path);
+						SDL_Surface* surface = (packed != nullptr) ? IMG_Load_RW(packed, 1) : IMG_Load(path.c_str());
 						if (surface == nullptr) {
 							g_info("%s[%d] : Failed to load application icon: %s", __FILE__, __LINE__, IMG_GetError());
 						} else {
@@ -160,29 +235,63 @@ bool Display::update(Configuration *config) {
 	bool df = config->isFullscreen();
 	int dh = config->getDisplayHeight();
 	int dw = config->getDisplayWidth();
-	if ((df == displayFullscreen) && (dh == displayHeight) && (dh == displayWidth)) {
-		// do nothing.
-		return false;
+	const int renderWidth = (logicalWidth > 0) ? logicalWidth : displayWidth;
+	const int renderHeight = (logicalHeight > 0) ? logicalHeight : displayHeight;
+	if ((df != displayFullscreen) || (dh != displayHeight) || (dw != displayWidth)) {
+		if (displayFullscreen) {
+			// we are in full screen switch from fullscreen to do the window resize
+			SDL_SetWindowFullscreen(displayWindow, 0);
+		}
+		// do the resize...
+		g_info("%s[%d] Creating Display %d %d %d", __FILE__, __LINE__, dw, dh, df);
+		SDL_SetWindowSize(displayWindow, dw, dh);
+		if (df) {
+			// switch to requested fullscreen
+			SDL_SetWindowFullscreen(displayWindow, SDL_WINDOW_FULLSCREEN);
+		}
+		// record what we set...
+		displayFullscreen = df;
+		displayHeight = dh;
+		displayWidth = dw;
 	}
-	if (displayFullscreen) {
-		// we are in full screen switch from fullscreen to do the window resize
-		SDL_SetWindowFullscreen(displayWindow, 0);
+	setLogicalSize(config);
+	// With a logical size the renderer scales to the new window, and nothing needs rebuilding.
+	return (config->getRenderWidth() != renderWidth) || (config->getRenderHeight() != renderHeight);
+}
+
+void Display::setLogicalSize(Configuration *config) {
+	const int lw = config->getLogicalWidth();
+	const int lh = config->getLogicalHeight();
+	if ((lw > 0) && (lh > 0)) {
+		logicalWidth = lw;
+		logicalHeight = lh;
+	} else {
+		logicalWidth = 0;
+		logicalHeight = 0;
 	}
-	// do the resize...
-	g_info("%s[%d] Creating Display %d %d %d", __FILE__, __LINE__, dw, dh, df);
-	SDL_SetWindowSize(displayWindow, dw, dh);
-	if (df) {
-		// switch to requested fullscreen
-		SDL_SetWindowFullscreen(displayWindow, SDL_WINDOW_FULLSCREEN);
+	// On HiDPI displays the renderer is in pixels, so scale the window size to them.
+	const int rw = (logicalWidth > 0) ? logicalWidth : ((pixelDensity != 1.0f) ? displayWidth : 0);
+	const int rh = (logicalHeight > 0) ? logicalHeight : ((pixelDensity != 1.0f) ? displayHeight : 0);
+	if (SDL_RenderSetLogicalSize(displayRenderer, rw, rh) != 0) {
+		g_info("%s[%d] Logical size %d %d not set! SDL Error: %s", __FILE__, __LINE__, rw, rh, SDL_GetError());
 	}
-	// record what we set...
-	displayFullscreen = df;
-	displayHeight = dh;
-	displayWidth = dw;
-	return true;
 }
 
 void Display::close() {
+	// The panel's textures and the fonts belong to the renderer and SDL_ttf.
+	if (statsOverlay != nullptr) {
+		delete statsOverlay;
+		statsOverlay = nullptr;
+	}
+	fontCache->clear();
+	if (sdl_mixer_init) {
+		voiceManager->halt();
+	}
+	soundCache->clear();
+	// Wait for any music render, which uses the mixer.
+	musicCache->clear();
+	screenshotWriter->clear();
+	recorder->stop();
 	//Destroy window
 	if (displayRenderer != nullptr) {
 		SDL_DestroyRenderer(displayRenderer);
@@ -199,17 +308,22 @@ void Display::close() {
 		controller = nullptr;
 	}
 
+	// Cleared as each is shut down, as the destructor closes again.
 	if (sdl_mixer_init) {
 		Mix_Quit();
+		sdl_mixer_init = false;
 	}
 	if (sdl_ttf_init) {
 		TTF_Quit();
+		sdl_ttf_init = false;
 	}
 	if (sdl_image_init) {
 		IMG_Quit();
+		sdl_image_init = false;
 	}
 	if (sdl_init) {
 		SDL_Quit();
+		sdl_init = false;
 	}
 }
 
@@ -223,25 +337,87 @@ void Display::clear() {
 }
 
 void Display::render() {
+	// Jobs bound to the main thread, (renderer calls), run before the frame is presented.
+	JobSystem::runMain();
+	// Recorded without the work counters panel.
+	recorder->capture(displayRenderer);
+	if (statsVisible && (statsOverlay != nullptr)) {
+		statsOverlay->render(displayRenderer);
+	}
 	SDL_RenderPresent(displayRenderer);
+	// The next frame is timed from here.
+	frameClock->tick();
+	Texture::setClock(frameClock->getTime());
+	WorkCounters::frame();
+	if (frameStats->frame()) {
+		// Have the current application state exit, main() will then unwind the rest.
+		SDL_Event e;
+		SDL_zero(e);
+		e.type = SDL_QUIT;
+		SDL_PushEvent(&e);
+	}
+}
+
+FrameClock* Display::getFrameClock() {
+	return frameClock;
+}
+
+FontCache* Display::getFontCache() {
+	return fontCache;
+}
+
+SoundCache* Display::getSoundCache() {
+	return soundCache;
+}
+
+MusicCache* Display::getMusicCache() {
+	return musicCache;
+}
+
+VoiceManager* Display::getVoiceManager() {
+	return voiceManager;
+}
+
+FrameStats* Display::getFrameStats() {
+	return frameStats;
+}
+
+bool Display::isQuitRequested() {
+	return frameStats->isLimitReached();
+}
+
+void Display::setStatsVisible(bool visible) {
+	statsVisible = visible;
+	if (visible) {
+		WorkCounters::setEnabled(true);
+	}
+}
+
+void Display::toggleStats() {
+	setStatsVisible(!statsVisible);
+}
+
+bool Display::startRecording(const std::string& file, int fps, bool throttle) {
+	if (displayRenderer == nullptr) {
+		return false;
+	}
+	int pw = displayWidth;
+	int ph = displayHeight;
+	SDL_GetRendererOutputSize(displayRenderer, &pw, &ph);
+	return recorder->start(file, pw, ph, fps, throttle);
+}
+
+void Display::stopRecording() {
+	recorder->stop();
 }
 
 void Display::screenshot() {
 	if (displayRenderer != nullptr) {
-		int tm = (int)time(NULL);
-		char dest[100] = "";
-#ifdef _WIN32
-		_snprintf(dest, 100, "screenshot-%d.png", tm);
-#else
-		std::snprintf(dest, 100, "screenshot-%d.png", tm);
-#endif
-		std::string dstr = dest;
-
-		SDL_Surface *sshot = SDL_CreateRGBSurface(0, displayWidth, displayHeight, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
-		SDL_RenderReadPixels(displayRenderer, NULL, SDL_PIXELFORMAT_ARGB8888, sshot->pixels, sshot->pitch);
-		//SDL_SaveBMP(sshot, "screenshot.bmp");
-		IMG_SavePNG(sshot, dstr.c_str());
-		SDL_FreeSurface(sshot);
+		// Read at the pixel size, (which is larger than the window on HiDPI displays).
+		int pw = displayWidth;
+		int ph = displayHeight;
+		SDL_GetRendererOutputSize(displayRenderer, &pw, &ph);
+		screenshotWriter->capture(displayRenderer, pw, ph);
 	}
 }
 
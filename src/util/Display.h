@@ -27,6 +27,17 @@
 #include "config.h"
 #include "Configuration.h"
 #include "GameConfiguration.h"
+#include "FrameStats.h"
+#include "FrameClock.h"
+#include "FontCache.h"
+#include "SoundCache.h"
+#include "MusicCache.h"
+#include "VoiceManager.h"
+#include "StatsOverlay.h"
+#include "WorkCounters.h"
+#include "JobSystem.h"
+#include "ScreenshotWriter.h"
+#include "VideoRecorder.h"
 
 // Handle circular reference to game configuration.
 #ifndef GameConfiguration
@@ -53,7 +64,7 @@ public:
   /**
    * Update the display based on information in the system config
    * @param config The application configuration
-   * @return TRUE if it initialised correctly.
+   * @return TRUE if the size the game renders at changed, (and the assets must be rebuilt).
    */
   bool update(Configuration *config);
   /**
@@ -75,11 +86,72 @@ public:
   void render();
 
 	/**
-	* @brief Generate a screenshot.
+	* @brief Generate a screenshot, (the PNG file is written in the background).
 	*/
 	void screenshot();
+	/**
+	 * @brief Record every presented frame to the given file, (once initialised).
+	 * @param file The file to write, (".y4m", ".png" for a numbered sequence, or raw frames).
+	 * @param fps The frame rate written to the file, (Y4M only).
+	 * @param throttle TRUE to slow rendering to the writer rather than drop frames.
+	 * @return TRUE if recording started.
+	 */
+	bool startRecording(const std::string& file, int fps, bool throttle);
+	/**
+	 * @brief Stop recording, writing any frames still queued.
+	 */
+	void stopRecording();
+	/**
+	 * @brief Get the shared font cache.
+	 * @return The font cache.
+	 */
+	FontCache* getFontCache();
+	/**
+	 * @brief Get the shared sound effect cache.
+	 * @return The sound cache.
+	 */
+	SoundCache* getSoundCache();
+	/**
+	 * @brief Get the music loader, (which may play music rendered to PCM).
+	 * @return The music cache.
+	 */
+	MusicCache* getMusicCache();
+	/**
+	 * @brief Get the sound effect voice manager.
+	 * @return The voice manager.
+	 */
+	VoiceManager* getVoiceManager();
+	/**
+	 * @brief Get the frame statistics, updated on each render.
+	 * @return The frame statistics.
+	 */
+	FrameStats* getFrameStats();
+	/**
+	 * @brief Get the frame clock, ticked on each render.
+	 * @return The frame clock.
+	 */
+	FrameClock* getFrameClock();
+	/**
+	 * @brief Determine if the frame limit has been reached and the application should exit.
+	 * @return TRUE if the application should exit.
+	 */
+	bool isQuitRequested();
+	/**
+	 * @brief Show or hide the work counters panel.
+	 * @param visible TRUE to show the panel.
+	 */
+	void setStatsVisible(bool visible);
+	/**
+	 * @brief Toggle the work counters panel.
+	 */
+	void toggleStats();
 
 private:
+  /**
+   * @brief Have the renderer scale the logical size from the configuration to the window, (or stop scaling).
+   * @param config The application configuration.
+   */
+  void setLogicalSize(Configuration *config);
   /**
    * @brief SDL Window pointer
    */
@@ -100,6 +172,18 @@ private:
    * @brief The height of the display
    */
   int displayHeight;
+  /**
+   * @brief The logical width rendered at, (0 to render at the display width).
+   */
+  int logicalWidth;
+  /**
+   * @brief The logical height rendered at, (0 to render at the display height).
+   */
+  int logicalHeight;
+  /**
+   * @brief The pixels per window unit, (above 1.0 on HiDPI displays).
+   */
+  float pixelDensity;
   /**
    * @brief Flag to request fullscreen mode for the given resolution.
    */
@@ -120,6 +204,46 @@ private:
    * TRUE if SDL_ttf was initialised.
    */
   bool sdl_ttf_init;
+  /**
+   * @brief The frame statistics.
+   */
+  FrameStats* frameStats;
+  /**
+   * @brief The frame clock.
+   */
+  FrameClock* frameClock;
+  /**
+   * @brief The shared font cache.
+   */
+  FontCache* fontCache;
+  /**
+   * @brief The shared sound effect cache.
+   */
+  SoundCache* soundCache;
+  /**
+   * @brief The music loader.
+   */
+  MusicCache* musicCache;
+  /**
+   * @brief The sound effect voice manager.
+   */
+  VoiceManager* voiceManager;
+  /**
+   * @brief The screenshot writer.
+   */
+  ScreenshotWriter* screenshotWriter;
+  /**
+   * @brief The gameplay recorder.
+   */
+  VideoRecorder* recorder;
+  /**
+   * @brief The work counters panel.
+   */
+  StatsOverlay* statsOverlay;
+  /**
+   * @brief TRUE if the work counters panel is shown.
+   */
+  bool statsVisible;
 };
 
 #endif  /* DISPLAY_H */
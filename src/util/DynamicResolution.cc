@@ -0,0 +1,110 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+DynamicResolution::DynamicResolution(SDL_Renderer* renderer, int width, int height, double minScale, double maxScale, int fps) :
+	renderer(renderer), target(nullptr), width(width), height(height) {
+	this->minScale = std::min(std::max(minScale, OCCILLO_DYNRES_STEP), 1.0);
+	this->maxScale = std::min(std::max(maxScale, this->minScale), 1.0);
+	scale = this->maxScale;
+	density = Texture::getPixelDensity();
+	budget = 1000.0 / ((fps > 0) ? fps : 60);
+	average = 0.0;
+	last = 0;
+	frequency = SDL_GetPerformanceFrequency();
+	settle = 0;
+	if (this->minScale >= 1.0) {
+		return;
+	}
+	if (!SDL_RenderTargetSupported(renderer)) {
+		g_info("%s[%d] : Render targets not supported, dynamic resolution disabled", __FILE__, __LINE__);
+		return;
+	}
+	target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+	                           (int) std::ceil(width * density), (int) std::ceil(height * density));
+	if (target == nullptr) {
+		g_info("%s[%d] : Unable to create the render target, dynamic resolution disabled: %s", __FILE__, __LINE__, SDL_GetError());
+		return;
+	}
+	// The scene is opaque, and replaces what is under it.
+	SDL_SetTextureBlendMode(target, SDL_BLENDMODE_NONE);
+	g_info("%s[%d] : Dynamic resolution %.2f - %.2f at %.2f ms", __FILE__, __LINE__, this->minScale, this->maxScale, budget);
+}
+
+DynamicResolution::~DynamicResolution() {
+	if (target != nullptr) {
+		SDL_DestroyTexture(target);
+		target = nullptr;
+	}
+	WorkCounters::set(WORK_RENDER_SCALE, 0);
+}
+
+bool DynamicResolution::isEnabled() {
+	return target != nullptr;
+}
+
+double DynamicResolution::getScale() {
+	return isEnabled() ? scale : 1.0;
+}
+
+void DynamicResolution::adjust() {
+	Uint64 now = SDL_GetPerformanceCounter();
+	if (last != 0) {
+		double ms = (double)(now - last) * 1000.0 / (double) frequency;
+		average = (average == 0.0) ? ms : (average + OCCILLO_DYNRES_SMOOTHING * (ms - average));
+		if (++settle >= OCCILLO_DYNRES_SETTLE_FRAMES) {
+			if ((average > budget * OCCILLO_DYNRES_HIGH) && (scale > minScale)) {
+				scale = std::max(scale - OCCILLO_DYNRES_STEP, minScale);
+				settle = 0;
+			} else if ((average < budget * OCCILLO_DYNRES_LOW) && (scale < maxScale)) {
+				scale = std::min(scale + OCCILLO_DYNRES_STEP, maxScale);
+				settle = 0;
+			}
+		}
+	}
+	last = now;
+}
+
+void DynamicResolution::begin() {
+	if (!isEnabled()) {
+		return;
+	}
+	adjust();
+	SDL_SetRenderTarget(renderer, target);
+	SDL_RenderSetScale(renderer, (float)(scale * density), (float)(scale * density));
+	SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+	SDL_RenderClear(renderer);
+}
+
+void DynamicResolution::end() {
+	if (!isEnabled()) {
+		WorkCounters::set(WORK_RENDER_SCALE, 100);
+		return;
+	}
+	SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+	SDL_SetRenderTarget(renderer, nullptr);
+	SDL_Rect scene = { 0, 0, (int) std::ceil(width * density * scale), (int) std::ceil(height * density * scale) };
+	SDL_Rect screen = { 0, 0, width, height };
+	SDL_RenderCopy(renderer, target, &scene, &screen);
+	WorkCounters::add(WORK_DRAW_CALLS);
+	WorkCounters::set(WORK_RENDER_SCALE, (unsigned long)(scale * 100.0 + 0.5));
+}
@@ -0,0 +1,150 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_DYNAMICRESOLUTION_H
+#define UTIL_DYNAMICRESOLUTION_H
+
+#include <SDL.h>
+#include <glib.h>
+
+#include "config.h"
+#include "WorkCounters.h"
+#include "Texture.h"
+
+/**
+ * @brief The weight of the latest frame in the average frame time.
+ */
+#define OCCILLO_DYNRES_SMOOTHING 0.1
+/**
+ * @brief The change in scale on each adjustment.
+ */
+#define OCCILLO_DYNRES_STEP 0.05
+/**
+ * @brief The frames to wait after an adjustment before the next, (so the average settles).
+ */
+#define OCCILLO_DYNRES_SETTLE_FRAMES 30
+/**
+ * @brief The fraction of the frame budget above which the scale is lowered.
+ */
+#define OCCILLO_DYNRES_HIGH 0.9
+/**
+ * @brief The fraction of the frame budget below which the scale is raised.
+ */
+#define OCCILLO_DYNRES_LOW 0.7
+
+/**
+ * @brief Renders a scene into an offscreen target at a scale adapted to the frame time.
+ *
+ * The scene is drawn between begin() and end() into the top left of a target the size of the
+ * scene, scaled down by the current scale, and end() then stretches it over the screen. The
+ * scale follows the average frame time, stepping down when over the frame budget and back up
+ * when well under it, within the given bounds. Anything drawn after end(), (eg the HUD), is at
+ * the native resolution.
+ */
+class DynamicResolution {
+  public:
+	/**
+	 * @brief Create a new scaler, (disabled if the bounds are equal at 1.0 or targets are not supported).
+	 * @param renderer The renderer.
+	 * @param width The width of the scene.
+	 * @param height The height of the scene.
+	 * @param minScale The smallest scale, (0.0 - 1.0].
+	 * @param maxScale The largest scale, (0.0 - 1.0].
+	 * @param fps The target frame rate.
+	 */
+	DynamicResolution(SDL_Renderer* renderer, int width, int height, double minScale, double maxScale, int fps);
+	virtual ~DynamicResolution();
+	/**
+	 * @brief Determine if the scene is being scaled.
+	 * @return TRUE if scaling.
+	 */
+	bool isEnabled();
+	/**
+	 * @brief Record the time of the last frame, adjust the scale, and start drawing the scene into the target.
+	 */
+	void begin();
+	/**
+	 * @brief Stop drawing into the target, and stretch the scene over the screen.
+	 */
+	void end();
+	/**
+	 * @brief Get the current scale.
+	 * @return The scale, (1.0 when disabled).
+	 */
+	double getScale();
+
+  private:
+	/**
+	 * @brief The renderer.
+	 */
+	SDL_Renderer* renderer;
+	/**
+	 * @brief The offscreen target, (nullptr when disabled).
+	 */
+	SDL_Texture* target;
+	/**
+	 * @brief The width of the scene.
+	 */
+	int width;
+	/**
+	 * @brief The height of the scene.
+	 */
+	int height;
+	/**
+	 * @brief The smallest scale.
+	 */
+	double minScale;
+	/**
+	 * @brief The largest scale.
+	 */
+	double maxScale;
+	/**
+	 * @brief The current scale.
+	 */
+	double scale;
+	/**
+	 * @brief The pixels of the target per unit of the scene, (above 1.0 on HiDPI displays).
+	 */
+	double density;
+	/**
+	 * @brief The frame budget in milliseconds.
+	 */
+	double budget;
+	/**
+	 * @brief The exponentially weighted moving average of the frame time in milliseconds.
+	 */
+	double average;
+	/**
+	 * @brief The performance counter at the start of the last frame, (0 before the first).
+	 */
+	Uint64 last;
+	/**
+	 * @brief The performance counter frequency.
+	 */
+	Uint64 frequency;
+	/**
+	 * @brief The frames since the last adjustment.
+	 */
+	int settle;
+	/**
+	 * @brief Update the average frame time and adjust the scale.
+	 */
+	void adjust();
+};
+
+#endif /* UTIL_DYNAMICRESOLUTION_H */
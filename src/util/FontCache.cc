@@ -0,0 +1,100 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "FontCache.h"
+
+FontCache::FontCache() {
+	scale = 1.0f;
+}
+
+FontCache::~FontCache() {
+	clear();
+}
+
+FontCache::FontFile* FontCache::getFile(const std::string& path) {
+	std::map<std::string, FontFile>::iterator it = files.find(path);
+	if (it != files.end()) {
+		return &(it->second);
+	}
+	FontFile file = { nullptr, 0, false };
+	const char* packed = nullptr;
+	size_t size = 0;
+	if (ResourcePack::find(path, &packed, &size)) {
+		// Read in place, (the pack stays mapped until exit).
+		file = { packed, size, true };
+		g_info("%s[%d] : Loaded font %s", __FILE__, __LINE__, path.c_str());
+		return &(files[path] = file);
+	}
+	gchar* contents = nullptr;
+	GError* error = nullptr;
+	if (!g_file_get_contents(path.c_str(), &contents, &file.length, &error)) {
+		g_info("%s[%d] : Unable to read font %s: %s", __FILE__, __LINE__, path.c_str(), error->message);
+		g_error_free(error);
+		return nullptr;
+	}
+	file.data = contents;
+	g_info("%s[%d] : Loaded font %s", __FILE__, __LINE__, path.c_str());
+	return &(files[path] = file);
+}
+
+TTF_Font* FontCache::getFont(const std::string& path, int size, int outline) {
+	FontKey key(path, size, outline);
+	std::map<FontKey, TTF_Font*>::iterator it = fonts.find(key);
+	if (it != fonts.end()) {
+		return it->second;
+	}
+	FontFile* file = getFile(path);
+	if (file == nullptr) {
+		return nullptr;
+	}
+	// The font reads from the file contents, which are kept until the cache is cleared.
+	TTF_Font* font = TTF_OpenFontRW(SDL_RWFromConstMem(file->data, file->length), 1, (int)(size * scale + 0.5f));
+	if (font == nullptr) {
+		g_info("%s[%d] : Unable to open font %s: %s", __FILE__, __LINE__, path.c_str(), TTF_GetError());
+		return nullptr;
+	}
+	if (outline > 0) {
+		TTF_SetFontOutline(font, (int)(outline * scale + 0.5f));
+	}
+	fonts[key] = font;
+	return font;
+}
+
+void FontCache::setScale(float scale) {
+	if (scale == this->scale) {
+		return;
+	}
+	for (std::map<FontKey, TTF_Font*>::iterator it = fonts.begin(); it != fonts.end(); ++it) {
+		TTF_CloseFont(it->second);
+	}
+	fonts.clear();
+	this->scale = scale;
+}
+
+void FontCache::clear() {
+	for (std::map<FontKey, TTF_Font*>::iterator it = fonts.begin(); it != fonts.end(); ++it) {
+		TTF_CloseFont(it->second);
+	}
+	fonts.clear();
+	for (std::map<std::string, FontFile>::iterator it = files.begin(); it != files.end(); ++it) {
+		if (!it->second.packed) {
+			g_free((gchar*) it->second.data);
+		}
+	}
+	files.clear();
+}
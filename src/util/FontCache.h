@@ -0,0 +1,103 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_FONTCACHE_H
+#define UTIL_FONTCACHE_H
+
+#include <string>
+#include <map>
+#include <tuple>
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <glib.h>
+
+#include "config.h"
+#include "ResourcePack.h"
+
+/**
+ * @brief A cache of open fonts, shared by all menus and levels.
+ *
+ * Each font file is read once and kept in memory, and each (file, size, outline) is opened once. The
+ * fonts handed out remain owned by the cache and must not be closed by the caller. Sizes are given in
+ * renderer units, and fonts are opened at the pixel density set with setScale().
+ */
+class FontCache {
+  public:
+	FontCache();
+	virtual ~FontCache();
+	/**
+	 * @brief Get the font for the given file, size and outline.
+	 * @param path The resolved path to the font file.
+	 * @param size The point size.
+	 * @param outline The outline size in pixels, (0 for none).
+	 * @return The font, or nullptr if it could not be opened.
+	 */
+	TTF_Font* getFont(const std::string& path, int size, int outline = 0);
+	/**
+	 * @brief Close all fonts and free the font files, (must be called before SDL_ttf is shutdown).
+	 */
+	void clear();
+	/**
+	 * @brief Set the pixels per renderer unit fonts are opened at, (closing the fonts opened at another scale).
+	 * @param scale The pixel density.
+	 */
+	void setScale(float scale);
+
+  private:
+	/**
+	 * @brief The key for an open font, (path, size, outline).
+	 */
+	typedef std::tuple<std::string, int, int> FontKey;
+	/**
+	 * @brief The contents of a font file.
+	 */
+	struct FontFile {
+		/**
+		 * @brief The file contents, (owned by glib, or by the resource pack if packed).
+		 */
+		const gchar* data;
+		/**
+		 * @brief The length of the file contents.
+		 */
+		gsize length;
+		/**
+		 * @brief TRUE if the contents are in the resource pack, (and are not freed).
+		 */
+		bool packed;
+	};
+	/**
+	 * @brief The font files read, by path.
+	 */
+	std::map<std::string, FontFile> files;
+	/**
+	 * @brief The pixels per renderer unit fonts are opened at.
+	 */
+	float scale;
+	/**
+	 * @brief The open fonts.
+	 */
+	std::map<FontKey, TTF_Font*> fonts;
+	/**
+	 * @brief Get the contents of the given font file, reading it if needed.
+	 * @param path The path to the font file.
+	 * @return The file contents, or nullptr if the file could not be read.
+	 */
+	FontFile* getFile(const std::string& path);
+};
+
+#endif /* UTIL_FONTCACHE_H */
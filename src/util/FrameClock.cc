@@ -0,0 +1,88 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "FrameClock.h"
+
+FrameClock::FrameClock() {
+	frequency = SDL_GetPerformanceFrequency();
+	last = SDL_GetPerformanceCounter();
+	time = 0.0;
+	delta = 0.0;
+	scale = 1.0;
+	paused = false;
+	fixedStep = 0.0;
+	frame = 0;
+}
+
+FrameClock::~FrameClock() {
+}
+
+void FrameClock::tick() {
+	Uint64 now = SDL_GetPerformanceCounter();
+	double seconds;
+	if (fixedStep > 0.0) {
+		seconds = fixedStep / 1000.0;
+	} else {
+		seconds = (double)(now - last) / (double) frequency;
+		if (seconds > OCCILLO_FRAMECLOCK_MAX_DELTA) {
+			seconds = OCCILLO_FRAMECLOCK_MAX_DELTA;
+		}
+	}
+	last = now;
+	delta = paused ? 0.0 : (seconds * scale);
+	time += delta * 1000.0;
+	frame++;
+}
+
+void FrameClock::resume() {
+	last = SDL_GetPerformanceCounter();
+	delta = 0.0;
+	paused = false;
+}
+
+void FrameClock::setPaused(bool paused) {
+	this->paused = paused;
+}
+
+bool FrameClock::isPaused() const {
+	return paused;
+}
+
+void FrameClock::setScale(double scale) {
+	this->scale = (scale > 0.0) ? scale : 0.0;
+}
+
+double FrameClock::getScale() const {
+	return scale;
+}
+
+void FrameClock::setFixedStep(double ms) {
+	fixedStep = (ms > 0.0) ? ms : 0.0;
+}
+
+Uint32 FrameClock::getTime() const {
+	return (Uint32) time;
+}
+
+double FrameClock::getDelta() const {
+	return delta;
+}
+
+Uint64 FrameClock::getFrame() const {
+	return frame;
+}
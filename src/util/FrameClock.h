@@ -0,0 +1,127 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_FRAMECLOCK_H
+#define UTIL_FRAMECLOCK_H
+
+#include <SDL.h>
+#include <glib.h>
+
+#include "config.h"
+
+/**
+ * @brief The largest frame delta in seconds, (a stall such as a window drag is not simulated as one long step).
+ */
+#define OCCILLO_FRAMECLOCK_MAX_DELTA 0.25
+
+/**
+ * @brief The time of the current frame, sampled once per frame and shared by every update and render.
+ *
+ * The clock runs in game time, which may be scaled, (0 pauses, below 1 is slow motion), or advanced by
+ * a fixed step each frame for deterministic runs.
+ */
+class FrameClock {
+  public:
+	FrameClock();
+	virtual ~FrameClock();
+	/**
+	 * @brief Sample the performance counter and advance to the next frame.
+	 */
+	void tick();
+	/**
+	 * @brief Unpause, and discard the wall time since the last tick, (eg after loading a level), so the
+	 * next frame does not include it.
+	 */
+	void resume();
+	/**
+	 * @brief Pause or unpause game time, (the frames still tick).
+	 * @param paused TRUE to pause.
+	 */
+	void setPaused(bool paused);
+	/**
+	 * @brief Determine if game time is paused.
+	 * @return TRUE if paused.
+	 */
+	bool isPaused() const;
+	/**
+	 * @brief Set the rate at which game time passes.
+	 * @param scale The scale, (1 for real time, 0 to pause).
+	 */
+	void setScale(double scale);
+	/**
+	 * @brief Get the rate at which game time passes.
+	 * @return The scale.
+	 */
+	double getScale() const;
+	/**
+	 * @brief Advance by a fixed step each frame rather than by the wall time.
+	 * @param ms The step in milliseconds, (0 to follow the wall time).
+	 */
+	void setFixedStep(double ms);
+	/**
+	 * @brief Get the game time of the current frame.
+	 * @return The time in milliseconds.
+	 */
+	Uint32 getTime() const;
+	/**
+	 * @brief Get the game time since the previous frame.
+	 * @return The time in seconds.
+	 */
+	double getDelta() const;
+	/**
+	 * @brief Get the number of frames ticked.
+	 * @return The frame number.
+	 */
+	Uint64 getFrame() const;
+
+  private:
+	/**
+	 * @brief The performance counter frequency.
+	 */
+	Uint64 frequency;
+	/**
+	 * @brief The performance counter at the last tick.
+	 */
+	Uint64 last;
+	/**
+	 * @brief The game time in milliseconds.
+	 */
+	double time;
+	/**
+	 * @brief The game time since the previous frame in seconds.
+	 */
+	double delta;
+	/**
+	 * @brief The game time scale.
+	 */
+	double scale;
+	/**
+	 * @brief TRUE if game time is paused.
+	 */
+	bool paused;
+	/**
+	 * @brief The fixed step in milliseconds, (0 if following the wall time).
+	 */
+	double fixedStep;
+	/**
+	 * @brief The number of frames ticked.
+	 */
+	Uint64 frame;
+};
+
+#endif /* UTIL_FRAMECLOCK_H */
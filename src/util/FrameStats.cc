@@ -0,0 +1,145 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "FrameStats.h"
+
+#include <algorithm>
+#include <cstdio>
+
+FrameStats::FrameStats() {
+	frequency = SDL_GetPerformanceFrequency();
+	frameLimit = 0;
+	profile = false;
+	reset();
+}
+
+FrameStats::~FrameStats() {
+	if (trace.is_open()) {
+		trace.close();
+	}
+}
+
+void FrameStats::setFrameLimit(int frames) {
+	frameLimit = (frames > 0) ? frames : 0;
+}
+
+void FrameStats::setProfile(bool profile) {
+	this->profile = profile;
+}
+
+bool FrameStats::setTrace(const std::string& file) {
+	trace.open(file, std::ofstream::out);
+	if (!trace.is_open()) {
+		g_warning("%s[%d] : Unable to open trace file %s", __FILE__, __LINE__, file.c_str());
+		return false;
+	}
+	trace << "frame,time_ms,frame_ms" << std::endl;
+	return true;
+}
+
+void FrameStats::reset() {
+	start = 0;
+	last = 0;
+	frames = 0;
+	times.clear();
+	periodTime = 0.0;
+	periodFrames = 0;
+	periodMax = 0.0;
+}
+
+bool FrameStats::isRecording() {
+	return (frameLimit > 0) || profile || trace.is_open();
+}
+
+bool FrameStats::frame() {
+	if (!isRecording()) {
+		return false;
+	}
+	Uint64 now = SDL_GetPerformanceCounter();
+	if (last == 0) {
+		// The first frame only marks the start.
+		start = now;
+		last = now;
+		return false;
+	}
+	double ms = (double)(now - last) * 1000.0 / (double) frequency;
+	last = now;
+	frames++;
+	times.push_back(ms);
+
+	if (trace.is_open()) {
+		trace << frames << "," << ((double)(now - start) * 1000.0 / (double) frequency) << "," << ms << "\n";
+	}
+	if (profile) {
+		periodTime += ms / 1000.0;
+		periodFrames++;
+		periodMax = std::max(periodMax, ms);
+		if (periodTime >= OCCILLO_FRAMESTATS_PROFILE_INTERVAL) {
+			g_message("%s[%d] : %.1f fps, mean %.2f ms, max %.2f ms", __FILE__, __LINE__,
+			          periodFrames / periodTime, (periodTime * 1000.0) / periodFrames, periodMax);
+			periodTime = 0.0;
+			periodFrames = 0;
+			periodMax = 0.0;
+		}
+	}
+	return frames == frameLimit;
+}
+
+bool FrameStats::isLimitReached() {
+	return (frameLimit > 0) && (frames >= frameLimit);
+}
+
+int FrameStats::getFrames() {
+	return frames;
+}
+
+double FrameStats::percentile(const std::vector<double>& sorted, double p) {
+	if (sorted.empty()) {
+		return 0.0;
+	}
+	return sorted[(size_t)(p * (sorted.size() - 1) + 0.5)];
+}
+
+double FrameStats::getMeanFrameTime() {
+	if (frames == 0) {
+		return 0.0;
+	}
+	return ((double)(last - start) * 1000.0 / (double) frequency) / frames;
+}
+
+double FrameStats::getFrameTime(double p) {
+	std::vector<double> sorted(times);
+	std::sort(sorted.begin(), sorted.end());
+	return percentile(sorted, p);
+}
+
+void FrameStats::report() {
+	if (trace.is_open()) {
+		trace.flush();
+	}
+	if (times.empty()) {
+		return;
+	}
+	std::vector<double> sorted(times);
+	std::sort(sorted.begin(), sorted.end());
+	double total = (double)(last - start) / (double) frequency;
+	printf("frames %d, %.2f secs, %.1f fps\n", frames, total, frames / total);
+	printf("frame time (ms)  min %.2f  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f  mean %.2f\n",
+	       sorted.front(), percentile(sorted, 0.5), percentile(sorted, 0.95), percentile(sorted, 0.99),
+	       sorted.back(), getMeanFrameTime());
+}
@@ -0,0 +1,154 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_FRAMESTATS_H
+#define UTIL_FRAMESTATS_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <SDL.h>
+#include <glib.h>
+
+#include "config.h"
+
+/**
+ * @brief The interval in seconds between profile reports.
+ */
+#define OCCILLO_FRAMESTATS_PROFILE_INTERVAL 1.0
+
+/**
+ * @brief Frame time statistics, used for benchmark, profile and trace runs.
+ *
+ * Nothing is recorded unless a frame limit, profiling or tracing has been requested.
+ */
+class FrameStats {
+  public:
+	FrameStats();
+	virtual ~FrameStats();
+	/**
+	 * @brief Set the number of frames after which the run should end.
+	 * @param frames The number of frames, (0 for no limit).
+	 */
+	void setFrameLimit(int frames);
+	/**
+	 * @brief Enable a periodic report of the frame rate and frame times.
+	 * @param profile TRUE to report every OCCILLO_FRAMESTATS_PROFILE_INTERVAL seconds.
+	 */
+	void setProfile(bool profile);
+	/**
+	 * @brief Write the time of every frame to the given file, as CSV.
+	 * @param file The file to write.
+	 * @return TRUE if the file was opened.
+	 */
+	bool setTrace(const std::string& file);
+	/**
+	 * @brief Clear the recorded frames, (eg between scenes of a benchmark).
+	 */
+	void reset();
+	/**
+	 * @brief Record the end of a frame.
+	 * @return TRUE if this frame reached the frame limit.
+	 */
+	bool frame();
+	/**
+	 * @brief Determine if the frame limit has been reached.
+	 * @return TRUE if the limit has been reached.
+	 */
+	bool isLimitReached();
+	/**
+	 * @brief Get the number of frames recorded.
+	 * @return The number of frames.
+	 */
+	int getFrames();
+	/**
+	 * @brief Get the mean frame time.
+	 * @return The mean frame time in ms.
+	 */
+	double getMeanFrameTime();
+	/**
+	 * @brief Get the frame time at the given percentile.
+	 * @param p The percentile, (0.0 - 1.0).
+	 * @return The frame time in ms.
+	 */
+	double getFrameTime(double p);
+	/**
+	 * @brief Print a summary of the recorded frame times to stdout.
+	 */
+	void report();
+
+  private:
+	/**
+	 * @brief The performance counter frequency.
+	 */
+	Uint64 frequency;
+	/**
+	 * @brief The performance counter at the end of the first frame.
+	 */
+	Uint64 start;
+	/**
+	 * @brief The performance counter at the end of the last frame.
+	 */
+	Uint64 last;
+	/**
+	 * @brief The number of frames recorded.
+	 */
+	int frames;
+	/**
+	 * @brief The number of frames after which the run should end, (0 for no limit).
+	 */
+	int frameLimit;
+	/**
+	 * @brief Flag to report periodically.
+	 */
+	bool profile;
+	/**
+	 * @brief The frame times in ms, kept for the summary.
+	 */
+	std::vector<double> times;
+	/**
+	 * @brief The trace output.
+	 */
+	std::ofstream trace;
+	/**
+	 * @brief The time in seconds of the current profile period.
+	 */
+	double periodTime;
+	/**
+	 * @brief The number of frames in the current profile period.
+	 */
+	int periodFrames;
+	/**
+	 * @brief The longest frame in ms in the current profile period.
+	 */
+	double periodMax;
+	/**
+	 * @brief Determine if anything should be recorded.
+	 * @return TRUE if recording.
+	 */
+	bool isRecording();
+	/**
+	 * @brief Get the value at the given percentile of the sorted values.
+	 * @param sorted The sorted values.
+	 * @param p The percentile, (0.0 - 1.0).
+	 * @return The value.
+	 */
+	static double percentile(const std::vector<double>& sorted, double p);
+};
+
+#endif /* UTIL_FRAMESTATS_H */
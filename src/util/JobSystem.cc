@@ -0,0 +1,364 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cstdint>
+
+std::vector<JobSystem::Worker*> JobSystem::workers;
+std::deque<JobTask> JobSystem::background;
+SDL_SpinLock JobSystem::backgroundLock = 0;
+std::deque<JobTask> JobSystem::mainJobs;
+SDL_SpinLock JobSystem::mainLock = 0;
+SDL_mutex* JobSystem::sleepLock = nullptr;
+SDL_cond* JobSystem::wake = nullptr;
+SDL_cond* JobSystem::finished = nullptr;
+SDL_atomic_t JobSystem::queued = { 0 };
+SDL_atomic_t JobSystem::nextWorker = { 0 };
+SDL_atomic_t JobSystem::stopping = { 0 };
+SDL_threadID JobSystem::mainThread = 0;
+JobTimingHook JobSystem::hook = nullptr;
+
+/**
+ * @brief The index of the worker on this thread, (-1 outside the pool).
+ */
+static thread_local int currentWorker = -1;
+
+JobGroup::JobGroup() {
+	SDL_AtomicSet(&pending, 0);
+	lock = 0;
+	next.function = nullptr;
+	next.data = nullptr;
+	next.group = nullptr;
+	next.name = nullptr;
+	next.affinity = JOB_ANY;
+}
+
+JobGroup::~JobGroup() {
+	JobSystem::wait(this);
+}
+
+bool JobGroup::isDone() {
+	if (SDL_AtomicGet(&pending) != 0) {
+		return false;
+	}
+	// The last job releases the lock after its count, so once it is taken that job is done with the group.
+	SDL_AtomicLock(&lock);
+	SDL_AtomicUnlock(&lock);
+	return true;
+}
+
+bool JobSystem::init(int workers) {
+	if (!JobSystem::workers.empty()) {
+		return true;
+	}
+	mainThread = SDL_ThreadID();
+	if (workers <= 0) {
+		workers = SDL_GetCPUCount() - 1;
+	}
+	workers = std::max(std::min(workers, OCCILLO_JOBSYSTEM_MAX_WORKERS), 1);
+	sleepLock = SDL_CreateMutex();
+	wake = SDL_CreateCond();
+	finished = SDL_CreateCond();
+	if ((sleepLock == nullptr) || (wake == nullptr) || (finished == nullptr)) {
+		g_warning("%s[%d] : Unable to create the job system locks: %s", __FILE__, __LINE__, SDL_GetError());
+		shutdown();
+		return false;
+	}
+	SDL_AtomicSet(&stopping, 0);
+	for (int i = 0; i < workers; i++) {
+		JobSystem::workers.push_back(new Worker());
+		JobSystem::workers[i]->lock = 0;
+		JobSystem::workers[i]->thread = nullptr;
+	}
+	for (int i = 0; i < workers; i++) {
+		JobSystem::workers[i]->thread = SDL_CreateThread(workerThread, "worker", (void*)(intptr_t) i);
+		if (JobSystem::workers[i]->thread == nullptr) {
+			// The other workers steal from this deque, so it still empties.
+			g_warning("%s[%d] : Unable to start worker thread %d: %s", __FILE__, __LINE__, i, SDL_GetError());
+		}
+	}
+	g_info("%s[%d] : Job system started with %d workers", __FILE__, __LINE__, workers);
+	return true;
+}
+
+void JobSystem::shutdown() {
+	if (!workers.empty()) {
+		SDL_LockMutex(sleepLock);
+		SDL_AtomicSet(&stopping, 1);
+		SDL_CondBroadcast(wake);
+		SDL_UnlockMutex(sleepLock);
+		for (Worker* worker : workers) {
+			if (worker->thread != nullptr) {
+				SDL_WaitThread(worker->thread, nullptr);
+			}
+		}
+		// Anything left, (eg all threads failed to start), is run here.
+		JobTask task;
+		while (take(-1, task, true)) {
+			execute(task, -1);
+		}
+		for (Worker* worker : workers) {
+			delete worker;
+		}
+		workers.clear();
+	}
+	runMain();
+	if (finished != nullptr) {
+		SDL_DestroyCond(finished);
+		finished = nullptr;
+	}
+	if (wake != nullptr) {
+		SDL_DestroyCond(wake);
+		wake = nullptr;
+	}
+	if (sleepLock != nullptr) {
+		SDL_DestroyMutex(sleepLock);
+		sleepLock = nullptr;
+	}
+}
+
+int JobSystem::getWorkerCount() {
+	return workers.size();
+}
+
+bool JobSystem::isMainThread() {
+	return (mainThread == 0) || (SDL_ThreadID() == mainThread);
+}
+
+void JobSystem::setTimingHook(JobTimingHook hook) {
+	JobSystem::hook = hook;
+}
+
+void JobSystem::submit(JobGroup* group, JobFunction function, void* data, const char* name, JobAffinity affinity) {
+	JobTask task;
+	task.function = function;
+	task.data = data;
+	task.group = group;
+	task.name = name;
+	task.affinity = affinity;
+	if (group != nullptr) {
+		SDL_AtomicAdd(&group->pending, 1);
+	}
+	queue(task);
+}
+
+void JobSystem::then(JobGroup* group, JobFunction function, void* data, const char* name, JobAffinity affinity) {
+	SDL_AtomicLock(&group->lock);
+	group->next.function = function;
+	group->next.data = data;
+	group->next.group = group;
+	group->next.name = name;
+	group->next.affinity = affinity;
+	SDL_AtomicUnlock(&group->lock);
+	// Hold the group open while setting the continuation, then release it as if a job had run.
+	SDL_AtomicAdd(&group->pending, 1);
+	complete(group);
+}
+
+void JobSystem::queue(const JobTask& task) {
+	if (workers.empty()) {
+		// Not started, so run it here, (main thread jobs wait for the main thread).
+		if ((task.affinity == JOB_MAIN) && !isMainThread()) {
+			SDL_AtomicLock(&mainLock);
+			mainJobs.push_back(task);
+			SDL_AtomicUnlock(&mainLock);
+		} else {
+			execute(task, -1);
+		}
+		return;
+	}
+	switch (task.affinity) {
+	case JOB_MAIN:
+		SDL_AtomicLock(&mainLock);
+		mainJobs.push_back(task);
+		SDL_AtomicUnlock(&mainLock);
+		// Wake anything waiting on the main thread.
+		SDL_LockMutex(sleepLock);
+		SDL_CondBroadcast(finished);
+		SDL_UnlockMutex(sleepLock);
+		return;
+	case JOB_BACKGROUND:
+		SDL_AtomicLock(&backgroundLock);
+		background.push_back(task);
+		SDL_AtomicUnlock(&backgroundLock);
+		break;
+	case JOB_ANY: {
+		int index = currentWorker;
+		if (index < 0) {
+			index = (unsigned int) SDL_AtomicAdd(&nextWorker, 1) % workers.size();
+		}
+		Worker* worker = workers[index];
+		SDL_AtomicLock(&worker->lock);
+		worker->jobs.push_back(task);
+		SDL_AtomicUnlock(&worker->lock);
+		break;
+	}
+	}
+	SDL_AtomicAdd(&queued, 1);
+	SDL_LockMutex(sleepLock);
+	SDL_CondSignal(wake);
+	SDL_UnlockMutex(sleepLock);
+}
+
+bool JobSystem::take(int index, JobTask& task, bool idle) {
+	const int count = workers.size();
+	if (index >= 0) {
+		// Our own newest job first, (its data is most likely still in cache).
+		Worker* worker = workers[index];
+		SDL_AtomicLock(&worker->lock);
+		if (!worker->jobs.empty()) {
+			task = worker->jobs.back();
+			worker->jobs.pop_back();
+			SDL_AtomicUnlock(&worker->lock);
+			SDL_AtomicAdd(&queued, -1);
+			return true;
+		}
+		SDL_AtomicUnlock(&worker->lock);
+	}
+	// Steal the oldest job of another worker.
+	const int start = (index >= 0) ? (index + 1) : 0;
+	for (int i = 0; i < count; i++) {
+		Worker* victim = workers[(start + i) % count];
+		SDL_AtomicLock(&victim->lock);
+		if (!victim->jobs.empty()) {
+			task = victim->jobs.front();
+			victim->jobs.pop_front();
+			SDL_AtomicUnlock(&victim->lock);
+			SDL_AtomicAdd(&queued, -1);
+			return true;
+		}
+		SDL_AtomicUnlock(&victim->lock);
+	}
+	if (idle) {
+		SDL_AtomicLock(&backgroundLock);
+		if (!background.empty()) {
+			task = background.front();
+			background.pop_front();
+			SDL_AtomicUnlock(&backgroundLock);
+			SDL_AtomicAdd(&queued, -1);
+			return true;
+		}
+		SDL_AtomicUnlock(&backgroundLock);
+	}
+	return false;
+}
+
+void JobSystem::execute(const JobTask& task, int index) {
+	if (hook != nullptr) {
+		Uint64 start = SDL_GetPerformanceCounter();
+		task.function(task.data);
+		hook(task.name, index, start, SDL_GetPerformanceCounter());
+	} else {
+		task.function(task.data);
+	}
+	complete(task.group);
+}
+
+void JobSystem::complete(JobGroup* group) {
+	if (group == nullptr) {
+		return;
+	}
+	// Counted down under the lock, so a continuation set meanwhile is not missed by two jobs finishing
+	// together. Waiters take the lock once the count reaches 0, so the group may be destroyed as soon as
+	// it is released.
+	SDL_AtomicLock(&group->lock);
+	if ((group->next.function != nullptr) && (SDL_AtomicGet(&group->pending) == 1)) {
+		JobTask next = group->next;
+		group->next.function = nullptr;
+		SDL_AtomicUnlock(&group->lock);
+		// The continuation is part of the group, so waiting on the group waits for it too. It takes over
+		// the count of this job, so the group is never seen as done before it has run.
+		queue(next);
+		return;
+	}
+	const bool last = (SDL_AtomicAdd(&group->pending, -1) == 1);
+	SDL_AtomicUnlock(&group->lock);
+	if (last && (sleepLock != nullptr)) {
+		SDL_LockMutex(sleepLock);
+		SDL_CondBroadcast(finished);
+		SDL_UnlockMutex(sleepLock);
+	}
+}
+
+void JobSystem::wait(JobGroup* group) {
+	if (group == nullptr) {
+		return;
+	}
+	const bool main = isMainThread();
+	while (SDL_AtomicGet(&group->pending) > 0) {
+		if (main) {
+			runMain();
+		}
+		JobTask task;
+		if (take(currentWorker, task, false)) {
+			execute(task, currentWorker);
+			continue;
+		}
+		if (sleepLock == nullptr) {
+			// Not started, so only main thread jobs can be outstanding.
+			SDL_Delay(1);
+			continue;
+		}
+		SDL_LockMutex(sleepLock);
+		if (SDL_AtomicGet(&group->pending) > 0) {
+			// Timed, as jobs queued meanwhile do not signal waiters.
+			SDL_CondWaitTimeout(finished, sleepLock, 1);
+		}
+		SDL_UnlockMutex(sleepLock);
+	}
+	// Until the last job has released the group, (see complete()).
+	group->isDone();
+}
+
+void JobSystem::runMain() {
+	while (true) {
+		SDL_AtomicLock(&mainLock);
+		if (mainJobs.empty()) {
+			SDL_AtomicUnlock(&mainLock);
+			return;
+		}
+		JobTask task = mainJobs.front();
+		mainJobs.pop_front();
+		SDL_AtomicUnlock(&mainLock);
+		execute(task, -1);
+	}
+}
+
+int JobSystem::workerThread(void* data) {
+	const int index = (int)(intptr_t) data;
+	currentWorker = index;
+	while (true) {
+		JobTask task;
+		if (take(index, task, true)) {
+			execute(task, index);
+			continue;
+		}
+		SDL_LockMutex(sleepLock);
+		if (SDL_AtomicGet(&queued) == 0) {
+			if (SDL_AtomicGet(&stopping) != 0) {
+				SDL_UnlockMutex(sleepLock);
+				break;
+			}
+			SDL_CondWait(wake, sleepLock);
+		}
+		SDL_UnlockMutex(sleepLock);
+	}
+	return 0;
+}
@@ -0,0 +1,288 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_JOBSYSTEM_H
+#define UTIL_JOBSYSTEM_H
+
+#include "config.h"
+
+#include <deque>
+#include <vector>
+#include <SDL.h>
+#include <glib.h>
+
+/**
+ * @brief The largest number of worker threads.
+ */
+#define OCCILLO_JOBSYSTEM_MAX_WORKERS 64
+
+/**
+ * @brief A job entry point.
+ * @param data The job data.
+ */
+typedef void (*JobFunction)(void* data);
+
+/**
+ * @brief A hook called after each job with its timing, (on the thread that ran the job).
+ * @param name The job name.
+ * @param worker The worker index, (-1 for a thread outside the pool, eg the main thread).
+ * @param start The performance counter at the start of the job.
+ * @param end The performance counter at the end of the job.
+ */
+typedef void (*JobTimingHook)(const char* name, int worker, Uint64 start, Uint64 end);
+
+/**
+ * @brief Where a job may run.
+ */
+enum JobAffinity {
+	JOB_ANY,        /**< Any worker, or a thread waiting on a group. */
+	JOB_MAIN,       /**< The main thread only, (eg SDL renderer calls), run by JobSystem::runMain(). */
+	JOB_BACKGROUND  /**< Workers only, when idle, (long jobs that a waiting thread should not pick up). */
+};
+
+class JobGroup;
+
+/**
+ * @brief A queued job.
+ */
+struct JobTask {
+	/**
+	 * @brief The entry point.
+	 */
+	JobFunction function;
+	/**
+	 * @brief The job data.
+	 */
+	void* data;
+	/**
+	 * @brief The group, (or nullptr).
+	 */
+	JobGroup* group;
+	/**
+	 * @brief The job name, (for the timing hook).
+	 */
+	const char* name;
+	/**
+	 * @brief Where the job may run.
+	 */
+	JobAffinity affinity;
+};
+
+/**
+ * @brief A set of jobs that can be waited on together, with an optional continuation.
+ *
+ * The group must outlive its jobs, (the destructor waits for them).
+ */
+class JobGroup {
+  public:
+	JobGroup();
+	/**
+	 * @brief Wait for the jobs of the group.
+	 */
+	virtual ~JobGroup();
+	/**
+	 * @brief Determine if all jobs of the group, (and its continuation), have run.
+	 * @return TRUE if done.
+	 */
+	bool isDone();
+
+  private:
+	friend class JobSystem;
+	/**
+	 * @brief The number of jobs submitted and not yet run.
+	 */
+	SDL_atomic_t pending;
+	/**
+	 * @brief Lock for the continuation and the count of the last job, (held by complete() until it is done
+	 * with the group).
+	 */
+	SDL_SpinLock lock;
+	/**
+	 * @brief The job to submit once the others have run, (function nullptr for none).
+	 */
+	JobTask next;
+};
+
+/**
+ * @brief A work stealing thread pool for engine wide parallel work.
+ *
+ * Each worker has its own deque of jobs, running its own jobs newest first and stealing the oldest
+ * from the other workers when it runs out. A thread waiting on a group runs queued jobs while it waits,
+ * so groups may be waited on from within jobs. Until started, (and with no workers), jobs run on
+ * the submitting thread as they are submitted.
+ */
+class JobSystem {
+  public:
+	/**
+	 * @brief Start the worker threads, (from the main thread).
+	 * @param workers The number of workers, (0 for one less than the number of CPUs).
+	 * @return TRUE if started.
+	 */
+	static bool init(int workers);
+	/**
+	 * @brief Run any remaining jobs and stop the worker threads.
+	 */
+	static void shutdown();
+	/**
+	 * @brief Get the number of worker threads.
+	 * @return The number of workers, (0 if not started).
+	 */
+	static int getWorkerCount();
+	/**
+	 * @brief Submit a job.
+	 * @param group The group to add the job to, (or nullptr).
+	 * @param function The entry point.
+	 * @param data The job data.
+	 * @param name The job name, (for the timing hook).
+	 * @param affinity Where the job may run.
+	 */
+	static void submit(JobGroup* group, JobFunction function, void* data, const char* name = "job",
+	                   JobAffinity affinity = JOB_ANY);
+	/**
+	 * @brief Submit a job to the group once all jobs submitted to it so far have run.
+	 * @param group The group.
+	 * @param function The entry point.
+	 * @param data The job data.
+	 * @param name The job name, (for the timing hook).
+	 * @param affinity Where the job may run.
+	 */
+	static void then(JobGroup* group, JobFunction function, void* data, const char* name = "continuation",
+	                 JobAffinity affinity = JOB_ANY);
+	/**
+	 * @brief Wait for all jobs of the group, running queued jobs meanwhile.
+	 * @param group The group.
+	 */
+	static void wait(JobGroup* group);
+	/**
+	 * @brief Run the jobs queued for the main thread, (the display calls this once a frame).
+	 */
+	static void runMain();
+	/**
+	 * @brief Determine if called on the main thread.
+	 * @return TRUE if the main thread.
+	 */
+	static bool isMainThread();
+	/**
+	 * @brief Set the hook called with the timing of each job, (set before init()).
+	 * @param hook The hook, (or nullptr for none).
+	 */
+	static void setTimingHook(JobTimingHook hook);
+
+  private:
+	/**
+	 * @brief A worker thread and its deque.
+	 */
+	struct Worker {
+		/**
+		 * @brief The thread.
+		 */
+		SDL_Thread* thread;
+		/**
+		 * @brief The jobs, (the worker takes from the back, thieves from the front).
+		 */
+		std::deque<JobTask> jobs;
+		/**
+		 * @brief Lock for the jobs.
+		 */
+		SDL_SpinLock lock;
+	};
+	/**
+	 * @brief The workers.
+	 */
+	static std::vector<Worker*> workers;
+	/**
+	 * @brief The background jobs.
+	 */
+	static std::deque<JobTask> background;
+	/**
+	 * @brief Lock for the background jobs.
+	 */
+	static SDL_SpinLock backgroundLock;
+	/**
+	 * @brief The main thread jobs.
+	 */
+	static std::deque<JobTask> mainJobs;
+	/**
+	 * @brief Lock for the main thread jobs.
+	 */
+	static SDL_SpinLock mainLock;
+	/**
+	 * @brief Lock for sleeping and waiting.
+	 */
+	static SDL_mutex* sleepLock;
+	/**
+	 * @brief Signalled when a job is queued.
+	 */
+	static SDL_cond* wake;
+	/**
+	 * @brief Signalled when a group finishes.
+	 */
+	static SDL_cond* finished;
+	/**
+	 * @brief The number of jobs queued for the workers.
+	 */
+	static SDL_atomic_t queued;
+	/**
+	 * @brief The worker to queue the next job from outside the pool to.
+	 */
+	static SDL_atomic_t nextWorker;
+	/**
+	 * @brief Non zero to stop the workers once the queues are empty.
+	 */
+	static SDL_atomic_t stopping;
+	/**
+	 * @brief The main thread.
+	 */
+	static SDL_threadID mainThread;
+	/**
+	 * @brief The timing hook.
+	 */
+	static JobTimingHook hook;
+	/**
+	 * @brief Take a job to run.
+	 * @param index The worker taking the job, (-1 for a thread outside the pool).
+	 * @param task The job taken.
+	 * @param idle TRUE to also take background jobs.
+	 * @return TRUE if a job was taken.
+	 */
+	static bool take(int index, JobTask& task, bool idle);
+	/**
+	 * @brief Run the given job and complete it.
+	 * @param task The job.
+	 * @param index The worker running the job, (-1 for a thread outside the pool).
+	 */
+	static void execute(const JobTask& task, int index);
+	/**
+	 * @brief Mark a job of the given group as run, submitting its continuation if the last.
+	 * @param group The group, (or nullptr).
+	 */
+	static void complete(JobGroup* group);
+	/**
+	 * @brief Queue a job.
+	 * @param task The job.
+	 */
+	static void queue(const JobTask& task);
+	/**
+	 * @brief The worker thread.
+	 * @param data The worker index.
+	 * @return 0.
+	 */
+	static int workerThread(void* data);
+};
+
+#endif /* UTIL_JOBSYSTEM_H */
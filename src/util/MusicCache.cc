@@ -0,0 +1,264 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "MusicCache.h"
+
+#include <cstdio>
+
+MusicCache::MusicCache() {
+	persistent = false;
+	rendering = false;
+	decoding = false;
+	deferred = nullptr;
+	deferredLoops = 0;
+	lock = SDL_CreateMutex();
+}
+
+MusicCache::~MusicCache() {
+	clear();
+	if (lock != nullptr) {
+		SDL_DestroyMutex(lock);
+		lock = nullptr;
+	}
+}
+
+void MusicCache::setPersistent(bool persist) {
+	persistent = persist;
+}
+
+Mix_Music* MusicCache::load(const std::string& path) {
+	if (!persistent || lock == nullptr) {
+		return loadMusic(path);
+	}
+	std::string file = getCacheFile(path);
+	if (file.empty()) {
+		return loadMusic(path);
+	}
+	if (g_file_test(file.c_str(), G_FILE_TEST_IS_REGULAR)) {
+		Mix_Music* music = Mix_LoadMUS(file.c_str());
+		if (music != nullptr) {
+			g_info("%s[%d] : Playing rendered music %s", __FILE__, __LINE__, file.c_str());
+			return music;
+		}
+	}
+	// Play the track as is, and render it for next time, (once the music is halted).
+	SDL_LockMutex(lock);
+	if (queued.find(file) == queued.end()) {
+		queued.insert(file);
+		pending.push_back({ path, file });
+	}
+	SDL_UnlockMutex(lock);
+	return loadMusic(path);
+}
+
+void MusicCache::play(Mix_Music* music, int loops) {
+	if (lock == nullptr) {
+		Mix_HaltMusic();
+		Mix_PlayMusic(music, loops);
+		return;
+	}
+	// Under the lock, so a render can't start between the check and the music starting.
+	SDL_LockMutex(lock);
+	Mix_HaltMusic();
+	if (decoding) {
+		g_info("%s[%d] : Holding music until the current render finishes", __FILE__, __LINE__);
+		deferred = music;
+		deferredLoops = loops;
+	} else {
+		deferred = nullptr;
+		Mix_PlayMusic(music, loops);
+	}
+	SDL_UnlockMutex(lock);
+}
+
+void MusicCache::halt() {
+	if (lock == nullptr) {
+		Mix_HaltMusic();
+		return;
+	}
+	bool start = false;
+	SDL_LockMutex(lock);
+	Mix_HaltMusic();
+	deferred = nullptr;
+	if (!pending.empty() && !rendering) {
+		rendering = true;
+		start = true;
+	}
+	SDL_UnlockMutex(lock);
+	if (start) {
+		// A background job, as rendering a track takes far longer than a frame.
+		JobSystem::submit(&renders, renderWorker, this, "musiccache", JOB_BACKGROUND);
+	}
+}
+
+Mix_Music* MusicCache::loadMusic(const std::string& path) {
+	SDL_RWops* packed = ResourcePack::openRW(path);
+	return (packed != nullptr) ? Mix_LoadMUS_RW(packed, 1) : Mix_LoadMUS(path.c_str());
+}
+
+void MusicCache::renderWorker(void* data) {
+	static_cast<MusicCache*>(data)->renderPending();
+}
+
+void MusicCache::renderPending() {
+	while (true) {
+		SDL_LockMutex(lock);
+		// Left queued if music has started, until it is next halted.
+		if (pending.empty() || Mix_PlayingMusic() != 0) {
+			rendering = false;
+			SDL_UnlockMutex(lock);
+			return;
+		}
+		Render render = pending.front();
+		pending.pop_front();
+		decoding = true;
+		SDL_UnlockMutex(lock);
+
+		SDL_RWops* packed = ResourcePack::openRW(render.path);
+		Mix_Chunk* chunk = (packed != nullptr) ? Mix_LoadWAV_RW(packed, 1) : Mix_LoadWAV(render.path.c_str());
+
+		// Start any music held back by the decode.
+		SDL_LockMutex(lock);
+		decoding = false;
+		if (deferred != nullptr) {
+			Mix_PlayMusic(deferred, deferredLoops);
+			deferred = nullptr;
+		}
+		SDL_UnlockMutex(lock);
+
+		if (chunk == nullptr) {
+			// Left in the queued set, so it is not tried again this run.
+			g_info("%s[%d] : Unable to render music %s: %s", __FILE__, __LINE__, render.path.c_str(), Mix_GetError());
+			continue;
+		}
+		if (storeWAV(render.file, chunk)) {
+			g_info("%s[%d] : Rendered music %s to %s", __FILE__, __LINE__, render.path.c_str(), render.file.c_str());
+		}
+		Mix_FreeChunk(chunk);
+	}
+}
+
+void MusicCache::clear() {
+	if (lock == nullptr) {
+		return;
+	}
+	SDL_LockMutex(lock);
+	pending.clear();
+	deferred = nullptr;
+	SDL_UnlockMutex(lock);
+	JobSystem::wait(&renders);
+	SDL_LockMutex(lock);
+	rendering = false;
+	deferred = nullptr;
+	queued.clear();
+	SDL_UnlockMutex(lock);
+}
+
+std::string MusicCache::getCacheFile(const std::string& path) {
+	int frequency = 0;
+	Uint16 format = 0;
+	int channels = 0;
+	if (Mix_QuerySpec(&frequency, &format, &channels) == 0) {
+		return "";
+	}
+	char key[100];
+	const char* data = nullptr;
+	size_t size = 0;
+	struct stat info;
+	if (ResourcePack::find(path, &data, &size)) {
+		// A packed track has no modification time, so use its contents.
+		gchar* hash = g_compute_checksum_for_data(G_CHECKSUM_SHA1, (const guchar*) data, size);
+		std::snprintf(key, sizeof(key), ":%s:%d:%u:%d", hash, frequency, (unsigned int) format, channels);
+		g_free(hash);
+	} else if (stat(path.c_str(), &info) == 0) {
+		std::snprintf(key, sizeof(key), ":%ld:%ld:%d:%u:%d", (long) info.st_size, (long) info.st_mtime,
+		              frequency, (unsigned int) format, channels);
+	} else {
+		return "";
+	}
+	std::string name = path + key;
+	gchar* hash = g_compute_checksum_for_string(G_CHECKSUM_SHA1, name.c_str(), -1);
+	std::string wavName = std::string(hash) + ".wav";
+	g_free(hash);
+	gchar* file = g_build_filename(g_get_user_cache_dir(), PACKAGE_NAME, OCCILLO_MUSICCACHE_DIR, wavName.c_str(), nullptr);
+	std::string result(file);
+	g_free(file);
+	return result;
+}
+
+/**
+ * @brief Write a little endian value to the given buffer.
+ * @param buffer The buffer.
+ * @param value The value.
+ * @param bytes The size of the value in bytes.
+ */
+static void putLE(Uint8* buffer, Uint32 value, int bytes) {
+	for (int i = 0; i < bytes; i++) {
+		buffer[i] = (Uint8)(value >> (i * 8));
+	}
+}
+
+bool MusicCache::storeWAV(const std::string& file, Mix_Chunk* chunk) {
+	int frequency = 0;
+	Uint16 format = 0;
+	int channels = 0;
+	if (Mix_QuerySpec(&frequency, &format, &channels) == 0) {
+		return false;
+	}
+	int bits = SDL_AUDIO_BITSIZE(format);
+	// WAV holds unsigned 8 bit samples, and signed little endian integer or float samples otherwise.
+	bool valid = (bits == 8) ? !SDL_AUDIO_ISSIGNED(format)
+	             : (SDL_AUDIO_ISSIGNED(format) && !SDL_AUDIO_ISBIGENDIAN(format));
+	if (!valid) {
+		g_info("%s[%d] : Mixer format 0x%04x can't be stored as WAV", __FILE__, __LINE__, (unsigned int) format);
+		return false;
+	}
+	int blockAlign = channels * (bits / 8);
+	Uint8 header[44];
+	SDL_memcpy(header, "RIFF", 4);
+	putLE(header + 4, 36 + chunk->alen, 4);
+	SDL_memcpy(header + 8, "WAVEfmt ", 8);
+	putLE(header + 16, 16, 4);
+	putLE(header + 20, SDL_AUDIO_ISFLOAT(format) ? 3 : 1, 2);
+	putLE(header + 22, channels, 2);
+	putLE(header + 24, frequency, 4);
+	putLE(header + 28, frequency * blockAlign, 4);
+	putLE(header + 32, blockAlign, 2);
+	putLE(header + 34, bits, 2);
+	SDL_memcpy(header + 36, "data", 4);
+	putLE(header + 40, chunk->alen, 4);
+
+	gchar* dir = g_path_get_dirname(file.c_str());
+	g_mkdir_with_parents(dir, 0755);
+	g_free(dir);
+	std::string temp = file + ".tmp";
+	FILE* out = std::fopen(temp.c_str(), "wb");
+	if (out == nullptr) {
+		g_info("%s[%d] : Unable to write rendered music %s", __FILE__, __LINE__, temp.c_str());
+		return false;
+	}
+	bool written = (std::fwrite(header, sizeof(header), 1, out) == 1)
+	               && (std::fwrite(chunk->abuf, chunk->alen, 1, out) == 1);
+	written = (std::fclose(out) == 0) && written;
+	if (!written || std::rename(temp.c_str(), file.c_str()) != 0) {
+		g_info("%s[%d] : Unable to write rendered music %s", __FILE__, __LINE__, file.c_str());
+		std::remove(temp.c_str());
+		return false;
+	}
+	return true;
+}
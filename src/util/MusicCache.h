@@ -0,0 +1,162 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_MUSICCACHE_H
+#define UTIL_MUSICCACHE_H
+
+#include <string>
+#include <deque>
+#include <set>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <glib.h>
+
+#include "config.h"
+#include "ResourcePack.h"
+#include "JobSystem.h"
+
+/**
+ * @brief The sub directory of the user cache directory for rendered music.
+ */
+#define OCCILLO_MUSICCACHE_DIR "music"
+
+/**
+ * @brief Loads music, optionally replacing tracker modules with a copy rendered once to PCM.
+ *
+ * When persistent, the first load of a track plays it as normal and queues it to be rendered to a WAV
+ * file in the user cache directory, keyed by the track and the mixer format. Later loads stream the WAV
+ * file rather than synthesizing the module.
+ *
+ * The module decoders keep global player state, so a render must never overlap music playback. Renders
+ * only start once the music is halted through halt(), and only while no music is playing; music started
+ * through play() during a render is held back until the render finishes. Music loaded from the cache
+ * must therefore be started and stopped through play() and halt(), not Mix_PlayMusic() and Mix_HaltMusic().
+ */
+class MusicCache {
+  public:
+	MusicCache();
+	virtual ~MusicCache();
+	/**
+	 * @brief Render music to the user cache directory and play the rendered copy on later loads.
+	 * @param persist TRUE to use the rendered copies.
+	 */
+	void setPersistent(bool persist);
+	/**
+	 * @brief Load the given music, (to be freed with Mix_FreeMusic() as usual).
+	 * @param path The resolved path to the music.
+	 * @return The music, or nullptr if it could not be loaded.
+	 */
+	Mix_Music* load(const std::string& path);
+	/**
+	 * @brief Stop any playing music and play the given music, (once the current render has finished).
+	 * @param music The music to play.
+	 * @param loops The number of times to play the music, or -1 to loop forever.
+	 */
+	void play(Mix_Music* music, int loops);
+	/**
+	 * @brief Stop the music, (including music waiting on a render), and render the queued tracks.
+	 */
+	void halt();
+	/**
+	 * @brief Drop the pending renders and wait for the current render to finish, (before SDL_mixer is closed).
+	 */
+	void clear();
+
+  private:
+	/**
+	 * @brief A track waiting to be rendered.
+	 */
+	struct Render {
+		/**
+		 * @brief The path to the track.
+		 */
+		std::string path;
+		/**
+		 * @brief The file to render to.
+		 */
+		std::string file;
+	};
+	/**
+	 * @brief Flag to use the rendered copies.
+	 */
+	bool persistent;
+	/**
+	 * @brief The tracks waiting to be rendered.
+	 */
+	std::deque<Render> pending;
+	/**
+	 * @brief The files queued or being rendered, and those that failed to render.
+	 */
+	std::set<std::string> queued;
+	/**
+	 * @brief The render job.
+	 */
+	JobGroup renders;
+	/**
+	 * @brief TRUE while the render job is taking work from the queue.
+	 */
+	bool rendering;
+	/**
+	 * @brief TRUE while a track is being decoded.
+	 */
+	bool decoding;
+	/**
+	 * @brief The music to play once the current decode has finished, or nullptr.
+	 */
+	Mix_Music* deferred;
+	/**
+	 * @brief The loops for the deferred music.
+	 */
+	int deferredLoops;
+	/**
+	 * @brief Lock for the pending renders, the render state and starting the music.
+	 */
+	SDL_mutex* lock;
+	/**
+	 * @brief The render job entry.
+	 * @param data The music cache.
+	 */
+	static void renderWorker(void* data);
+	/**
+	 * @brief Render the pending tracks until the queue is empty or music is playing.
+	 */
+	void renderPending();
+	/**
+	 * @brief Load the given music as is, (from the resource pack if it is in it).
+	 * @param path The resolved path to the music.
+	 * @return The music, or nullptr if it could not be loaded.
+	 */
+	static Mix_Music* loadMusic(const std::string& path);
+	/**
+	 * @brief Get the file to render the given track to for the current mixer format.
+	 * @param path The path to the track.
+	 * @return The file, or an empty string if the track or mixer format is not available.
+	 */
+	std::string getCacheFile(const std::string& path);
+	/**
+	 * @brief Write the given chunk as a WAV file, (via a temporary file so readers never see a partial file).
+	 * @param file The file to write.
+	 * @param chunk The decoded track, in the mixer format.
+	 * @return TRUE if written.
+	 */
+	static bool storeWAV(const std::string& file, Mix_Chunk* chunk);
+};
+
+#endif /* UTIL_MUSICCACHE_H */
@@ -0,0 +1,431 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "Resampler.h"
+
+#if defined(__SSE2__)
+#define OCCILLO_RESAMPLER_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__)
+// AVX2 kernels are compiled for that target only, and used when the CPU has it.
+#define OCCILLO_RESAMPLER_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+/**
+ * @brief Filter one output pixel from a run of source pixels, (4 channels a pixel).
+ */
+typedef void (*PixelKernel)(Uint16* destination, const Uint16* source, const float* weights, int count);
+/**
+ * @brief Filter one output row from a run of source rows, (stride channels apart).
+ */
+typedef void (*RowKernel)(Uint16* destination, const Uint16* source, int channels, const float* weights, int count);
+
+/**
+ * @brief Clamp and round a filtered channel.
+ * @param value The channel.
+ * @return The channel.
+ */
+static inline Uint16 clampChannel(float value) {
+	long channel = std::lround(value);
+	return (Uint16) std::min(std::max(channel, 0L), 65535L);
+}
+
+static void pixelScalar(Uint16* destination, const Uint16* source, const float* weights, int count) {
+	float channels[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	for (int i = 0; i < count; i++) {
+		for (int c = 0; c < 4; c++) {
+			channels[c] += (float) source[i * 4 + c] * weights[i];
+		}
+	}
+	for (int c = 0; c < 4; c++) {
+		destination[c] = clampChannel(channels[c]);
+	}
+}
+
+static void rowScalar(Uint16* destination, const Uint16* source, int channels, const float* weights, int count) {
+	for (int x = 0; x < channels; x++) {
+		float channel = 0.0f;
+		for (int i = 0; i < count; i++) {
+			channel += (float) source[(size_t) i * channels + x] * weights[i];
+		}
+		destination[x] = clampChannel(channel);
+	}
+}
+
+#ifdef OCCILLO_RESAMPLER_SSE2
+/**
+ * @brief Widen 4 channels to floats.
+ */
+static inline __m128 loadSSE2(const Uint16* channels) {
+	return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*) channels), _mm_setzero_si128()));
+}
+
+/**
+ * @brief Round and saturate 2 sets of 4 float channels back to 16 bits, (SSE2 only packs signed).
+ */
+static inline __m128i packSSE2(__m128 low, __m128 high) {
+	const __m128 limit = _mm_set1_ps(65535.0f);
+	const __m128i bias = _mm_set1_epi32(32768);
+	__m128i l = _mm_sub_epi32(_mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(low, _mm_setzero_ps()), limit)), bias);
+	__m128i h = _mm_sub_epi32(_mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(high, _mm_setzero_ps()), limit)), bias);
+	return _mm_xor_si128(_mm_packs_epi32(l, h), _mm_set1_epi16((short) 0x8000));
+}
+
+static void pixelSSE2(Uint16* destination, const Uint16* source, const float* weights, int count) {
+	__m128 sum = _mm_setzero_ps();
+	for (int i = 0; i < count; i++) {
+		sum = _mm_add_ps(sum, _mm_mul_ps(loadSSE2(source + i * 4), _mm_set1_ps(weights[i])));
+	}
+	_mm_storel_epi64((__m128i*) destination, packSSE2(sum, sum));
+}
+
+static void rowSSE2(Uint16* destination, const Uint16* source, int channels, const float* weights, int count) {
+	const __m128i zero = _mm_setzero_si128();
+	int x = 0;
+	for (; x + 16 <= channels; x += 16) {
+		__m128 sum0 = _mm_setzero_ps();
+		__m128 sum1 = _mm_setzero_ps();
+		__m128 sum2 = _mm_setzero_ps();
+		__m128 sum3 = _mm_setzero_ps();
+		for (int i = 0; i < count; i++) {
+			const Uint16* row = source + (size_t) i * channels + x;
+			__m128 weight = _mm_set1_ps(weights[i]);
+			__m128i low = _mm_loadu_si128((const __m128i*) row);
+			__m128i high = _mm_loadu_si128((const __m128i*)(row + 8));
+			sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), weight));
+			sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), weight));
+			sum2 = _mm_add_ps(sum2, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), weight));
+			sum3 = _mm_add_ps(sum3, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), weight));
+		}
+		_mm_storeu_si128((__m128i*)(destination + x), packSSE2(sum0, sum1));
+		_mm_storeu_si128((__m128i*)(destination + x + 8), packSSE2(sum2, sum3));
+	}
+	for (; x < channels; x++) {
+		float channel = 0.0f;
+		for (int i = 0; i < count; i++) {
+			channel += (float) source[(size_t) i * channels + x] * weights[i];
+		}
+		destination[x] = clampChannel(channel);
+	}
+}
+#endif
+
+#ifdef OCCILLO_RESAMPLER_AVX2
+__attribute__((target("avx2")))
+static void pixelAVX2(Uint16* destination, const Uint16* source, const float* weights, int count) {
+	// Two taps at a time, one in each lane.
+	__m256 sum = _mm256_setzero_ps();
+	int i = 0;
+	for (; i + 2 <= count; i += 2) {
+		__m256 pixels = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(source + i * 4))));
+		__m256 weight = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(weights[i])), _mm_set1_ps(weights[i + 1]), 1);
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(pixels, weight));
+	}
+	__m128 total = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+	if (i < count) {
+		total = _mm_add_ps(total, _mm_mul_ps(loadSSE2(source + i * 4), _mm_set1_ps(weights[i])));
+	}
+	_mm_storel_epi64((__m128i*) destination, packSSE2(total, total));
+}
+
+__attribute__((target("avx2")))
+static void rowAVX2(Uint16* destination, const Uint16* source, int channels, const float* weights, int count) {
+	int x = 0;
+	for (; x + 16 <= channels; x += 16) {
+		__m256 sum0 = _mm256_setzero_ps();
+		__m256 sum1 = _mm256_setzero_ps();
+		for (int i = 0; i < count; i++) {
+			const Uint16* row = source + (size_t) i * channels + x;
+			__m256 weight = _mm256_set1_ps(weights[i]);
+			sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*) row))), weight));
+			sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(row + 8)))), weight));
+		}
+		// The pack works within each lane, so put the quarters back in order.
+		__m256i packed = _mm256_packus_epi32(_mm256_cvtps_epi32(sum0), _mm256_cvtps_epi32(sum1));
+		_mm256_storeu_si256((__m256i*)(destination + x), _mm256_permute4x64_epi64(packed, 0xd8));
+	}
+	// The tail, (the rows are still channels apart).
+	for (; x < channels; x++) {
+		float channel = 0.0f;
+		for (int i = 0; i < count; i++) {
+			channel += (float) source[(size_t) i * channels + x] * weights[i];
+		}
+		destination[x] = clampChannel(channel);
+	}
+}
+#endif
+
+/**
+ * @brief The fastest pixel kernel the CPU supports.
+ */
+static PixelKernel pixelKernel() {
+#ifdef OCCILLO_RESAMPLER_AVX2
+	if (SDL_HasAVX2()) {
+		return pixelAVX2;
+	}
+#endif
+#ifdef OCCILLO_RESAMPLER_SSE2
+	return pixelSSE2;
+#else
+	return pixelScalar;
+#endif
+}
+
+/**
+ * @brief The fastest row kernel the CPU supports.
+ */
+static RowKernel rowKernel() {
+#ifdef OCCILLO_RESAMPLER_AVX2
+	if (SDL_HasAVX2()) {
+		return rowAVX2;
+	}
+#endif
+#ifdef OCCILLO_RESAMPLER_SSE2
+	return rowSSE2;
+#else
+	return rowScalar;
+#endif
+}
+
+SDL_Surface* Resampler::resample(SDL_Surface* source, int width, int height, ResampleFilter filter, bool premultiplied) {
+	return scale(source, width, height, filter, premultiplied, false);
+}
+
+SDL_Surface* Resampler::resampleScalar(SDL_Surface* source, int width, int height, ResampleFilter filter, bool premultiplied) {
+	return scale(source, width, height, filter, premultiplied, true);
+}
+
+SDL_Surface* Resampler::scale(SDL_Surface* source, int width, int height, ResampleFilter filter, bool premultiplied, bool scalar) {
+	if ((source == nullptr) || (width <= 0) || (height <= 0)) {
+		return nullptr;
+	}
+	if (SDL_ISPIXELFORMAT_INDEXED(source->format->format)) {
+		// Rows of palette images can't be converted on their own, so convert the whole image first.
+		SDL_Surface* converted = SDL_ConvertSurfaceFormat(source, SDL_PIXELFORMAT_ARGB8888, 0);
+		if (converted == nullptr) {
+			g_info("%s[%d] : %s", __FILE__, __LINE__, SDL_GetError());
+			return nullptr;
+		}
+		SDL_Surface* resampled = scale(converted, width, height, filter, premultiplied, scalar);
+		SDL_FreeSurface(converted);
+		return resampled;
+	}
+	SDL_Surface* destination = SDL_CreateRGBSurface(0, width, height, 32,
+	                           0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+	if (destination == nullptr) {
+		g_info("%s[%d] : %s", __FILE__, __LINE__, SDL_GetError());
+		return nullptr;
+	}
+	Context context;
+	context.source = source;
+	context.destination = destination;
+	context.premultiplied = premultiplied;
+	context.scalar = scalar;
+	context.intermediate.resize((size_t) width * source->h * 4);
+	calculate(source->w, width, filter, context.horizontal);
+	calculate(source->h, height, filter, context.vertical);
+
+	int parts = std::min(JobSystem::getWorkerCount() + 1, OCCILLO_RESAMPLER_MAX_PARTS);
+	parts = std::max(std::min(parts, (width * height) / OCCILLO_RESAMPLER_PART_PIXELS), 1);
+	g_info("%s[%d] : Resampling %d x %d to %d x %d in %d parts", __FILE__, __LINE__,
+	       source->w, source->h, width, height, parts);
+
+	SDL_LockSurface(source);
+	run(&context, false, source->h, parts);
+	SDL_UnlockSurface(source);
+	run(&context, true, height, parts);
+	return destination;
+}
+
+double Resampler::kernel(ResampleFilter filter, double x) {
+	x = std::fabs(x);
+	switch (filter) {
+		case RESAMPLE_AREA:
+			return (x <= 0.5) ? 1.0 : 0.0;
+		case RESAMPLE_BILINEAR:
+			return (x < 1.0) ? (1.0 - x) : 0.0;
+		case RESAMPLE_LANCZOS:
+			if (x < 1e-8) {
+				return 1.0;
+			}
+			if (x >= OCCILLO_RESAMPLER_LANCZOS_SUPPORT) {
+				return 0.0;
+			}
+			x *= M_PI;
+			return (OCCILLO_RESAMPLER_LANCZOS_SUPPORT * std::sin(x) * std::sin(x / OCCILLO_RESAMPLER_LANCZOS_SUPPORT)) / (x * x);
+	}
+	return 0.0;
+}
+
+double Resampler::support(ResampleFilter filter) {
+	switch (filter) {
+		case RESAMPLE_AREA:
+			return 0.5;
+		case RESAMPLE_BILINEAR:
+			return 1.0;
+		case RESAMPLE_LANCZOS:
+			return OCCILLO_RESAMPLER_LANCZOS_SUPPORT;
+	}
+	return 1.0;
+}
+
+void Resampler::calculate(int in, int out, ResampleFilter filter, Coefficients& coefficients) {
+	double scale = (double) in / (double) out;
+	// Widen the filter when downscaling, so it covers every source pixel.
+	double filterScale = std::max(scale, 1.0);
+	double reach = support(filter) * filterScale;
+	coefficients.taps = (int) std::ceil(reach) * 2 + 1;
+	coefficients.start.resize(out);
+	coefficients.count.resize(out);
+	coefficients.weights.assign((size_t) out * coefficients.taps, 0.0f);
+	for (int i = 0; i < out; i++) {
+		double centre = (i + 0.5) * scale;
+		int first = std::max((int)(centre - reach + 0.5), 0);
+		int last = std::min((int)(centre + reach + 0.5), in);
+		int count = std::min(std::max(last - first, 1), coefficients.taps);
+		first = std::min(first, in - count);
+		float* weights = &coefficients.weights[(size_t) i * coefficients.taps];
+		double total = 0.0;
+		for (int j = 0; j < count; j++) {
+			double weight = kernel(filter, (first + j - centre + 0.5) / filterScale);
+			weights[j] = (float) weight;
+			total += weight;
+		}
+		if (total != 0.0) {
+			for (int j = 0; j < count; j++) {
+				weights[j] = (float)(weights[j] / total);
+			}
+		} else {
+			// Nothing in reach, (only for a degenerate scale), so take the nearest pixel.
+			count = 1;
+			first = std::min((int) centre, in - 1);
+			weights[0] = 1.0f;
+		}
+		coefficients.start[i] = first;
+		coefficients.count[i] = count;
+	}
+}
+
+void Resampler::run(Context* context, bool vertical, int rows, int parts) {
+	parts = std::min(parts, rows);
+	std::vector<Job> jobs(parts);
+	for (int i = 0; i < parts; i++) {
+		jobs[i].context = context;
+		jobs[i].vertical = vertical;
+		jobs[i].first = (int)(((long long) rows * i) / parts);
+		jobs[i].last = (int)(((long long) rows * (i + 1)) / parts);
+	}
+	// The calling thread takes the first range, then helps with the rest while it waits.
+	JobGroup group;
+	for (int i = 1; i < parts; i++) {
+		JobSystem::submit(&group, worker, &jobs[i], "resample");
+	}
+	worker(&jobs[0]);
+	JobSystem::wait(&group);
+}
+
+void Resampler::worker(void* data) {
+	Job* job = (Job*) data;
+	if (job->vertical) {
+		verticalRows(job->context, job->first, job->last);
+	} else {
+		horizontalRows(job->context, job->first, job->last);
+	}
+}
+
+void Resampler::horizontalRows(Context* context, int first, int last) {
+	static const PixelKernel fastest = pixelKernel();
+	const PixelKernel filterPixel = context->scalar ? pixelScalar : fastest;
+	SDL_Surface* source = context->source;
+	const Coefficients& coefficients = context->horizontal;
+	int width = context->destination->w;
+	std::vector<Uint32> row(source->w);
+	std::vector<Uint16> channels((size_t) source->w * 4);
+	for (int y = first; y < last; y++) {
+		// Read the row in the native format and convert it as it is filtered.
+		const Uint8* pixels = (const Uint8*) source->pixels + (size_t) y * source->pitch;
+		SDL_ConvertPixels(source->w, 1, source->format->format, pixels, source->pitch,
+		                  SDL_PIXELFORMAT_ARGB8888, &row[0], source->w * 4);
+		premultiply(&row[0], &channels[0], source->w);
+		Uint16* output = &context->intermediate[(size_t) y * width * 4];
+		for (int x = 0; x < width; x++) {
+			filterPixel(output + x * 4, &channels[(size_t) coefficients.start[x] * 4],
+			            &coefficients.weights[(size_t) x * coefficients.taps], coefficients.count[x]);
+		}
+	}
+}
+
+void Resampler::verticalRows(Context* context, int first, int last) {
+	static const RowKernel fastest = rowKernel();
+	const RowKernel filterRow = context->scalar ? rowScalar : fastest;
+	SDL_Surface* destination = context->destination;
+	const Coefficients& coefficients = context->vertical;
+	int width = destination->w;
+	std::vector<Uint16> channels((size_t) width * 4);
+	for (int y = first; y < last; y++) {
+		filterRow(&channels[0], &context->intermediate[(size_t) coefficients.start[y] * width * 4], width * 4,
+		          &coefficients.weights[(size_t) y * coefficients.taps], coefficients.count[y]);
+		Uint32* output = (Uint32*)((Uint8*) destination->pixels + (size_t) y * destination->pitch);
+		if (context->premultiplied) {
+			narrow(&channels[0], output, width);
+		} else {
+			unpremultiply(&channels[0], output, width);
+		}
+	}
+}
+
+void Resampler::premultiply(const Uint32* row, Uint16* channels, int width) {
+	for (int x = 0; x < width; x++) {
+		Uint32 pixel = row[x];
+		Uint32 alpha = pixel >> 24;
+		// Scale to 16 bits, (x 257), as the alpha is applied.
+		channels[x * 4] = (Uint16)(((pixel & 0xff) * alpha * 257 + 127) / 255);
+		channels[x * 4 + 1] = (Uint16)((((pixel >> 8) & 0xff) * alpha * 257 + 127) / 255);
+		channels[x * 4 + 2] = (Uint16)((((pixel >> 16) & 0xff) * alpha * 257 + 127) / 255);
+		channels[x * 4 + 3] = (Uint16)(alpha * 257);
+	}
+}
+
+void Resampler::unpremultiply(const Uint16* channels, Uint32* row, int width) {
+	for (int x = 0; x < width; x++) {
+		const Uint16* pixel = channels + x * 4;
+		Uint32 alpha = pixel[3];
+		if (alpha == 0) {
+			row[x] = 0;
+			continue;
+		}
+		Uint32 b = std::min((pixel[0] * 255u + alpha / 2) / alpha, 255u);
+		Uint32 g = std::min((pixel[1] * 255u + alpha / 2) / alpha, 255u);
+		Uint32 r = std::min((pixel[2] * 255u + alpha / 2) / alpha, 255u);
+		row[x] = (((alpha + 128) / 257) << 24) | (r << 16) | (g << 8) | b;
+	}
+}
+
+void Resampler::narrow(const Uint16* channels, Uint32* row, int width) {
+	for (int x = 0; x < width; x++) {
+		const Uint16* pixel = channels + x * 4;
+		Uint32 alpha = (pixel[3] + 128u) / 257;
+		// Ringing can leave a channel above the alpha, which premultiplied blending would brighten.
+		Uint32 b = std::min((pixel[0] + 128u) / 257, alpha);
+		Uint32 g = std::min((pixel[1] + 128u) / 257, alpha);
+		Uint32 r = std::min((pixel[2] + 128u) / 257, alpha);
+		row[x] = (alpha << 24) | (r << 16) | (g << 8) | b;
+	}
+}
@@ -0,0 +1,243 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_RESAMPLER_H
+#define UTIL_RESAMPLER_H
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <SDL.h>
+#include <glib.h>
+
+#include "config.h"
+#include "JobSystem.h"
+
+/**
+ * @brief The support, (in source pixels either side), of the Lanczos kernel.
+ */
+#define OCCILLO_RESAMPLER_LANCZOS_SUPPORT 3
+/**
+ * @brief The minimum number of output pixels for each job.
+ */
+#define OCCILLO_RESAMPLER_PART_PIXELS (256 * 256)
+/**
+ * @brief The maximum number of jobs for each pass of a single image.
+ */
+#define OCCILLO_RESAMPLER_MAX_PARTS 8
+
+/**
+ * @brief The resampling filters.
+ */
+enum ResampleFilter {
+	RESAMPLE_AREA,      /**< Box filter, (the mean of the covered source pixels). */
+	RESAMPLE_BILINEAR,  /**< Triangle filter. */
+	RESAMPLE_LANCZOS    /**< Lanczos 3 windowed sinc filter. */
+};
+
+/**
+ * @brief A separable image resampler.
+ *
+ * Images are filtered horizontally and then vertically, with the filter widened when
+ * downscaling so every source pixel contributes. Colour is filtered premultiplied by alpha,
+ * (at 16 bits a channel, so the round trip keeps the 8 bit colour), so transparent pixels do not
+ * bleed into the edges of sprites. The inner loops use SSE2,
+ * or AVX2 where the CPU has it, and the rows of large images are split into jobs.
+ */
+class Resampler {
+  public:
+	/**
+	 * @brief Resample the given surface, (of any non palette format), to a new ARGB8888 surface.
+	 * @param source The surface to read. It is not modified.
+	 * @param width The width to scale to.
+	 * @param height The height to scale to.
+	 * @param filter The filter to use.
+	 * @param premultiplied TRUE to leave the new surface premultiplied by alpha, (which saves the divide).
+	 * @return The new surface, or nullptr on error.
+	 */
+	static SDL_Surface* resample(SDL_Surface* source, int width, int height, ResampleFilter filter, bool premultiplied = false);
+	/**
+	 * @brief Resample as resample() does, with the scalar loops, (the reference for the SIMD kernels).
+	 * @param source The surface to read. It is not modified.
+	 * @param width The width to scale to.
+	 * @param height The height to scale to.
+	 * @param filter The filter to use.
+	 * @param premultiplied TRUE to leave the new surface premultiplied by alpha.
+	 * @return The new surface, or nullptr on error.
+	 */
+	static SDL_Surface* resampleScalar(SDL_Surface* source, int width, int height, ResampleFilter filter, bool premultiplied = false);
+
+  private:
+	/**
+	 * @brief The filter weights for each output pixel along one axis.
+	 */
+	struct Coefficients {
+		/**
+		 * @brief The stride of the weights, (the largest number of taps).
+		 */
+		int taps;
+		/**
+		 * @brief The first source pixel for each output pixel.
+		 */
+		std::vector<int> start;
+		/**
+		 * @brief The number of source pixels for each output pixel.
+		 */
+		std::vector<int> count;
+		/**
+		 * @brief The normalised weights, taps per output pixel.
+		 */
+		std::vector<float> weights;
+	};
+	/**
+	 * @brief The state shared by the workers of one resample.
+	 */
+	struct Context {
+		/**
+		 * @brief The source surface.
+		 */
+		SDL_Surface* source;
+		/**
+		 * @brief The destination surface.
+		 */
+		SDL_Surface* destination;
+		/**
+		 * @brief The horizontally filtered rows, (destination width by source height, 4 premultiplied 16 bit channels a pixel).
+		 */
+		std::vector<Uint16> intermediate;
+		/**
+		 * @brief TRUE to leave the destination premultiplied.
+		 */
+		bool premultiplied;
+		/**
+		 * @brief TRUE to filter with the scalar loops.
+		 */
+		bool scalar;
+		/**
+		 * @brief The horizontal weights.
+		 */
+		Coefficients horizontal;
+		/**
+		 * @brief The vertical weights.
+		 */
+		Coefficients vertical;
+	};
+	/**
+	 * @brief A range of rows of one pass for a worker.
+	 */
+	struct Job {
+		/**
+		 * @brief The resample.
+		 */
+		Context* context;
+		/**
+		 * @brief TRUE for the vertical pass.
+		 */
+		bool vertical;
+		/**
+		 * @brief The first row.
+		 */
+		int first;
+		/**
+		 * @brief The row after the last row.
+		 */
+		int last;
+	};
+	/**
+	 * @brief Resample the given surface.
+	 * @param source The surface to read.
+	 * @param width The width to scale to.
+	 * @param height The height to scale to.
+	 * @param filter The filter to use.
+	 * @param premultiplied TRUE to leave the new surface premultiplied by alpha.
+	 * @param scalar TRUE to filter with the scalar loops rather than the SIMD kernels.
+	 * @return The new surface, or nullptr on error.
+	 */
+	static SDL_Surface* scale(SDL_Surface* source, int width, int height, ResampleFilter filter, bool premultiplied, bool scalar);
+	/**
+	 * @brief The kernel for the given filter.
+	 * @param filter The filter.
+	 * @param x The distance from the centre, in source pixels.
+	 * @return The weight.
+	 */
+	static double kernel(ResampleFilter filter, double x);
+	/**
+	 * @brief The support of the kernel for the given filter.
+	 * @param filter The filter.
+	 * @return The support, in source pixels either side of the centre.
+	 */
+	static double support(ResampleFilter filter);
+	/**
+	 * @brief Calculate the weights for scaling one axis.
+	 * @param in The source size.
+	 * @param out The destination size.
+	 * @param filter The filter.
+	 * @param coefficients The weights to fill.
+	 */
+	static void calculate(int in, int out, ResampleFilter filter, Coefficients& coefficients);
+	/**
+	 * @brief Run one pass split into the given number of jobs.
+	 * @param context The resample.
+	 * @param vertical TRUE for the vertical pass.
+	 * @param rows The number of rows in the pass.
+	 * @param parts The number of jobs.
+	 */
+	static void run(Context* context, bool vertical, int rows, int parts);
+	/**
+	 * @brief The job entry point.
+	 * @param data The job.
+	 */
+	static void worker(void* data);
+	/**
+	 * @brief Filter the given source rows horizontally into the intermediate rows.
+	 * @param context The resample.
+	 * @param first The first row.
+	 * @param last The row after the last row.
+	 */
+	static void horizontalRows(Context* context, int first, int last);
+	/**
+	 * @brief Filter the given destination rows vertically from the intermediate rows.
+	 * @param context The resample.
+	 * @param first The first row.
+	 * @param last The row after the last row.
+	 */
+	static void verticalRows(Context* context, int first, int last);
+	/**
+	 * @brief Widen a row of ARGB8888 pixels to 16 bit channels premultiplied by alpha.
+	 * @param row The row.
+	 * @param channels The widened row, (4 channels a pixel).
+	 * @param width The number of pixels.
+	 */
+	static void premultiply(const Uint32* row, Uint16* channels, int width);
+	/**
+	 * @brief Narrow a row of premultiplied 16 bit channels to ARGB8888 pixels.
+	 * @param channels The row, (4 channels a pixel).
+	 * @param row The narrowed row.
+	 * @param width The number of pixels.
+	 */
+	static void unpremultiply(const Uint16* channels, Uint32* row, int width);
+	/**
+	 * @brief Narrow a row of premultiplied 16 bit channels to premultiplied ARGB8888 pixels.
+	 * @param channels The row, (4 channels a pixel).
+	 * @param row The narrowed row.
+	 * @param width The number of pixels.
+	 */
+	static void narrow(const Uint16* channels, Uint32* row, int width);
+};
+
+#endif /* UTIL_RESAMPLER_H */
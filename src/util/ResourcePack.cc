@@ -0,0 +1,220 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "ResourcePack.h"
+
+#include <cstdio>
+#include <cstring>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+GMappedFile* ResourcePack::mapped = nullptr;
+std::vector<GMappedFile*> ResourcePack::retired;
+std::string ResourcePack::packFile;
+std::unordered_map<std::string, ResourcePack::Entry> ResourcePack::entries;
+
+/**
+ * @brief The size of the pack header, (magic, count and index size).
+ */
+#define OCCILLO_RESOURCEPACK_HEADER_SIZE (OCCILLO_RESOURCEPACK_MAGIC_SIZE + 8)
+/**
+ * @brief The size of an index entry without its name, (offset, size and name length).
+ */
+#define OCCILLO_RESOURCEPACK_ENTRY_SIZE 20
+
+/**
+ * @brief Read a little endian value from the given buffer.
+ * @param buffer The buffer.
+ * @param bytes The size of the value in bytes.
+ * @return The value.
+ */
+static guint64 getLE(const char* buffer, int bytes) {
+	guint64 value = 0;
+	for (int i = bytes - 1; i >= 0; i--) {
+		value = (value << 8) | (unsigned char) buffer[i];
+	}
+	return value;
+}
+
+/**
+ * @brief Write a little endian value to the given file.
+ * @param out The file.
+ * @param value The value.
+ * @param bytes The size of the value in bytes.
+ * @return TRUE if written.
+ */
+static bool putLE(FILE* out, guint64 value, int bytes) {
+	unsigned char buffer[8];
+	for (int i = 0; i < bytes; i++) {
+		buffer[i] = (unsigned char)(value >> (i * 8));
+	}
+	return std::fwrite(buffer, bytes, 1, out) == 1;
+}
+
+bool ResourcePack::open(const std::string& file) {
+	if (mapped != nullptr && packFile == file) {
+		return true;
+	}
+	GError* error = nullptr;
+	GMappedFile* pack = g_mapped_file_new(file.c_str(), FALSE, &error);
+	if (pack == nullptr) {
+		g_info("%s[%d] : Unable to map resource pack %s: %s", __FILE__, __LINE__, file.c_str(), error->message);
+		g_error_free(error);
+		return false;
+	}
+	std::unordered_map<std::string, Entry> index;
+	if (!readIndex(g_mapped_file_get_contents(pack), g_mapped_file_get_length(pack), index)) {
+		g_warning("%s[%d] : Invalid resource pack %s", __FILE__, __LINE__, file.c_str());
+		g_mapped_file_unref(pack);
+		return false;
+	}
+	if (mapped != nullptr) {
+		retired.push_back(mapped);
+	}
+	mapped = pack;
+	packFile = file;
+	entries.swap(index);
+	g_info("%s[%d] : Mapped resource pack %s, %u resources", __FILE__, __LINE__, file.c_str(), (unsigned int) entries.size());
+	return true;
+}
+
+void ResourcePack::close() {
+	entries.clear();
+	packFile.clear();
+	if (mapped != nullptr) {
+		g_mapped_file_unref(mapped);
+		mapped = nullptr;
+	}
+	for (GMappedFile* pack : retired) {
+		g_mapped_file_unref(pack);
+	}
+	retired.clear();
+}
+
+bool ResourcePack::readIndex(const char* data, size_t length, std::unordered_map<std::string, Entry>& index) {
+	if (data == nullptr || length < OCCILLO_RESOURCEPACK_HEADER_SIZE ||
+	        std::memcmp(data, OCCILLO_RESOURCEPACK_MAGIC, OCCILLO_RESOURCEPACK_MAGIC_SIZE) != 0) {
+		return false;
+	}
+	guint64 count = getLE(data + OCCILLO_RESOURCEPACK_MAGIC_SIZE, 4);
+	guint64 indexSize = getLE(data + OCCILLO_RESOURCEPACK_MAGIC_SIZE + 4, 4);
+	if (indexSize > length - OCCILLO_RESOURCEPACK_HEADER_SIZE) {
+		return false;
+	}
+	const char* entry = data + OCCILLO_RESOURCEPACK_HEADER_SIZE;
+	const char* end = entry + indexSize;
+	for (guint64 i = 0; i < count; i++) {
+		if ((size_t)(end - entry) < OCCILLO_RESOURCEPACK_ENTRY_SIZE) {
+			return false;
+		}
+		guint64 offset = getLE(entry, 8);
+		guint64 size = getLE(entry + 8, 8);
+		guint64 nameLength = getLE(entry + 16, 4);
+		entry += OCCILLO_RESOURCEPACK_ENTRY_SIZE;
+		if ((guint64)(end - entry) < nameLength || offset > length || size > length - offset) {
+			return false;
+		}
+		index[std::string(entry, nameLength)] = { data + offset, (size_t) size };
+		entry += nameLength;
+	}
+	return true;
+}
+
+bool ResourcePack::contains(const std::string& resource) {
+	return entries.find(resource) != entries.end();
+}
+
+std::string ResourcePack::getPath(const std::string& resource) {
+	return packFile + G_DIR_SEPARATOR_S + resource;
+}
+
+bool ResourcePack::find(const std::string& path, const char** data, size_t* size) {
+	if (mapped == nullptr || path.size() <= packFile.size() + 1 || path.compare(0, packFile.size(), packFile) != 0 ||
+	        path[packFile.size()] != G_DIR_SEPARATOR) {
+		return false;
+	}
+	std::unordered_map<std::string, Entry>::iterator it = entries.find(path.substr(packFile.size() + 1));
+	if (it == entries.end()) {
+		return false;
+	}
+	*data = it->second.data;
+	*size = it->second.size;
+	return true;
+}
+
+SDL_RWops* ResourcePack::openRW(const std::string& path) {
+	const char* data = nullptr;
+	size_t size = 0;
+	if (!find(path, &data, &size)) {
+		return nullptr;
+	}
+	return SDL_RWFromConstMem(data, (int) size);
+}
+
+bool ResourcePack::write(const std::string& file, const std::string& base, const std::vector<std::string>& resources) {
+	// Lay out the index, then the resources, each aligned.
+	std::vector<guint64> sizes;
+	guint64 indexSize = 0;
+	for (const std::string& resource : resources) {
+		std::string path = base + G_DIR_SEPARATOR_S + resource;
+		struct stat info;
+		if (stat(path.c_str(), &info) != 0) {
+			g_warning("%s[%d] : Unable to read %s", __FILE__, __LINE__, path.c_str());
+			return false;
+		}
+		sizes.push_back((guint64) info.st_size);
+		indexSize += OCCILLO_RESOURCEPACK_ENTRY_SIZE + resource.size();
+	}
+	FILE* out = std::fopen(file.c_str(), "wb");
+	if (out == nullptr) {
+		g_warning("%s[%d] : Unable to write %s", __FILE__, __LINE__, file.c_str());
+		return false;
+	}
+	bool ok = (std::fwrite(OCCILLO_RESOURCEPACK_MAGIC, OCCILLO_RESOURCEPACK_MAGIC_SIZE, 1, out) == 1)
+	          && putLE(out, resources.size(), 4) && putLE(out, indexSize, 4);
+	guint64 offset = OCCILLO_RESOURCEPACK_HEADER_SIZE + indexSize;
+	std::vector<guint64> offsets;
+	for (unsigned int i = 0; i < resources.size() && ok; i++) {
+		offset = (offset + OCCILLO_RESOURCEPACK_ALIGN - 1) / OCCILLO_RESOURCEPACK_ALIGN * OCCILLO_RESOURCEPACK_ALIGN;
+		offsets.push_back(offset);
+		ok = putLE(out, offset, 8) && putLE(out, sizes[i], 8) && putLE(out, resources[i].size(), 4)
+		     && (std::fwrite(resources[i].data(), resources[i].size(), 1, out) == 1);
+		offset += sizes[i];
+	}
+	guint64 position = OCCILLO_RESOURCEPACK_HEADER_SIZE + indexSize;
+	for (unsigned int i = 0; i < resources.size() && ok; i++) {
+		static const char padding[OCCILLO_RESOURCEPACK_ALIGN] = { 0 };
+		ok = (offsets[i] == position) || (std::fwrite(padding, offsets[i] - position, 1, out) == 1);
+		std::string path = base + G_DIR_SEPARATOR_S + resources[i];
+		gchar* contents = nullptr;
+		gsize length = 0;
+		if (ok && (!g_file_get_contents(path.c_str(), &contents, &length, nullptr) || length != sizes[i])) {
+			g_warning("%s[%d] : Unable to read %s", __FILE__, __LINE__, path.c_str());
+			ok = false;
+		}
+		ok = ok && ((length == 0) || (std::fwrite(contents, length, 1, out) == 1));
+		g_free(contents);
+		position = offsets[i] + sizes[i];
+	}
+	ok = (std::fclose(out) == 0) && ok;
+	if (!ok) {
+		g_warning("%s[%d] : Unable to write %s", __FILE__, __LINE__, file.c_str());
+		std::remove(file.c_str());
+	}
+	return ok;
+}
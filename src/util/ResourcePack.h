@@ -0,0 +1,144 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_RESOURCEPACK_H
+#define UTIL_RESOURCEPACK_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <SDL.h>
+#include <glib.h>
+
+#include "config.h"
+
+/**
+ * @brief The name of the resource pack in the data directory.
+ */
+#define OCCILLO_RESOURCEPACK_FILE "occillo.pack"
+/**
+ * @brief The magic at the start of a resource pack.
+ */
+#define OCCILLO_RESOURCEPACK_MAGIC "OCCPACK1"
+/**
+ * @brief The size of the resource pack magic.
+ */
+#define OCCILLO_RESOURCEPACK_MAGIC_SIZE 8
+/**
+ * @brief The alignment of each resource in the pack.
+ */
+#define OCCILLO_RESOURCEPACK_ALIGN 16
+
+/**
+ * @brief A single file archive of the game resources, memory mapped and read in place.
+ *
+ * The pack starts with the magic, the number of resources and the size of the index, (32 bit little
+ * endian values). Each index entry is the offset and size of the resource, (64 bit), the length of
+ * its name, (32 bit), and the name, (the resource as listed in the game files, eg images/ball.svg).
+ *
+ * Resources in the pack are located as the pack file followed by the resource name, so loaders can
+ * ask for a path's contents and fall back to the loose file when it is not in the pack.
+ */
+class ResourcePack {
+  public:
+	/**
+	 * @brief Map the given pack, (a pack already open stays mapped until close(), as fonts read from it).
+	 * @param file The pack file.
+	 * @return TRUE if the pack was mapped and its index is valid.
+	 */
+	static bool open(const std::string& file);
+	/**
+	 * @brief Unmap all packs, (once nothing reads from them).
+	 */
+	static void close();
+	/**
+	 * @brief Determine if the open pack holds the given resource.
+	 * @param resource The resource name.
+	 * @return TRUE if the pack holds the resource.
+	 */
+	static bool contains(const std::string& resource);
+	/**
+	 * @brief Get the path of the given resource in the open pack.
+	 * @param resource The resource name.
+	 * @return The path.
+	 */
+	static std::string getPath(const std::string& resource);
+	/**
+	 * @brief Get the contents of the given path, if it is in the pack.
+	 * @param path The path, (as returned by getPath()).
+	 * @param data Set to the contents, (owned by the pack).
+	 * @param size Set to the size of the contents.
+	 * @return TRUE if the path is in the pack.
+	 */
+	static bool find(const std::string& path, const char** data, size_t* size);
+	/**
+	 * @brief Open a read only stream over the contents of the given path, if it is in the pack.
+	 * @param path The path, (as returned by getPath()).
+	 * @return The stream, or nullptr if the path is not in the pack, (read the loose file instead).
+	 */
+	static SDL_RWops* openRW(const std::string& path);
+	/**
+	 * @brief Write a pack of the given files.
+	 * @param file The pack file to write.
+	 * @param base The directory the resource names are relative to.
+	 * @param resources The resource names.
+	 * @return TRUE if the pack was written.
+	 */
+	static bool write(const std::string& file, const std::string& base, const std::vector<std::string>& resources);
+
+  private:
+	/**
+	 * @brief A resource in the pack.
+	 */
+	struct Entry {
+		/**
+		 * @brief The contents, (in the mapped pack).
+		 */
+		const char* data;
+		/**
+		 * @brief The size of the contents.
+		 */
+		size_t size;
+	};
+	/**
+	 * @brief The open pack, (nullptr if none).
+	 */
+	static GMappedFile* mapped;
+	/**
+	 * @brief Packs replaced by another, kept mapped until close().
+	 */
+	static std::vector<GMappedFile*> retired;
+	/**
+	 * @brief The open pack file.
+	 */
+	static std::string packFile;
+	/**
+	 * @brief The resources in the open pack, by name.
+	 */
+	static std::unordered_map<std::string, Entry> entries;
+	/**
+	 * @brief Read the index of the given mapped pack.
+	 * @param data The pack contents.
+	 * @param length The pack size.
+	 * @param index The index to fill.
+	 * @return TRUE if the index is valid.
+	 */
+	static bool readIndex(const char* data, size_t length, std::unordered_map<std::string, Entry>& index);
+};
+
+#endif /* UTIL_RESOURCEPACK_H */
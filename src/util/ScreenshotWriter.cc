@@ -0,0 +1,118 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "ScreenshotWriter.h"
+
+#include <cstdio>
+#include <ctime>
+
+ScreenshotWriter::ScreenshotWriter() {
+	for (int i = 0; i < OCCILLO_SCREENSHOT_BUFFERS; i++) {
+		buffers[i].surface = nullptr;
+		SDL_AtomicSet(&buffers[i].busy, 0);
+	}
+	lastTime = 0;
+	sequence = 0;
+}
+
+ScreenshotWriter::~ScreenshotWriter() {
+	clear();
+}
+
+void ScreenshotWriter::clear() {
+	JobSystem::wait(&writes);
+	for (int i = 0; i < OCCILLO_SCREENSHOT_BUFFERS; i++) {
+		if (buffers[i].surface != nullptr) {
+			SDL_FreeSurface(buffers[i].surface);
+			buffers[i].surface = nullptr;
+		}
+	}
+}
+
+std::string ScreenshotWriter::nextFile() {
+	int tm = (int)time(NULL);
+	if (tm == lastTime) {
+		sequence++;
+	} else {
+		lastTime = tm;
+		sequence = 0;
+	}
+	char dest[100] = "";
+#ifdef _WIN32
+	if (sequence > 0) {
+		_snprintf(dest, 100, "screenshot-%d-%d.png", tm, sequence);
+	} else {
+		_snprintf(dest, 100, "screenshot-%d.png", tm);
+	}
+#else
+	if (sequence > 0) {
+		std::snprintf(dest, 100, "screenshot-%d-%d.png", tm, sequence);
+	} else {
+		std::snprintf(dest, 100, "screenshot-%d.png", tm);
+	}
+#endif
+	return dest;
+}
+
+bool ScreenshotWriter::capture(SDL_Renderer* renderer, int width, int height) {
+	Buffer* buffer = nullptr;
+	for (int i = 0; i < OCCILLO_SCREENSHOT_BUFFERS; i++) {
+		if (SDL_AtomicCAS(&buffers[i].busy, 0, 1)) {
+			buffer = &buffers[i];
+			break;
+		}
+	}
+	if (buffer == nullptr) {
+		g_info("%s[%d] : Screenshot dropped, all buffers are being written", __FILE__, __LINE__);
+		return false;
+	}
+
+	// The buffer is only reallocated when the display changes size.
+	SDL_Surface* surface = buffer->surface;
+	if ((surface == nullptr) || (surface->w != width) || (surface->h != height)) {
+		if (surface != nullptr) {
+			SDL_FreeSurface(surface);
+		}
+		surface = SDL_CreateRGBSurface(0, width, height, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+		buffer->surface = surface;
+		if (surface == nullptr) {
+			g_warning("%s[%d] : Unable to create screenshot surface: %s", __FILE__, __LINE__, SDL_GetError());
+			SDL_AtomicSet(&buffer->busy, 0);
+			return false;
+		}
+	}
+	if (SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_ARGB8888, surface->pixels, surface->pitch) != 0) {
+		g_warning("%s[%d] : Unable to read the display: %s", __FILE__, __LINE__, SDL_GetError());
+		SDL_AtomicSet(&buffer->busy, 0);
+		return false;
+	}
+	buffer->file = nextFile();
+	JobSystem::submit(&writes, writeWorker, buffer, "screenshot");
+	return true;
+}
+
+void ScreenshotWriter::writeWorker(void* data) {
+	Buffer* buffer = (Buffer*) data;
+	if (IMG_SavePNG(buffer->surface, buffer->file.c_str()) != 0) {
+		g_warning("%s[%d] : Unable to write screenshot %s: %s", __FILE__, __LINE__, buffer->file.c_str(), SDL_GetError());
+	} else {
+		g_info("%s[%d] : Screenshot %s", __FILE__, __LINE__, buffer->file.c_str());
+	}
+	// Return the buffer to the pool.
+	SDL_AtomicSet(&buffer->busy, 0);
+}
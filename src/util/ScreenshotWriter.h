@@ -0,0 +1,105 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_SCREENSHOTWRITER_H
+#define UTIL_SCREENSHOTWRITER_H
+
+#include <string>
+#include <SDL.h>
+#include <SDL_image.h>
+#include <glib.h>
+
+#include "config.h"
+#include "JobSystem.h"
+
+/**
+ * @brief The number of pooled screenshot buffers, (the screenshots that may be encoding at once).
+ */
+#define OCCILLO_SCREENSHOT_BUFFERS 3
+
+/**
+ * @brief Captures the display and writes it as a PNG file on a worker.
+ *
+ * Only the read back of the display is done on the render thread, into a pooled surface. The PNG
+ * encoding and file I/O are done as a job, after which the surface is returned to the pool. When
+ * every buffer is still being written, the screenshot is dropped rather than stalling the frame.
+ */
+class ScreenshotWriter {
+  public:
+	ScreenshotWriter();
+	virtual ~ScreenshotWriter();
+	/**
+	 * @brief Capture the current render target and queue it to be written.
+	 * @param renderer The renderer.
+	 * @param width The width of the render target.
+	 * @param height The height of the render target.
+	 * @return TRUE if captured, FALSE if no buffer was free or the read back failed.
+	 */
+	bool capture(SDL_Renderer* renderer, int width, int height);
+	/**
+	 * @brief Wait for the queued screenshots to be written and free the buffers.
+	 */
+	void clear();
+
+  private:
+	/**
+	 * @brief A pooled screenshot buffer.
+	 */
+	struct Buffer {
+		/**
+		 * @brief The captured pixels, (ARGB8888), or nullptr if not yet allocated.
+		 */
+		SDL_Surface* surface;
+		/**
+		 * @brief The file to write.
+		 */
+		std::string file;
+		/**
+		 * @brief 1 while captured and not yet written.
+		 */
+		SDL_atomic_t busy;
+	};
+	/**
+	 * @brief The buffers.
+	 */
+	Buffer buffers[OCCILLO_SCREENSHOT_BUFFERS];
+	/**
+	 * @brief The write jobs.
+	 */
+	JobGroup writes;
+	/**
+	 * @brief The time of the last screenshot, (to number those taken in the same second).
+	 */
+	int lastTime;
+	/**
+	 * @brief The number of screenshots taken in the same second.
+	 */
+	int sequence;
+	/**
+	 * @brief Get the file name for a screenshot taken now.
+	 * @return The file name.
+	 */
+	std::string nextFile();
+	/**
+	 * @brief The write job entry.
+	 * @param data The buffer.
+	 */
+	static void writeWorker(void* data);
+};
+
+#endif /* UTIL_SCREENSHOTWRITER_H */
@@ -0,0 +1,200 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "SoundCache.h"
+
+#include <cstdio>
+
+SoundCache::SoundCache() {
+	persistent = false;
+	lock = SDL_CreateMutex();
+}
+
+SoundCache::~SoundCache() {
+	clear();
+	if (lock != nullptr) {
+		SDL_DestroyMutex(lock);
+		lock = nullptr;
+	}
+}
+
+void SoundCache::setPersistent(bool persist) {
+	persistent = persist;
+}
+
+Mix_Chunk* SoundCache::acquire(const std::string& path) {
+	SDL_LockMutex(lock);
+	std::map<std::string, Sound>::iterator it = sounds.find(path);
+	if (it != sounds.end()) {
+		it->second.references++;
+		SDL_UnlockMutex(lock);
+		return it->second.chunk;
+	}
+	SDL_UnlockMutex(lock);
+	Sound sound = { nullptr, nullptr, 1 };
+	if (!decode(path, sound)) {
+		return nullptr;
+	}
+	return insert(path, sound);
+}
+
+void SoundCache::prefetch(const std::string& path) {
+	SDL_LockMutex(lock);
+	bool cached = sounds.find(path) != sounds.end();
+	SDL_UnlockMutex(lock);
+	if (cached) {
+		return;
+	}
+	Sound sound = { nullptr, nullptr, 0 };
+	if (decode(path, sound)) {
+		insert(path, sound);
+	}
+}
+
+Mix_Chunk* SoundCache::insert(const std::string& path, Sound& sound) {
+	SDL_LockMutex(lock);
+	std::map<std::string, Sound>::iterator it = sounds.find(path);
+	if (it != sounds.end()) {
+		// Decoded by another thread in the meantime, so use theirs.
+		it->second.references += sound.references;
+		free(sound);
+		SDL_UnlockMutex(lock);
+		return it->second.chunk;
+	}
+	sounds[path] = sound;
+	SDL_UnlockMutex(lock);
+	return sound.chunk;
+}
+
+bool SoundCache::decode(const std::string& path, Sound& sound) {
+	std::string file;
+	if (persistent) {
+		file = getCacheFile(path);
+		if (!file.empty() && loadPCM(file, sound)) {
+			g_info("%s[%d] : Loaded decoded sound %s", __FILE__, __LINE__, file.c_str());
+			return true;
+		}
+	}
+	SDL_RWops* packed = ResourcePack::openRW(path);
+	sound.chunk = (packed != nullptr) ? Mix_LoadWAV_RW(packed, 1) : Mix_LoadWAV(path.c_str());
+	if (sound.chunk == nullptr) {
+		return false;
+	}
+	if (!file.empty()) {
+		storePCM(file, sound.chunk);
+	}
+	return true;
+}
+
+void SoundCache::release(Mix_Chunk* chunk) {
+	if (chunk == nullptr) {
+		return;
+	}
+	SDL_LockMutex(lock);
+	for (std::map<std::string, Sound>::iterator it = sounds.begin(); it != sounds.end(); ++it) {
+		if (it->second.chunk == chunk) {
+			// Unreferenced sounds are kept for the next level.
+			if (it->second.references > 0) {
+				it->second.references--;
+			}
+			break;
+		}
+	}
+	SDL_UnlockMutex(lock);
+}
+
+void SoundCache::free(Sound& sound) {
+	if (sound.chunk != nullptr) {
+		Mix_FreeChunk(sound.chunk);
+		sound.chunk = nullptr;
+	}
+	// Mix_QuickLoad_RAW() chunks don't own their buffer.
+	if (sound.pcm != nullptr) {
+		g_free(sound.pcm);
+		sound.pcm = nullptr;
+	}
+}
+
+void SoundCache::clear() {
+	SDL_LockMutex(lock);
+	for (std::map<std::string, Sound>::iterator it = sounds.begin(); it != sounds.end(); ++it) {
+		free(it->second);
+	}
+	sounds.clear();
+	SDL_UnlockMutex(lock);
+}
+
+std::string SoundCache::getCacheFile(const std::string& path) {
+	int frequency = 0;
+	Uint16 format = 0;
+	int channels = 0;
+	if (Mix_QuerySpec(&frequency, &format, &channels) == 0) {
+		return "";
+	}
+	char key[100];
+	const char* data = nullptr;
+	size_t size = 0;
+	struct stat info;
+	if (ResourcePack::find(path, &data, &size)) {
+		// A packed sound has no modification time, so use its contents.
+		gchar* hash = g_compute_checksum_for_data(G_CHECKSUM_SHA1, (const guchar*) data, size);
+		std::snprintf(key, sizeof(key), ":%s:%d:%u:%d", hash, frequency, (unsigned int) format, channels);
+		g_free(hash);
+	} else if (stat(path.c_str(), &info) == 0) {
+		std::snprintf(key, sizeof(key), ":%ld:%ld:%d:%u:%d", (long) info.st_size, (long) info.st_mtime,
+		              frequency, (unsigned int) format, channels);
+	} else {
+		return "";
+	}
+	std::string name = path + key;
+	gchar* hash = g_compute_checksum_for_string(G_CHECKSUM_SHA1, name.c_str(), -1);
+	gchar* dir = g_build_filename(g_get_user_cache_dir(), PACKAGE_NAME, OCCILLO_SOUNDCACHE_DIR, nullptr);
+	std::string pcmName = std::string(hash) + ".pcm";
+	gchar* file = g_build_filename(dir, pcmName.c_str(), nullptr);
+	std::string result(file);
+	g_free(file);
+	g_free(dir);
+	g_free(hash);
+	return result;
+}
+
+bool SoundCache::loadPCM(const std::string& file, Sound& sound) {
+	gchar* pcm = nullptr;
+	gsize length = 0;
+	if (!g_file_get_contents(file.c_str(), &pcm, &length, nullptr)) {
+		return false;
+	}
+	sound.chunk = Mix_QuickLoad_RAW((Uint8*) pcm, length);
+	if (sound.chunk == nullptr) {
+		g_free(pcm);
+		return false;
+	}
+	sound.pcm = pcm;
+	return true;
+}
+
+void SoundCache::storePCM(const std::string& file, Mix_Chunk* chunk) {
+	gchar* dir = g_path_get_dirname(file.c_str());
+	g_mkdir_with_parents(dir, 0755);
+	g_free(dir);
+	GError* error = nullptr;
+	if (!g_file_set_contents(file.c_str(), (const gchar*) chunk->abuf, chunk->alen, &error)) {
+		g_info("%s[%d] : Unable to store decoded sound %s: %s", __FILE__, __LINE__, file.c_str(), error->message);
+		g_error_free(error);
+	}
+}
@@ -0,0 +1,153 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_SOUNDCACHE_H
+#define UTIL_SOUNDCACHE_H
+
+#include <string>
+#include <map>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <glib.h>
+
+#include "config.h"
+#include "ResourcePack.h"
+
+/**
+ * @brief The sub directory of the user cache directory for decoded sounds.
+ */
+#define OCCILLO_SOUNDCACHE_DIR "sounds"
+
+/**
+ * @brief A reference counted cache of decoded sound effects, shared by all levels.
+ *
+ * Sounds stay decoded when no longer referenced, so the next level reusing them does not decode them
+ * again. Optionally, the decoded PCM is also kept in the user cache directory so later runs skip
+ * decoding altogether.
+ */
+class SoundCache {
+  public:
+	SoundCache();
+	virtual ~SoundCache();
+	/**
+	 * @brief Keep the decoded sounds in the user cache directory between runs.
+	 * @param persist TRUE to read and write the decoded sounds in the user cache directory.
+	 */
+	void setPersistent(bool persist);
+	/**
+	 * @brief Get the given sound, loading it if needed.
+	 * @param path The resolved path to the sound.
+	 * @return The sound, (to be released with release()), or nullptr if it could not be loaded.
+	 */
+	Mix_Chunk* acquire(const std::string& path);
+	/**
+	 * @brief Release a sound returned by acquire().
+	 * @param chunk The sound.
+	 */
+	void release(Mix_Chunk* chunk);
+	/**
+	 * @brief Decode the given sound if not already cached, without taking a reference.
+	 *
+	 * Unlike the other methods, this may be called off the main thread, (eg when loading the next level
+	 * in the background).
+	 *
+	 * @param path The resolved path to the sound.
+	 */
+	void prefetch(const std::string& path);
+	/**
+	 * @brief Free all sounds, (must be called before the mixer is closed).
+	 */
+	void clear();
+
+  private:
+	/**
+	 * @brief A cached sound.
+	 */
+	struct Sound {
+		/**
+		 * @brief The decoded sound.
+		 */
+		Mix_Chunk* chunk;
+		/**
+		 * @brief The PCM read from the user cache directory, (owned by glib, nullptr if decoded).
+		 */
+		gchar* pcm;
+		/**
+		 * @brief The number of references.
+		 */
+		int references;
+	};
+	/**
+	 * @brief The sounds, by path.
+	 */
+	std::map<std::string, Sound> sounds;
+	/**
+	 * @brief TRUE to keep decoded sounds in the user cache directory.
+	 */
+	bool persistent;
+	/**
+	 * @brief Lock for the sounds, (taken by prefetch() from other threads).
+	 */
+	SDL_mutex* lock;
+	/**
+	 * @brief Decode the given sound, from the user cache directory if possible.
+	 * @param path The resolved path to the sound.
+	 * @param sound The sound to fill.
+	 * @return TRUE if decoded.
+	 */
+	bool decode(const std::string& path, Sound& sound);
+	/**
+	 * @brief Add a decoded sound, unless another thread added it first.
+	 * @param path The resolved path to the sound.
+	 * @param sound The decoded sound, (freed if another thread added the sound first).
+	 * @return The cached sound.
+	 */
+	Mix_Chunk* insert(const std::string& path, Sound& sound);
+	/**
+	 * @brief Get the file in the user cache directory for the given sound.
+	 *
+	 * The name covers the file size and modification time, and the mixer format, so a changed file
+	 * or mixer is decoded again.
+	 *
+	 * @param path The resolved path to the sound.
+	 * @return The cache file, or an empty string if the sound file can't be found.
+	 */
+	std::string getCacheFile(const std::string& path);
+	/**
+	 * @brief Load the sound from the user cache directory.
+	 * @param file The cache file.
+	 * @param sound The sound to fill.
+	 * @return TRUE if loaded.
+	 */
+	bool loadPCM(const std::string& file, Sound& sound);
+	/**
+	 * @brief Write the decoded sound to the user cache directory.
+	 * @param file The cache file.
+	 * @param chunk The decoded sound.
+	 */
+	void storePCM(const std::string& file, Mix_Chunk* chunk);
+	/**
+	 * @brief Free the given sound.
+	 * @param sound The sound.
+	 */
+	void free(Sound& sound);
+};
+
+#endif /* UTIL_SOUNDCACHE_H */
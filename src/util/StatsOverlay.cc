@@ -0,0 +1,92 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "StatsOverlay.h"
+
+#include <cstdio>
+#include <algorithm>
+
+StatsOverlay::StatsOverlay(TTF_Font* font) : font(font) {
+	colour = { 0xFF, 0xFF, 0xFF, 0xFF };
+	seconds = 0;
+}
+
+StatsOverlay::~StatsOverlay() {
+	clearLines();
+}
+
+void StatsOverlay::clearLines() {
+	for (Texture* line : lines) {
+		delete line;
+	}
+	lines.clear();
+}
+
+void StatsOverlay::addLine(SDL_Renderer* renderer, const char* text) {
+	Texture* line = new Texture();
+	if (line->loadFromText(renderer, text, font, &colour)) {
+		lines.push_back(line);
+	} else {
+		delete line;
+	}
+}
+
+void StatsOverlay::update(SDL_Renderer* renderer) {
+	clearLines();
+	char text[100];
+	std::snprintf(text, sizeof(text), "%d fps", WorkCounters::getFramesPerSecond());
+	addLine(renderer, text);
+	for (int i = 0; i < WORK_COUNTERS; i++) {
+		WorkCounter counter = (WorkCounter) i;
+		if (counter == WORK_RENDER_SCALE) {
+			std::snprintf(text, sizeof(text), "%s %lu%%", WorkCounters::getName(counter), WorkCounters::getPerSecond(counter));
+		} else if (counter == WORK_ANIMATIONS) {
+			std::snprintf(text, sizeof(text), "%s %lu, max %lu", WorkCounters::getName(counter),
+			              WorkCounters::getPerSecond(counter), WorkCounters::getMaxPerFrame(counter));
+		} else {
+			std::snprintf(text, sizeof(text), "%s %lu/s, max %lu/frame", WorkCounters::getName(counter),
+			              WorkCounters::getPerSecond(counter), WorkCounters::getMaxPerFrame(counter));
+		}
+		addLine(renderer, text);
+	}
+	seconds = WorkCounters::getSeconds();
+}
+
+void StatsOverlay::render(SDL_Renderer* renderer) {
+	if (font == nullptr) {
+		return;
+	}
+	if (lines.empty() || (seconds != WorkCounters::getSeconds())) {
+		update(renderer);
+	}
+	int width = 0;
+	int height = 0;
+	for (Texture* line : lines) {
+		width = std::max(width, line->getWidth());
+		height += line->getHeight();
+	}
+	SDL_Rect panel = { 0, 0, width + 8, height + 8 };
+	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, OCCILLO_STATS_BACKGROUND_ALPHA);
+	SDL_RenderFillRect(renderer, &panel);
+	int y = 4;
+	for (Texture* line : lines) {
+		line->render(renderer, 4, y);
+		y += line->getHeight();
+	}
+}
@@ -0,0 +1,90 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_STATSOVERLAY_H
+#define UTIL_STATSOVERLAY_H
+
+#include <string>
+#include <vector>
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <glib.h>
+
+#include "config.h"
+#include "Texture.h"
+#include "WorkCounters.h"
+
+/**
+ * @brief The alpha of the stats panel background.
+ */
+#define OCCILLO_STATS_BACKGROUND_ALPHA 160
+
+/**
+ * @brief An on screen panel showing the work counters for the last second.
+ *
+ * The text is only rasterized when a new second of counts is available.
+ */
+class StatsOverlay {
+  public:
+	/**
+	 * @brief Create a new stats panel.
+	 * @param font The font for the panel, (not owned by the panel).
+	 */
+	StatsOverlay(TTF_Font* font);
+	virtual ~StatsOverlay();
+	/**
+	 * @brief Render the panel in the top left corner.
+	 * @param renderer The renderer.
+	 */
+	void render(SDL_Renderer* renderer);
+
+  private:
+	/**
+	 * @brief The font for the panel.
+	 */
+	TTF_Font* font;
+	/**
+	 * @brief The colour of the text.
+	 */
+	SDL_Color colour;
+	/**
+	 * @brief The rendered lines of text.
+	 */
+	std::vector<Texture*> lines;
+	/**
+	 * @brief The second the lines were rendered for.
+	 */
+	unsigned int seconds;
+	/**
+	 * @brief Rasterize the lines for the last second.
+	 * @param renderer The renderer.
+	 */
+	void update(SDL_Renderer* renderer);
+	/**
+	 * @brief Free the rendered lines.
+	 */
+	void clearLines();
+	/**
+	 * @brief Add a line of text.
+	 * @param renderer The renderer.
+	 * @param text The text.
+	 */
+	void addLine(SDL_Renderer* renderer, const char* text);
+};
+
+#endif /* UTIL_STATSOVERLAY_H */
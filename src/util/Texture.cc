@@ -18,12 +18,23 @@
 
 #include "Texture.h"
 
+SDL_Texture* Texture::lastRendered = nullptr;
+SDL_Renderer* Texture::straightRenderer = nullptr;
+int Texture::defaultRate = OCCILLO_TEXTURE_ANIMATION_RATE;
+AnimationMode Texture::defaultMode = ANIMATION_LOOP;
+Uint32 Texture::clock = 0;
+float Texture::pixelDensity = 1.0f;
+
 Texture::Texture() {
 	//Initialize
 	width = 0;
 	height = 0;
+	density = 1.0f;
 	lastError = nullptr;
-	startTime = SDL_GetTicks();
+	premultiplied = false;
+	rate = defaultRate;
+	mode = defaultMode;
+	startTime = clock;
 }
 
 Texture::~Texture() {
@@ -37,134 +48,202 @@ bool Texture::loadFromFile(SDL_Renderer* renderer, const std::string& path) {
 }
 
 bool Texture::loadFromFile(SDL_Renderer* renderer, const std::string& path, int width, int height) {
-	bool res = true;
 	destroy();
-	std::vector<std::string> frames = StringUtil::split(path, ';');
-	unsigned int sz = frames.size();
+	std::vector<SDL_Surface*> frames;
+	rasterizeFile(path, width, height, frames);
+	return loadFromSurfaces(renderer, frames, path);
+}
+
+bool Texture::rasterizeFile(const std::string& path, int width, int height, std::vector<SDL_Surface*>& frames) {
+	if ((width > 0) && (height > 0)) {
+		width = (int)(width * pixelDensity + 0.5f);
+		height = (int)(height * pixelDensity + 0.5f);
+	}
+	std::vector<std::string> files = StringUtil::split(path, ';');
+	unsigned int sz = files.size();
 	for (unsigned int i = 0; i < sz; i++) {
-		std::string frame = frames[i];
-		if (!frame.empty()) {
+		std::string frame = files[i];
+		if (!frame.empty() && (frame[0] != OCCILLO_TEXTURE_ANIMATION_PREFIX)) {
 			g_info("%s[%d]: Loading file %s", __FILE__, __LINE__, frame.c_str());
 
 			/*
 			 * Determine type, if SVG or other.
 			 * SVG uses cairo for rendering, other uses SDL_image...
 			 */
+			SDL_Surface* surface = nullptr;
 			const std::string extension = ".svg";
 			if (StringUtil::hasExtension(frame, extension)) {
-				res = loadSVG(renderer, frame, width, height);
+				surface = rasterizeSVG(frame, width, height);
 			} else {
-				res = loadPNG(renderer, frame, width, height);
+				surface = rasterizePNG(frame, width, height);
 			}
-			if (res) {
+			if (surface != nullptr) {
 				g_info("%s[%d]: Loaded file %s", __FILE__, __LINE__, frame.c_str());
+				frames.push_back(surface);
 			} else {
 				g_info("%s[%d]: FAILED Loaded file %s", __FILE__, __LINE__, frame.c_str());
 			}
 		}
 	}
-	return !texture.empty();
+	return !frames.empty();
 }
 
-bool Texture::loadPNG(SDL_Renderer* renderer, const std::string& path, int width, int height) {
-	g_info("%s[%d]: Loading PNG file %s", __FILE__, __LINE__, path.c_str());
-	//The final texture
-	SDL_Texture* newTexture = nullptr;
-	//Load image at specified path
-	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
-
-	if (loadedSurface == nullptr) {
-		lastError = IMG_GetError();
-		g_info("%s[%d] : %s", __FILE__, __LINE__, lastError);
-	} else {
-		// Ensure new surface is ARGB. (This is what we render SVG to, so use this here as well)
-		SDL_Surface* newSurface = SDL_ConvertSurfaceFormat(loadedSurface, SDL_PIXELFORMAT_ARGB8888, 0);
-		if (newSurface != nullptr) {
-			// Converted OK, so free the old, and set the new.
-			SDL_FreeSurface(loadedSurface);
-			loadedSurface = newSurface;
-		} else {
-			// failed to convert, so exit.
-			g_info("%s[%d] : %s", __FILE__, __LINE__, SDL_GetError());
-			SDL_FreeSurface(loadedSurface);
-			return false;
-		}
-
-		// scale if needed.
-		if (width != -1 || height != -1) {
-			if (width == -1) {
-				width = loadedSurface->w;
-			}
-			if (height == -1) {
-				height = loadedSurface->h;
-			}
-			g_info("%s[%d] : Scaling to %d %d", __FILE__, __LINE__, width, height);
-			SDL_Surface *n = SDL_CreateRGBSurface(loadedSurface->flags, width, height, loadedSurface->format->BitsPerPixel,
-			                                      loadedSurface->format->Rmask, loadedSurface->format->Gmask, loadedSurface->format->Bmask, loadedSurface->format->Amask);
-			if (n == nullptr) {
-				g_info("%s[%d] : %s", __FILE__, __LINE__, SDL_GetError());
-				SDL_FreeSurface(loadedSurface);
-				return false;
-			}
-			// Set the src as no blend mode, so we get a direct copy.
-			SDL_SetSurfaceBlendMode(loadedSurface, SDL_BLENDMODE_NONE);
-			if (SDL_BlitScaled(loadedSurface, nullptr, n, nullptr) != 0) {
-				g_info("%s[%d] : %s", __FILE__, __LINE__, SDL_GetError());
-				SDL_FreeSurface(loadedSurface);
-				SDL_FreeSurface(n);
-				return false;
-			}
-			SDL_FreeSurface(loadedSurface);
-			loadedSurface = n;
-		} else {
-			g_info("%s[%d] : Not scaling", __FILE__, __LINE__);
+bool Texture::loadFromSurfaces(SDL_Renderer* renderer, std::vector<SDL_Surface*>& surfaces, const std::string& path) {
+	destroy();
+	setAnimation(path);
+	// Rasterized by rasterizeFile() at the pixel density.
+	density = pixelDensity;
+	premultiplied = (renderer != straightRenderer);
+	std::vector<SDL_Rect> clips;
+	bool sheet = (renderer != nullptr) && packSheet(renderer, surfaces, clips);
+	unsigned int sz = surfaces.size();
+	for (unsigned int i = 0; i < sz; i++) {
+		SDL_Surface* surface = surfaces[i];
+		if (!premultiplied) {
+			AlphaUtil::unpremultiply(surface);
 		}
-
 		//Create texture from surface pixels
-		newTexture = SDL_CreateTextureFromSurface(renderer, loadedSurface);
-
+		SDL_Texture* newTexture = (renderer != nullptr) ? SDL_CreateTextureFromSurface(renderer, surface) : nullptr;
+		if ((newTexture != nullptr) && premultiplied &&
+		        (SDL_SetTextureBlendMode(newTexture, AlphaUtil::getPremultipliedBlendMode()) != 0)) {
+			// The renderer lacks custom blend modes, so use straight alpha from now on, (this is the first texture).
+			g_info("%s[%d] : Premultiplied alpha unsupported %s", __FILE__, __LINE__, SDL_GetError());
+			straightRenderer = renderer;
+			premultiplied = false;
+			SDL_DestroyTexture(newTexture);
+			AlphaUtil::unpremultiply(surface);
+			newTexture = SDL_CreateTextureFromSurface(renderer, surface);
+		}
 		if (newTexture == nullptr) {
 			lastError = SDL_GetError();
 			g_info("%s[%d] : failed %s", __FILE__, __LINE__, lastError);
+		} else if (sheet) {
+			texture.push_back(newTexture);
+			for (const SDL_Rect& clip : clips) {
+				Frame frame = { newTexture, clip };
+				frames.push_back(frame);
+			}
+			this->width = (int)(clips[0].w / density + 0.5f);
+			this->height = (int)(clips[0].h / density + 0.5f);
 		} else {
-			//Get image dimensions
-			this->width = loadedSurface->w;
-			this->height = loadedSurface->h;
+			addFrame(newTexture, surface->w, surface->h);
 		}
+		SDL_FreeSurface(surface);
+	}
+	surfaces.clear();
+	return !texture.empty();
+}
 
-		//Get rid of old loaded surface
-		SDL_FreeSurface(loadedSurface);
+bool Texture::packSheet(SDL_Renderer* renderer, std::vector<SDL_Surface*>& surfaces, std::vector<SDL_Rect>& clips) {
+	int count = surfaces.size();
+	if (count <= 1) {
+		return false;
+	}
+	int w = surfaces[0]->w;
+	int h = surfaces[0]->h;
+	for (SDL_Surface* surface : surfaces) {
+		if ((surface->w != w) || (surface->h != h)) {
+			return false;
+		}
+	}
+	// Lay the frames out in rows no wider than the renderer allows, (0 is no limit).
+	SDL_RendererInfo info;
+	if (SDL_GetRendererInfo(renderer, &info) != 0) {
+		return false;
+	}
+	int columns = count;
+	if (info.max_texture_width > 0) {
+		columns = std::min(columns, info.max_texture_width / w);
+	}
+	if (columns < 1) {
+		return false;
+	}
+	int rows = (count + columns - 1) / columns;
+	if ((info.max_texture_height > 0) && (rows * h > info.max_texture_height)) {
+		return false;
+	}
+	SDL_Surface* sheet = SDL_CreateRGBSurface(0, columns * w, rows * h, OCCILLO_TEXTURE_BPP,
+	                     OCCILLO_TEXTURE_RMASK, OCCILLO_TEXTURE_GMASK, OCCILLO_TEXTURE_BMASK, OCCILLO_TEXTURE_AMASK);
+	if (sheet == nullptr) {
+		g_info("%s[%d] : %s", __FILE__, __LINE__, SDL_GetError());
+		return false;
 	}
+	clips.clear();
+	for (int i = 0; i < count; i++) {
+		SDL_Rect clip = { (i % columns) * w, (i / columns) * h, w, h };
+		// A direct copy, as the frames are already in the sheet format.
+		SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+		SDL_BlitSurface(surfaces[i], nullptr, sheet, &clip);
+		SDL_FreeSurface(surfaces[i]);
+		clip.w = w;
+		clip.h = h;
+		clips.push_back(clip);
+	}
+	surfaces.clear();
+	surfaces.push_back(sheet);
+	g_info("%s[%d] : Packed %d frames into a %d x %d sheet", __FILE__, __LINE__, count, sheet->w, sheet->h);
+	return true;
+}
 
-	//Return success
-	if (newTexture != nullptr) {
-		texture.push_back(newTexture);
+SDL_Surface* Texture::rasterizePNG(const std::string& path, int width, int height) {
+	g_info("%s[%d]: Loading PNG file %s", __FILE__, __LINE__, path.c_str());
+	//Load image at specified path, (from the resource pack if it is in it)
+	SDL_RWops* packed = ResourcePack::openRW(path);
+	SDL_Surface* loadedSurface = (packed != nullptr) ? IMG_Load_RW(packed, 1) : IMG_Load(path.c_str());
+
+	if (loadedSurface == nullptr) {
+		g_info("%s[%d] : %s", __FILE__, __LINE__, IMG_GetError());
+		return nullptr;
+	}
+	if (width == -1) {
+		width = loadedSurface->w;
 	}
-	return newTexture != nullptr;
+	if (height == -1) {
+		height = loadedSurface->h;
+	}
+	if ((width != loadedSurface->w) || (height != loadedSurface->h)) {
+		// Resample straight from the decoded pixels into the final ARGB surface.
+		g_info("%s[%d] : Scaling to %d %d", __FILE__, __LINE__, width, height);
+		SDL_Surface* scaled = Resampler::resample(loadedSurface, width, height, OCCILLO_TEXTURE_RESAMPLE_FILTER, true);
+		SDL_FreeSurface(loadedSurface);
+		return scaled;
+	}
+	g_info("%s[%d] : Not scaling", __FILE__, __LINE__);
+	// Ensure new surface is ARGB. (This is what we render SVG to, so use this here as well)
+	SDL_Surface* newSurface = SDL_ConvertSurfaceFormat(loadedSurface, SDL_PIXELFORMAT_ARGB8888, 0);
+	if (newSurface == nullptr) {
+		g_info("%s[%d] : %s", __FILE__, __LINE__, SDL_GetError());
+	} else {
+		AlphaUtil::premultiply(newSurface);
+	}
+	SDL_FreeSurface(loadedSurface);
+	return newSurface;
 }
 
-bool Texture::loadSVG(SDL_Renderer* renderer, const std::string& path, int width, int height) {
-	//The final texture
-	SDL_Texture* newTexture = nullptr;
+SDL_Surface* Texture::rasterizeSVG(const std::string& path, int width, int height) {
 	cairo_surface_t* cairo_surf = nullptr;
 	cairo_t* cr = nullptr;
 	RsvgHandle* rsvg_handle = nullptr;
 	GError* error = nullptr;
-	unsigned char* image = nullptr;
 	int rwidth = 0;
 	int  rheight = 0;
-	int stride = 0;
 	float wscale = 1.0;
 	float vscale = 1.0;
 	RsvgDimensionData dimensions;
 	SDL_Surface * sdl_surface = nullptr;
 
-	/* Create an RSVG Handle from the SVG file: */
-	rsvg_handle = rsvg_handle_new_from_file(path.c_str(), &error);
+	/* Create an RSVG Handle from the SVG file, (or its contents in the resource pack): */
+	const char* data = nullptr;
+	size_t size = 0;
+	if (ResourcePack::find(path, &data, &size)) {
+		rsvg_handle = rsvg_handle_new_from_data((const guint8*) data, size, &error);
+	} else {
+		rsvg_handle = rsvg_handle_new_from_file(path.c_str(), &error);
+	}
 	if (rsvg_handle == nullptr) {
 		g_info("%s[%d] : Loading SVG file error: %s", __FILE__, __LINE__, error->message);
 		g_error_free(error);
-		return false;
+		return nullptr;
 	}
 
 	rsvg_handle_get_dimensions(rsvg_handle, &dimensions);
@@ -185,26 +264,24 @@ bool Texture::loadSVG(SDL_Renderer* renderer, const std::string& path, int width
 
 	g_info("%s[%d]: Scaling SVG file %s to %d x %d (%f %f scale)", __FILE__, __LINE__, path.c_str(), width, height, wscale, vscale);
 
-	/* scanline width */
-	stride = width * OCCILLO_TEXTURE_BYTEPP;
-
-	/* Allocate space for an image: */
-	image = (unsigned char *) calloc(stride * height, 1);
-	if (image == nullptr) {
-		g_warning("%s[%d]: Unable to allocate image buffer to store rendered SVG", __FILE__, __LINE__);
-		g_object_unref(rsvg_handle);
-		return false;
+	/* Create the SDL surface, which cairo draws into directly: */
+	sdl_surface = SDL_CreateRGBSurface(0, width, height, OCCILLO_TEXTURE_BPP,
+	                                   OCCILLO_TEXTURE_RMASK, OCCILLO_TEXTURE_GMASK, OCCILLO_TEXTURE_BMASK, OCCILLO_TEXTURE_AMASK);
+	if (sdl_surface == nullptr) {
+		g_warning("%s[%d]: SDL_CreateRGBSurface() failed!", __FILE__, __LINE__);
+		cleanup(rsvg_handle, cr, cairo_surf, sdl_surface, nullptr);
+		return nullptr;
 	}
 
-	/* Create a surface for Cairo to draw into: */
-	cairo_surf = cairo_image_surface_create_for_data(image, CAIRO_FORMAT_ARGB32,
-	             width, height, stride);
+	/* Create a surface for Cairo to draw into, (cairo's ARGB32 is premultiplied, as the texture expects): */
+	cairo_surf = cairo_image_surface_create_for_data((unsigned char *) sdl_surface->pixels, CAIRO_FORMAT_ARGB32,
+	             width, height, sdl_surface->pitch);
 
 	if (cairo_surface_status(cairo_surf) != CAIRO_STATUS_SUCCESS) {
 		g_warning("%s[%d]: cairo_image_surface_create() failed!", __FILE__, __LINE__);
 		/* Clean up: */
-		cleanup(rsvg_handle, cr, cairo_surf, sdl_surface, image);
-		return false;
+		cleanup(rsvg_handle, cr, cairo_surf, sdl_surface, nullptr);
+		return nullptr;
 	}
 
 	/* Create a new Cairo object: */
@@ -212,8 +289,8 @@ bool Texture::loadSVG(SDL_Renderer* renderer, const std::string& path, int width
 	if (cairo_status(cr) != CAIRO_STATUS_SUCCESS) {
 		g_warning("%s[%d]: cairo_create() failed!", __FILE__, __LINE__);
 		/* Clean up: */
-		cleanup(rsvg_handle, cr, cairo_surf, sdl_surface, image);
-		return false;
+		cleanup(rsvg_handle, cr, cairo_surf, sdl_surface, nullptr);
+		return nullptr;
 	}
 
 	/* Ask RSVG to render the SVG into the Cairo object: */
@@ -223,38 +300,11 @@ bool Texture::loadSVG(SDL_Renderer* renderer, const std::string& path, int width
 	rsvg_handle_render_cairo(rsvg_handle, cr);
 	cairo_surface_finish(cairo_surf);
 
-	/* Create the SDL surface using the pixel data stored: */
-	sdl_surface = SDL_CreateRGBSurfaceFrom((void *) image, width, height,
-	                                       OCCILLO_TEXTURE_BPP, stride,
-	                                       OCCILLO_TEXTURE_RMASK, OCCILLO_TEXTURE_GMASK, OCCILLO_TEXTURE_BMASK, OCCILLO_TEXTURE_AMASK);
-
-	if (sdl_surface == nullptr) {
-		g_warning("%s[%d]: SDL_CreateRGBSurfaceFrom() failed!", __FILE__, __LINE__);
-		/* Clean up: */
-		cleanup(rsvg_handle, cr, cairo_surf, sdl_surface, image);
-		return false;
-	}
-
-	g_info("%s[%d] : SDL surface from %d x %d SVG is %d x %d", __FILE__, __LINE__, sdl_surface->w, sdl_surface->h, rwidth, rheight);
-
-	//Create texture from surface pixels
-	newTexture = SDL_CreateTextureFromSurface(renderer, sdl_surface);
+	g_info("%s[%d] : SDL surface from %d x %d SVG is %d x %d", __FILE__, __LINE__, rwidth, rheight, sdl_surface->w, sdl_surface->h);
 
-	if (newTexture == nullptr) {
-		lastError = SDL_GetError();
-	} else {
-		//Get image dimensions
-		this->width = sdl_surface->w;
-		this->height = sdl_surface->h;
-	}
-	/* Clean up: */
-	cleanup(rsvg_handle, cr, cairo_surf, sdl_surface, image);
-
-	//Return success
-	if (newTexture != nullptr) {
-		texture.push_back(newTexture);
-	}
-	return newTexture != nullptr;
+	/* Clean up, keeping the SDL surface: */
+	cleanup(rsvg_handle, cr, cairo_surf, nullptr, nullptr);
+	return sdl_surface;
 }
 
 bool Texture::loadFromText(SDL_Renderer* renderer, const std::string& text, TTF_Font *font, SDL_Color* colour) {
@@ -262,7 +312,10 @@ bool Texture::loadFromText(SDL_Renderer* renderer, const std::string& text, TTF_
 	if (renderer == nullptr || font == nullptr || colour == nullptr) {
 		return false;
 	}
+	// The font cache opens fonts at the pixel density.
+	density = pixelDensity;
 	//Render text surface
+	WorkCounters::add(WORK_TEXT_RASTERIZATIONS);
 	SDL_Surface* textSurface = TTF_RenderUTF8_Blended( font, text.c_str(), *colour);
 	if ( textSurface == nullptr ) {
 		g_info("%s[%d] : Unable to render text surface! SDL_ttf Error: %s", __FILE__, __LINE__, TTF_GetError());
@@ -272,10 +325,7 @@ bool Texture::loadFromText(SDL_Renderer* renderer, const std::string& text, TTF_
 		if ( t == nullptr ) {
 			g_info("%s[%d] : Unable to create texture %s", __FILE__, __LINE__, SDL_GetError());
 		} else {
-			//Get image dimensions
-			this->texture.push_back(t);
-			this->width = textSurface->w;
-			this->height = textSurface->h;
+			addFrame(t, textSurface->w, textSurface->h);
 		} //Get rid of old surface
 		SDL_FreeSurface( textSurface );
 	}
@@ -283,24 +333,30 @@ bool Texture::loadFromText(SDL_Renderer* renderer, const std::string& text, TTF_
 	return !texture.empty();
 }
 
-bool Texture::loadFromText(SDL_Renderer* renderer, const std::string& text, TTF_Font *font, SDL_Color* colour, SDL_Color* outlineColour) {
+bool Texture::loadFromText(SDL_Renderer* renderer, const std::string& text, TTF_Font *font, TTF_Font *outlineFont, SDL_Color* colour, SDL_Color* outlineColour) {
 	destroy();
-	if (renderer == nullptr || font == nullptr || colour == nullptr || outlineColour == nullptr) {
+	if (renderer == nullptr || font == nullptr || outlineFont == nullptr || colour == nullptr || outlineColour == nullptr) {
 		return false;
 	}
 
+	// The font cache opens fonts, and sizes outlines, at the pixel density.
+	density = pixelDensity;
+	const int outline = (int)(OCCILLO_OUTLINE_SIZE * density + 0.5f);
 	//Render front text surface
+	WorkCounters::add(WORK_TEXT_RASTERIZATIONS);
 	SDL_Surface* textFGSurface = TTF_RenderUTF8_Blended( font, text.c_str(), *colour );
-	TTF_SetFontOutline(font, OCCILLO_OUTLINE_SIZE);
-	// Render outline
-	SDL_Surface* textBGSurface = TTF_RenderUTF8_Blended( font, text.c_str(), *outlineColour );
-	TTF_SetFontOutline(font, 0);
-	SDL_Rect rect = { OCCILLO_OUTLINE_SIZE,  OCCILLO_OUTLINE_SIZE, textFGSurface->w, textFGSurface->h};
-
-	// blit text onto its outline
-	SDL_SetSurfaceBlendMode(textFGSurface, SDL_BLENDMODE_BLEND);
-	SDL_BlitSurface(textFGSurface, nullptr, textBGSurface, &rect);
-	SDL_FreeSurface(textFGSurface);
+	// Render outline, (a separate font so neither font's glyph cache is flushed by changing the outline).
+	SDL_Surface* textBGSurface = TTF_RenderUTF8_Blended( outlineFont, text.c_str(), *outlineColour );
+
+	if (textFGSurface != nullptr) {
+		if (textBGSurface != nullptr) {
+			// blit text onto its outline
+			SDL_Rect rect = { outline,  outline, textFGSurface->w, textFGSurface->h};
+			SDL_SetSurfaceBlendMode(textFGSurface, SDL_BLENDMODE_BLEND);
+			SDL_BlitSurface(textFGSurface, nullptr, textBGSurface, &rect);
+		}
+		SDL_FreeSurface(textFGSurface);
+	}
 
 	if ( textBGSurface == nullptr ) {
 		g_info("%s[%d] : Unable to render text surface! SDL_ttf Error: %s", __FILE__, __LINE__, TTF_GetError());
@@ -310,10 +366,7 @@ bool Texture::loadFromText(SDL_Renderer* renderer, const std::string& text, TTF_
 		if ( t == nullptr ) {
 			g_info("%s[%d] : Unable to create texture %s", __FILE__, __LINE__, SDL_GetError());
 		} else {
-			this->texture.push_back(t);
-			//Get image dimensions
-			this->width = textBGSurface->w;
-			this->height = textBGSurface->h;
+			addFrame(t, textBGSurface->w, textBGSurface->h);
 		} //Get rid of old surface
 		SDL_FreeSurface( textBGSurface );
 	}
@@ -349,10 +402,7 @@ bool Texture::loadFromColour(SDL_Renderer* renderer, SDL_Color* colour, int widt
 	if ( t == nullptr ) {
 		g_info("%s[%d] : Unable to create texture %s", __FILE__, __LINE__, SDL_GetError());
 	} else {
-		//Get image dimensions
-		this->texture.push_back(t);
-		this->width = surface->w;
-		this->height = surface->h;
+		addFrame(t, surface->w, surface->h);
 	} //Get rid of old surface
 	SDL_FreeSurface( surface );
 
@@ -396,46 +446,114 @@ void Texture::destroy() {
 		}
 	}
 	texture.clear();
+	frames.clear();
 	width = 0;
 	height = 0;
+	density = 1.0f;
 	lastError = nullptr;
-	startTime = SDL_GetTicks();
+	premultiplied = false;
+	rate = defaultRate;
+	mode = defaultMode;
+	startTime = clock;
 }
 
 unsigned int Texture::getFrame() {
-	const unsigned int sz = texture.size();
-	if (sz <= 1) {
+	const unsigned int sz = frames.size();
+	if ((sz <= 1) || (rate <= 0)) {
 		return 0;
 	}
-	unsigned int i = 0;
-	unsigned int delta = (SDL_GetTicks() - startTime); // time in msec
-	// Assume 10fps;
-	i = (delta / 100); // This will assume 10 frames (i is delta in deci-seconds, or tenths of second)
-	// Now cap to sz.
-	i = i % sz;
-	return i;
+	unsigned int step = (unsigned int)(((Uint64)(clock - startTime) * rate) / 1000);
+	switch (mode) {
+		case ANIMATION_ONCE:
+			return std::min(step, sz - 1);
+		case ANIMATION_PINGPONG: {
+			unsigned int period = 2 * (sz - 1);
+			step %= period;
+			return (step < sz) ? step : (period - step);
+		}
+		default:
+			return step % sz;
+	}
+}
+
+void Texture::addFrame(SDL_Texture* t, int w, int h) {
+	texture.push_back(t);
+	Frame frame = { t, { 0, 0, w, h } };
+	frames.push_back(frame);
+	this->width = (int)(w / density + 0.5f);
+	this->height = (int)(h / density + 0.5f);
+}
+
+void Texture::setAnimation(const std::string& path) {
+	rate = defaultRate;
+	mode = defaultMode;
+	// The options follow the last file, eg "a.svg;b.svg;@12:pingpong".
+	size_t options = path.rfind(OCCILLO_TEXTURE_ANIMATION_PREFIX);
+	if ((options == std::string::npos) || ((options != 0) && (path[options - 1] != ';'))) {
+		return;
+	}
+	std::vector<std::string> values = StringUtil::split(path.substr(options + 1), ':');
+	if (!values.empty() && !values[0].empty()) {
+		rate = std::atoi(values[0].c_str());
+	}
+	if (values.size() > 1) {
+		mode = parseAnimationMode(values[1]);
+	}
+}
+
+void Texture::setDefaultAnimation(int rate, AnimationMode mode) {
+	defaultRate = rate;
+	defaultMode = mode;
+}
+
+AnimationMode Texture::parseAnimationMode(const std::string& name) {
+	if (name == "pingpong") {
+		return ANIMATION_PINGPONG;
+	}
+	if (name == "once") {
+		return ANIMATION_ONCE;
+	}
+	return ANIMATION_LOOP;
+}
+
+void Texture::setClock(Uint32 ticks) {
+	clock = ticks;
+}
+
+Uint32 Texture::getClock() {
+	return clock;
+}
+
+void Texture::setPixelDensity(float density) {
+	pixelDensity = (density > 0.0f) ? density : 1.0f;
+}
+
+float Texture::getPixelDensity() {
+	return pixelDensity;
 }
 
 void Texture::render(SDL_Renderer* renderer, int x, int y) {
-	if (texture.empty()) {
+	if (frames.empty()) {
 		return;
 	}
-	// Determine the texture to display.
-	unsigned int i = getFrame();
+	// Determine the frame to display.
+	const Frame& frame = frames[getFrame()];
 	//Set rendering space and render to screen
 	SDL_Rect renderQuad = {x, y, width, height };
-	SDL_RenderCopy(renderer, texture[i], nullptr, &renderQuad);
+	SDL_RenderCopy(renderer, frame.texture, &frame.clip, &renderQuad);
+	countDraw(frame.texture);
 }
 
 void Texture::render(SDL_Renderer* renderer, int x, int y, int x1, int x2, int y1, int y2) {
-	if (texture.empty()) {
+	if (frames.empty()) {
 		return;
 	}
-	// Determine the texture to display.
-	unsigned int i = getFrame();
+	// Determine the frame to display.
+	const Frame& frame = frames[getFrame()];
 	SDL_Rect renderQuad = {x, y, x2, y2 };
-	SDL_Rect clip = {x1, y1, x2, y2 };
-	SDL_RenderCopy(renderer, texture[i], &clip, &renderQuad);
+	SDL_Rect clip = {frame.clip.x + (int)(x1 * density), frame.clip.y + (int)(y1 * density), (int)(x2 * density), (int)(y2 * density) };
+	SDL_RenderCopy(renderer, frame.texture, &clip, &renderQuad);
+	countDraw(frame.texture);
 }
 
 const char * Texture::getLastError() {
@@ -453,6 +571,9 @@ int Texture::getHeight() {
 }
 
 void Texture::setBlendMode( SDL_BlendMode blending ) {
+	if (premultiplied && (blending == SDL_BLENDMODE_BLEND)) {
+		blending = AlphaUtil::getPremultipliedBlendMode();
+	}
 	unsigned int sz = texture.size();
 	for (unsigned int i = 0; i < sz ; i++) {
 		SDL_SetTextureBlendMode( texture[i], blending );
@@ -463,6 +584,18 @@ void Texture::setAlpha( Uint8 alpha ) {
 	unsigned int sz = texture.size();
 	for (unsigned int i = 0; i < sz ; i++) {
 		SDL_SetTextureAlphaMod( texture[i], alpha );
+		if (premultiplied) {
+			// The colour carries the alpha, so fade it too.
+			SDL_SetTextureColorMod( texture[i], alpha, alpha, alpha );
+		}
+	}
+}
+
+void Texture::countDraw(SDL_Texture* t) {
+	WorkCounters::add(WORK_DRAW_CALLS);
+	if (t != lastRendered) {
+		WorkCounters::add(WORK_TEXTURE_SWITCHES);
+		lastRendered = t;
 	}
 }
 
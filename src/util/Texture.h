@@ -20,6 +20,7 @@
 #define _TEXTURE_H
 
 #include <cstdlib>
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <SDL.h>
@@ -29,6 +30,10 @@
 #include <librsvg/rsvg.h>
 
 #include "StringUtil.h"
+#include "WorkCounters.h"
+#include "ResourcePack.h"
+#include "Resampler.h"
+#include "AlphaUtil.h"
 
 #define OCCILLO_TEXTURE_RMASK 0x00ff0000
 #define OCCILLO_TEXTURE_GMASK 0x0000ff00
@@ -37,6 +42,27 @@
 #define OCCILLO_TEXTURE_BPP 32
 #define OCCILLO_TEXTURE_BYTEPP 4
 #define OCCILLO_OUTLINE_SIZE 3
+/**
+ * @brief The filter used to scale bitmap images.
+ */
+#define OCCILLO_TEXTURE_RESAMPLE_FILTER RESAMPLE_LANCZOS
+/**
+ * @brief The default animation frame rate, (frames per second).
+ */
+#define OCCILLO_TEXTURE_ANIMATION_RATE 10
+/**
+ * @brief The prefix of the animation options in a resource string, eg "a.svg;b.svg;@12:pingpong".
+ */
+#define OCCILLO_TEXTURE_ANIMATION_PREFIX '@'
+
+/**
+* @brief How an animation continues after its last frame.
+*/
+enum AnimationMode {
+	ANIMATION_LOOP,      /**< Restart from the first frame. */
+	ANIMATION_PINGPONG,  /**< Play backwards to the first frame, then forwards again. */
+	ANIMATION_ONCE       /**< Hold the last frame. */
+};
 
 /**
 * @brief A Texture to utilise.
@@ -70,6 +96,30 @@ class Texture {
 	*/
 	bool loadFromFile(SDL_Renderer* renderer, const std::string& path, int width, int height);
 	/**
+	* @brief Rasterize a given image file to surfaces, without creating a texture. This does not use the
+	* renderer, so may be called off the main thread.
+	*
+	* @param path The path of the file to load, (or ';' separated files for an animated texture).
+	* @param width The width the image should be scaled to, (-1 for the image width).
+	* @param height The height the image should be scaled to, (-1 for the image height).
+	* @param frames The list to add the surfaces to, (one per frame, ARGB8888 premultiplied by alpha).
+	*
+	* @return TRUE if any frame was rasterized.
+	*/
+	static bool rasterizeFile(const std::string& path, int width, int height, std::vector<SDL_Surface*>& frames);
+	/**
+	* @brief Create the texture from surfaces created by rasterizeFile(). The surfaces are freed and the list cleared.
+	* The texture blends premultiplied alpha, or straight alpha if the renderer can't. The frames of an
+	* animation are packed into a single sprite sheet where they fit.
+	*
+	* @param renderer The SDL renderer to use.
+	* @param surfaces The surfaces, (one per frame).
+	* @param path The resource string the surfaces were rasterized from, for its animation options.
+	*
+	* @return TRUE if the texture was created.
+	*/
+	bool loadFromSurfaces(SDL_Renderer* renderer, std::vector<SDL_Surface*>& surfaces, const std::string& path = "");
+	/**
 	* @brief Create a new texture based on a text string.
 	*
 	* @param renderer The SDL renderer to use.
@@ -86,12 +136,13 @@ class Texture {
 	* @param renderer The SDL renderer to use.
 	* @param text The text to render.
 	* @param font The SDL Font to use
+	* @param outlineFont The same SDL Font with an outline of OCCILLO_OUTLINE_SIZE set.
 	* @param colour The SDL Colour to use
 	* @param outlineColour The SDL Colour to use for the outline.
 	*
 	* @return TRUE if the text rendered correctly to a texture.
 	*/
-	bool loadFromText(SDL_Renderer* renderer, const std::string& text, TTF_Font *font, SDL_Color* colour, SDL_Color* outlineColour);
+	bool loadFromText(SDL_Renderer* renderer, const std::string& text, TTF_Font *font, TTF_Font *outlineFont, SDL_Color* colour, SDL_Color* outlineColour);
 	/**
 	* @brief Set the texture to be a single colour. This is primarily useful for missing images or missing text/font.
 	*
@@ -166,18 +217,108 @@ class Texture {
 	 */
 	void setEmptyTexture(int width, int height);
 	/**
+	* @brief Set the animation frame rate and mode for textures that don't give their own.
+	*
+	* @param rate The frame rate, (frames per second).
+	* @param mode The animation mode.
+	*/
+	static void setDefaultAnimation(int rate, AnimationMode mode);
+	/**
+	* @brief Parse the name of an animation mode, ("loop", "pingpong" or "once").
+	*
+	* @param name The name.
+	*
+	* @return The mode, or ANIMATION_LOOP if the name isn't known.
+	*/
+	static AnimationMode parseAnimationMode(const std::string& name);
+	/**
+	* @brief Set the time used to pick the frame of every animated texture. The display sets this
+	* once a frame, so the textures drawn in a frame agree and none need read the time.
+	*
+	* @param ticks The time in ms.
+	*/
+	static void setClock(Uint32 ticks);
+	/**
+	* @brief Get the time of the current frame, as set by setClock().
+	*
+	* @return The time in ms.
+	*/
+	static Uint32 getClock();
+	/**
 	* @brief Get the next colour to use for missing textures.
 	*
 	* @return An appropriate colour for missing textures.
 	*/
 	static SDL_Color* getColour();
+	/**
+	* @brief Set the number of pixels per unit of the renderer's coordinates, (above 1.0 on HiDPI displays).
+	* Images and text are rasterized at this density, while their width and height stay in renderer units.
+	*
+	* @param density The pixel density.
+	*/
+	static void setPixelDensity(float density);
+	/**
+	* @brief Get the number of pixels per unit of the renderer's coordinates.
+	*
+	* @return The pixel density.
+	*/
+	static float getPixelDensity();
 
   private:
 	/**
-	* @brief The texture as a SDL Texture.
+	* @brief The SDL texture used by the last render call, (for counting texture switches).
+	*/
+	static SDL_Texture* lastRendered;
+	/**
+	* @brief The last renderer found unable to blend premultiplied alpha.
+	*/
+	static SDL_Renderer* straightRenderer;
+	/**
+	* @brief The default animation frame rate.
+	*/
+	static int defaultRate;
+	/**
+	* @brief The default animation mode.
+	*/
+	static AnimationMode defaultMode;
+	/**
+	* @brief The time of the current frame.
+	*/
+	static Uint32 clock;
+	/**
+	* @brief The pixel density images and text are rasterized at.
+	*/
+	static float pixelDensity;
+	/**
+	* @brief An animation frame, (a region of a SDL texture).
+	*/
+	struct Frame {
+		/**
+		* @brief The SDL texture holding the frame.
+		*/
+		SDL_Texture* texture;
+		/**
+		* @brief The region of the SDL texture.
+		*/
+		SDL_Rect clip;
+	};
+	/**
+	* @brief The SDL textures, (a single sprite sheet for most animations).
 	*/
 	std::vector<SDL_Texture*> texture;
 	/**
+	* @brief The animation frames.
+	*/
+	std::vector<Frame> frames;
+	/**
+	* @brief The animation frame rate, (frames per second).
+	*/
+	int rate;
+	/**
+	* @brief The animation mode.
+	*/
+	AnimationMode mode;
+	/**
 	* @brief The width of the texture
 	*/
 	int width;
@@ -186,35 +327,41 @@ class Texture {
 	*/
 	int height;
 	/**
+	* @brief The pixels of the SDL textures per unit of the width and height.
+	*/
+	float density;
+	/**
 	* @brief A pointer to the last error message.
 	*/
 	const char * lastError;
 	/**
+	* @brief TRUE if the texture colours are premultiplied by alpha.
+	*/
+	bool premultiplied;
+	/**
 	* @brief The start time of the animation
 	*/
 	uint32_t startTime;
 	/**
-	* @brief Load the given SVG file
+	* @brief Rasterize the given SVG file to a surface.
 	*
-	* @param renderer The SDL Renderer to use
 	* @param path The path to the SVG file
 	* @param width The width to render the image as
 	* @param height The height to render the image as
 	*
-	* @return TRUE if the image loaded rendered correctly.
+	* @return The surface, or nullptr if the image could not be rendered.
 	*/
-	bool loadSVG(SDL_Renderer* renderer, const std::string& path, int width, int height);
+	static SDL_Surface* rasterizeSVG(const std::string& path, int width, int height);
 	/**
-	* @brief Load the given PNG file
+	* @brief Rasterize the given PNG file to a surface.
 	*
-	* @param renderer The SDL Renderer to use
 	* @param path The path to the PNG file
 	* @param width The width to render the image as
 	* @param height The height to render the image as
 	*
-	* @return TRUE if the image loaded rendered correctly.
+	* @return The surface, or nullptr if the image could not be loaded.
 	*/
-	bool loadPNG(SDL_Renderer* renderer, const std::string& path, int width, int height);
+	static SDL_Surface* rasterizePNG(const std::string& path, int width, int height);
 	/**
 	* @brief Cleanup all the given resources.
 	*
@@ -224,7 +371,7 @@ class Texture {
 	* @param sdl_surface The SDL surface
 	* @param image The given image.
 	*/
-	void cleanup(RsvgHandle * rsvg_handle, cairo_t * cr, cairo_surface_t * cairo_surf, SDL_Surface * sdl_surface, void * image);
+	static void cleanup(RsvgHandle * rsvg_handle, cairo_t * cr, cairo_surface_t * cairo_surf, SDL_Surface * sdl_surface, void * image);
 
 	/**
 	* @brief Get the frame number to display
@@ -232,6 +379,36 @@ class Texture {
 	* @return The frame number to display.
 	*/
 	unsigned int getFrame();
+	/**
+	* @brief Add a SDL texture as a single frame.
+	*
+	* @param t The SDL texture.
+	* @param w The texture width in pixels, (the width is this over the density).
+	* @param h The texture height in pixels.
+	*/
+	void addFrame(SDL_Texture* t, int w, int h);
+	/**
+	* @brief Set the animation options from the given resource string, (or the defaults).
+	*
+	* @param path The resource string.
+	*/
+	void setAnimation(const std::string& path);
+	/**
+	* @brief Pack equally sized frames into a single sprite sheet surface.
+	*
+	* @param renderer The SDL renderer, (for the largest texture size).
+	* @param surfaces The frames. On success these are freed and replaced by the sheet.
+	* @param clips The region of the sheet for each frame.
+	*
+	* @return TRUE if the frames were packed.
+	*/
+	static bool packSheet(SDL_Renderer* renderer, std::vector<SDL_Surface*>& surfaces, std::vector<SDL_Rect>& clips);
+	/**
+	* @brief Count a draw call of the given SDL texture.
+	*
+	* @param t The SDL texture drawn.
+	*/
+	static void countDraw(SDL_Texture* t);
 };
 
 #endif
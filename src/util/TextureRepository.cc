@@ -74,6 +74,15 @@ bool TextureRepository::add(int index, SDL_Renderer* renderer, const std::string
 	return add(index, text);
 }
 
+bool TextureRepository::add(int index, SDL_Renderer* renderer, std::vector<SDL_Surface*>& frames, const std::string& path) {
+	Texture* text = new Texture();
+	if (!text->loadFromSurfaces(renderer, frames, path)) {
+		delete text;
+		return false;
+	}
+	return add(index, text);
+}
+
 Texture* TextureRepository::remove(int index) {
 	TR_BOUNDS_CHECK(nullptr)
 	Texture * t = textures[index];
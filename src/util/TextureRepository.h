@@ -72,6 +72,17 @@ class TextureRepository {
 	 * @return  TRUE if the texture was added.
 	 */
 	bool add(int index, SDL_Renderer* renderer, const std::string& path, int width, int height);
+	/**
+	 * Add a new Texture to the repository, created from surfaces rasterized by Texture::rasterizeFile().
+	 * <p>
+	 * If the index given is already in use, the existing texture is freed and replaced.
+	 * @param index The index the texture is to reside in,
+	 * @param renderer The render to use
+	 * @param frames The surfaces, (freed and the list cleared).
+	 * @param path The resource string the surfaces were rasterized from, (for its animation options).
+	 * @return TRUE if the texture was added.
+	 */
+	bool add(int index, SDL_Renderer* renderer, std::vector<SDL_Surface*>& frames, const std::string& path);
 	/**
 	 * Remove a texture from the given index, and return it.
 	 * @param index The index to remove.
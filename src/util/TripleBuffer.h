@@ -0,0 +1,108 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_TRIPLEBUFFER_H
+#define UTIL_TRIPLEBUFFER_H
+
+#include <SDL.h>
+
+/**
+ * @brief The flag set on the shared index when it holds a buffer the reader has not taken.
+ */
+#define OCCILLO_TRIPLEBUFFER_FRESH 4
+
+/**
+ * @brief A lock free triple buffer, passing the latest value from one writer thread to one reader thread.
+ *
+ * The writer fills the back buffer and publishes it, the reader takes the most recently published
+ * buffer. Neither ever waits on the other, and a value published while the reader is behind replaces
+ * the one it has not yet taken.
+ */
+template <typename T>
+class TripleBuffer {
+  public:
+	TripleBuffer() {
+		back = 0;
+		front = 1;
+		SDL_AtomicSet(&middle, 2);
+	}
+	/**
+	 * @brief Get the buffer the writer is to fill.
+	 * @return The back buffer.
+	 */
+	T& getBack() {
+		return buffers[back];
+	}
+	/**
+	 * @brief Publish the back buffer to the reader, (the writer gets a new back buffer to fill).
+	 */
+	void publish() {
+		back = exchange(back | OCCILLO_TRIPLEBUFFER_FRESH) & ~OCCILLO_TRIPLEBUFFER_FRESH;
+	}
+	/**
+	 * @brief Take the most recently published buffer, if there is one the reader has not taken.
+	 * @return TRUE if the front buffer changed.
+	 */
+	bool consume() {
+		if ((SDL_AtomicGet(&middle) & OCCILLO_TRIPLEBUFFER_FRESH) == 0) {
+			return false;
+		}
+		front = exchange(front) & ~OCCILLO_TRIPLEBUFFER_FRESH;
+		return true;
+	}
+	/**
+	 * @brief Get the buffer the reader last took.
+	 * @return The front buffer.
+	 */
+	T& getFront() {
+		return buffers[front];
+	}
+
+  private:
+	/**
+	 * @brief The three buffers.
+	 */
+	T buffers[3];
+	/**
+	 * @brief The index of the buffer being filled, (writer only).
+	 */
+	int back;
+	/**
+	 * @brief The index of the buffer being read, (reader only).
+	 */
+	int front;
+	/**
+	 * @brief The index of the buffer passed between the two, with OCCILLO_TRIPLEBUFFER_FRESH if published
+	 * and not yet taken.
+	 */
+	SDL_atomic_t middle;
+	/**
+	 * @brief Swap the given index with the shared index, (a compare and swap, so a full barrier).
+	 * @param index The index to share.
+	 * @return The index that was shared.
+	 */
+	int exchange(int index) {
+		int old;
+		do {
+			old = SDL_AtomicGet(&middle);
+		} while (!SDL_AtomicCAS(&middle, old, index));
+		return old;
+	}
+};
+
+#endif /* UTIL_TRIPLEBUFFER_H */
@@ -0,0 +1,274 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "VideoRecorder.h"
+
+#include <cstdio>
+
+VideoRecorder::VideoRecorder() {
+	format = RECORDER_RAW;
+	width = 0;
+	height = 0;
+	throttle = false;
+	for (int i = 0; i < OCCILLO_RECORDER_BUFFERS; i++) {
+		ring[i] = nullptr;
+	}
+	head = 0;
+	count = 0;
+	stopping = false;
+	failed = false;
+	lock = nullptr;
+	ready = nullptr;
+	space = nullptr;
+	writer = nullptr;
+	captured = 0;
+	dropped = 0;
+	written = 0;
+	captureTime = 0;
+	writeTime = 0;
+}
+
+VideoRecorder::~VideoRecorder() {
+	stop();
+}
+
+bool VideoRecorder::isRecording() {
+	return writer != nullptr;
+}
+
+bool VideoRecorder::start(const std::string& file, int width, int height, int fps, bool throttle) {
+	if (isRecording()) {
+		stop();
+	}
+	this->file = file;
+	this->width = width;
+	this->height = height;
+	this->throttle = throttle;
+	if (g_str_has_suffix(file.c_str(), ".y4m")) {
+		format = RECORDER_Y4M;
+	} else if (g_str_has_suffix(file.c_str(), ".png")) {
+		format = RECORDER_PNG;
+		this->file = file.substr(0, file.size() - 4);
+	} else {
+		format = RECORDER_RAW;
+	}
+
+	if (format != RECORDER_PNG) {
+		video.open(file, std::ofstream::out | std::ofstream::binary);
+		if (!video.is_open()) {
+			g_warning("%s[%d] : Unable to open recording file %s", __FILE__, __LINE__, file.c_str());
+			return false;
+		}
+		if (format == RECORDER_Y4M) {
+			video << "YUV4MPEG2 W" << width << " H" << height << " F" << ((fps > 0) ? fps : OCCILLO_RECORDER_DEFAULT_FPS)
+			      << ":1 Ip A1:1 C444\n";
+			planes.resize(width * height * 3);
+		} else {
+			g_info("%s[%d] : Recording raw ARGB8888 frames of %dx%d", __FILE__, __LINE__, width, height);
+		}
+	}
+
+	for (int i = 0; i < OCCILLO_RECORDER_BUFFERS; i++) {
+		ring[i] = SDL_CreateRGBSurface(0, width, height, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+		if (ring[i] == nullptr) {
+			g_warning("%s[%d] : Unable to create recording buffer: %s", __FILE__, __LINE__, SDL_GetError());
+			release();
+			return false;
+		}
+	}
+	head = 0;
+	count = 0;
+	stopping = false;
+	failed = false;
+	captured = 0;
+	dropped = 0;
+	written = 0;
+	captureTime = 0;
+	writeTime = 0;
+	lock = SDL_CreateMutex();
+	ready = SDL_CreateCond();
+	space = SDL_CreateCond();
+	writer = SDL_CreateThread(writerThread, "recorder", this);
+	if (writer == nullptr) {
+		g_warning("%s[%d] : Unable to start the recording writer: %s", __FILE__, __LINE__, SDL_GetError());
+		release();
+		return false;
+	}
+	g_info("%s[%d] : Recording to %s", __FILE__, __LINE__, file.c_str());
+	return true;
+}
+
+void VideoRecorder::capture(SDL_Renderer* renderer) {
+	if (!isRecording()) {
+		return;
+	}
+	Uint64 start = SDL_GetPerformanceCounter();
+	captured++;
+	SDL_LockMutex(lock);
+	while (throttle && !failed && (count == OCCILLO_RECORDER_BUFFERS)) {
+		SDL_CondWait(space, lock);
+	}
+	if (failed || (count == OCCILLO_RECORDER_BUFFERS)) {
+		SDL_UnlockMutex(lock);
+		dropped++;
+		captureTime += SDL_GetPerformanceCounter() - start;
+		return;
+	}
+	// The writer never touches the buffers past the end of the queue.
+	SDL_Surface* frame = ring[(head + count) % OCCILLO_RECORDER_BUFFERS];
+	SDL_UnlockMutex(lock);
+
+	// Only the recorded area is read, (should the display have been resized).
+	SDL_Rect area = { 0, 0, width, height };
+	if (SDL_RenderReadPixels(renderer, &area, SDL_PIXELFORMAT_ARGB8888, frame->pixels, frame->pitch) == 0) {
+		SDL_LockMutex(lock);
+		count++;
+		SDL_CondSignal(ready);
+		SDL_UnlockMutex(lock);
+	} else {
+		dropped++;
+	}
+	captureTime += SDL_GetPerformanceCounter() - start;
+}
+
+void VideoRecorder::stop() {
+	if (!isRecording()) {
+		return;
+	}
+	SDL_LockMutex(lock);
+	stopping = true;
+	SDL_CondSignal(ready);
+	SDL_UnlockMutex(lock);
+	SDL_WaitThread(writer, nullptr);
+	writer = nullptr;
+
+	const double frequency = (double) SDL_GetPerformanceFrequency();
+	g_message("%s[%d] : Recorded %u frames to %s, %u dropped, capture mean %.2f ms, write mean %.2f ms", __FILE__, __LINE__,
+	          written, (format == RECORDER_PNG) ? (file + "-*.png").c_str() : file.c_str(), dropped,
+	          (captured > 0) ? (captureTime * 1000.0 / frequency / captured) : 0.0,
+	          (written > 0) ? (writeTime * 1000.0 / frequency / written) : 0.0);
+	release();
+}
+
+void VideoRecorder::release() {
+	for (int i = 0; i < OCCILLO_RECORDER_BUFFERS; i++) {
+		if (ring[i] != nullptr) {
+			SDL_FreeSurface(ring[i]);
+			ring[i] = nullptr;
+		}
+	}
+	if (video.is_open()) {
+		video.close();
+	}
+	planes.clear();
+	if (space != nullptr) {
+		SDL_DestroyCond(space);
+		space = nullptr;
+	}
+	if (ready != nullptr) {
+		SDL_DestroyCond(ready);
+		ready = nullptr;
+	}
+	if (lock != nullptr) {
+		SDL_DestroyMutex(lock);
+		lock = nullptr;
+	}
+}
+
+int VideoRecorder::writerThread(void* data) {
+	VideoRecorder* recorder = (VideoRecorder*) data;
+	recorder->writeFrames();
+	return 0;
+}
+
+void VideoRecorder::writeFrames() {
+	SDL_LockMutex(lock);
+	while (true) {
+		while ((count == 0) && !stopping) {
+			SDL_CondWait(ready, lock);
+		}
+		if (count == 0) {
+			break;
+		}
+		SDL_Surface* frame = ring[head];
+		bool skip = failed;
+		SDL_UnlockMutex(lock);
+
+		bool ok = true;
+		if (!skip) {
+			Uint64 start = SDL_GetPerformanceCounter();
+			ok = writeFrame(frame);
+			writeTime += SDL_GetPerformanceCounter() - start;
+			if (ok) {
+				written++;
+			}
+		}
+
+		SDL_LockMutex(lock);
+		if (!ok) {
+			failed = true;
+		}
+		head = (head + 1) % OCCILLO_RECORDER_BUFFERS;
+		count--;
+		SDL_CondSignal(space);
+	}
+	SDL_UnlockMutex(lock);
+}
+
+bool VideoRecorder::writeFrame(SDL_Surface* frame) {
+	const Uint8* pixels = (const Uint8*) frame->pixels;
+	if (format == RECORDER_PNG) {
+		char number[16] = "";
+		std::snprintf(number, sizeof(number), "-%06u.png", written + 1);
+		std::string name = file + number;
+		if (IMG_SavePNG(frame, name.c_str()) != 0) {
+			g_warning("%s[%d] : Unable to write %s: %s, recording stopped", __FILE__, __LINE__, name.c_str(), SDL_GetError());
+			return false;
+		}
+		return true;
+	}
+	if (format == RECORDER_Y4M) {
+		// BT.601 studio range, (as expected by Y4M readers).
+		const int size = width * height;
+		Uint8* y = planes.data();
+		Uint8* u = y + size;
+		Uint8* v = u + size;
+		for (int row = 0; row < height; row++) {
+			const Uint32* src = (const Uint32*)(pixels + row * frame->pitch);
+			for (int col = 0; col < width; col++) {
+				const int r = (src[col] >> 16) & 0xff;
+				const int g = (src[col] >> 8) & 0xff;
+				const int b = src[col] & 0xff;
+				*y++ = (Uint8)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+				*u++ = (Uint8)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+				*v++ = (Uint8)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+			}
+		}
+		video << "FRAME\n";
+		video.write((const char*) planes.data(), planes.size());
+	} else {
+		for (int row = 0; row < height; row++) {
+			video.write((const char*)(pixels + row * frame->pitch), width * 4);
+		}
+	}
+	if (!video.good()) {
+		g_warning("%s[%d] : Unable to write %s, recording stopped", __FILE__, __LINE__, file.c_str());
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,195 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_VIDEORECORDER_H
+#define UTIL_VIDEORECORDER_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <SDL.h>
+#include <SDL_image.h>
+#include <glib.h>
+
+#include "config.h"
+
+/**
+ * @brief The number of staging buffers between the render thread and the writer.
+ */
+#define OCCILLO_RECORDER_BUFFERS 8
+
+/**
+ * @brief The default frame rate written to Y4M files.
+ */
+#define OCCILLO_RECORDER_DEFAULT_FPS 60
+
+/**
+ * @brief The file formats the recorder can write.
+ */
+enum RecorderFormat {
+	RECORDER_Y4M,   /**< YUV4MPEG2, (4:4:4, so no chroma is lost). */
+	RECORDER_RAW,   /**< Raw frames, (ARGB8888 in native byte order, so BGRA on little endian). */
+	RECORDER_PNG    /**< A numbered PNG file per frame. */
+};
+
+/**
+ * @brief Records every presented frame to a file, written by its own thread.
+ *
+ * Each frame is read back on the render thread into the next free buffer of a ring, and the
+ * writer thread converts and writes the buffers in order. When the writer falls behind and the
+ * ring is full, the frame is dropped, (or, when throttling, the render thread waits for a buffer).
+ * The format follows the file extension, ".y4m", ".png", (written as name-000001.png, etc), or raw
+ * for anything else.
+ */
+class VideoRecorder {
+  public:
+	VideoRecorder();
+	virtual ~VideoRecorder();
+	/**
+	 * @brief Start recording.
+	 * @param file The file to write.
+	 * @param width The width of the frames.
+	 * @param height The height of the frames.
+	 * @param fps The frame rate written to the file, (Y4M only).
+	 * @param throttle TRUE to wait for the writer rather than drop frames.
+	 * @return TRUE if the file was opened and the writer started.
+	 */
+	bool start(const std::string& file, int width, int height, int fps, bool throttle);
+	/**
+	 * @brief Capture the current render target, (called before the frame is presented).
+	 * @param renderer The renderer.
+	 */
+	void capture(SDL_Renderer* renderer);
+	/**
+	 * @brief Write the remaining frames, stop the writer and report the overhead.
+	 */
+	void stop();
+	/**
+	 * @brief Determine if recording.
+	 * @return TRUE if recording.
+	 */
+	bool isRecording();
+
+  private:
+	/**
+	 * @brief The format being written.
+	 */
+	RecorderFormat format;
+	/**
+	 * @brief The file being written, (or the base name of the PNG files).
+	 */
+	std::string file;
+	/**
+	 * @brief The video file, (Y4M and raw).
+	 */
+	std::ofstream video;
+	/**
+	 * @brief The width of the frames.
+	 */
+	int width;
+	/**
+	 * @brief The height of the frames.
+	 */
+	int height;
+	/**
+	 * @brief TRUE to wait for the writer rather than drop frames.
+	 */
+	bool throttle;
+	/**
+	 * @brief The staging buffers.
+	 */
+	SDL_Surface* ring[OCCILLO_RECORDER_BUFFERS];
+	/**
+	 * @brief The buffer the writer takes next.
+	 */
+	int head;
+	/**
+	 * @brief The number of buffers waiting for, or being written by, the writer.
+	 */
+	int count;
+	/**
+	 * @brief TRUE when the writer is to finish once the ring is empty.
+	 */
+	bool stopping;
+	/**
+	 * @brief TRUE once a write has failed, (later frames are dropped).
+	 */
+	bool failed;
+	/**
+	 * @brief Lock for the ring, and the stopping and failed flags.
+	 */
+	SDL_mutex* lock;
+	/**
+	 * @brief Signalled when a buffer is added to the ring, or on stop.
+	 */
+	SDL_cond* ready;
+	/**
+	 * @brief Signalled when the writer frees a buffer.
+	 */
+	SDL_cond* space;
+	/**
+	 * @brief The writer thread.
+	 */
+	SDL_Thread* writer;
+	/**
+	 * @brief The frames captured.
+	 */
+	Uint32 captured;
+	/**
+	 * @brief The frames dropped.
+	 */
+	Uint32 dropped;
+	/**
+	 * @brief The frames written, (writer thread only until stopped).
+	 */
+	Uint32 written;
+	/**
+	 * @brief The performance counter ticks spent in capture on the render thread.
+	 */
+	Uint64 captureTime;
+	/**
+	 * @brief The performance counter ticks spent writing, (writer thread only until stopped).
+	 */
+	Uint64 writeTime;
+	/**
+	 * @brief The converted frame, (writer thread only).
+	 */
+	std::vector<Uint8> planes;
+	/**
+	 * @brief The writer thread entry.
+	 * @param data The recorder.
+	 * @return 0.
+	 */
+	static int writerThread(void* data);
+	/**
+	 * @brief Write buffers until stopped.
+	 */
+	void writeFrames();
+	/**
+	 * @brief Write a single frame.
+	 * @param frame The frame.
+	 * @return TRUE if written.
+	 */
+	bool writeFrame(SDL_Surface* frame);
+	/**
+	 * @brief Free the buffers and synchronisation objects.
+	 */
+	void release();
+};
+
+#endif /* UTIL_VIDEORECORDER_H */
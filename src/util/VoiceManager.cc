@@ -0,0 +1,150 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "VoiceManager.h"
+
+VoiceManager::VoiceManager() {
+	coalesceTime = OCCILLO_VOICEMANAGER_COALESCE_TIME;
+	maxVoices = OCCILLO_VOICEMANAGER_MAX_VOICES;
+	coalesced = 0;
+	stolen = 0;
+	dropped = 0;
+	reported = 0;
+	reportTime = 0;
+}
+
+VoiceManager::~VoiceManager() {
+}
+
+void VoiceManager::init(int channels, int coalesceTime, int maxVoices) {
+	if (channels < 1) {
+		channels = OCCILLO_VOICEMANAGER_CHANNELS;
+	}
+	channels = Mix_AllocateChannels(channels);
+	this->coalesceTime = (coalesceTime > 0) ? coalesceTime : 0;
+	this->maxVoices = (maxVoices > 0) ? maxVoices : channels;
+	voices.assign(channels, { nullptr, 0, 0 });
+	lastPlayed.clear();
+	g_info("%s[%d] : %d mixing channels, coalesce %d ms, %d voices per sound", __FILE__, __LINE__,
+	       channels, this->coalesceTime, this->maxVoices);
+}
+
+int VoiceManager::play(Mix_Chunk* chunk, int priority) {
+	if (chunk == nullptr || voices.empty()) {
+		return -1;
+	}
+	Uint32 now = SDL_GetTicks();
+	auto last = lastPlayed.find(chunk);
+	if (last != lastPlayed.end() && (now - last->second) < (Uint32) coalesceTime) {
+		coalesced++;
+		WorkCounters::add(WORK_SOUND_COALESCED);
+		return -1;
+	}
+	int channel = findChannel(chunk, priority, now);
+	if (channel < 0) {
+		report(now);
+		return -1;
+	}
+	channel = Mix_PlayChannel(channel, chunk, 0);
+	if (channel < 0) {
+		return -1;
+	}
+	voices[channel] = { chunk, priority, now };
+	lastPlayed[chunk] = now;
+	WorkCounters::add(WORK_SOUND_PLAYS);
+	report(now);
+	return channel;
+}
+
+int VoiceManager::findChannel(Mix_Chunk* chunk, int priority, Uint32 now) {
+	int playing = 0;
+	int oldest = -1;
+	int free = -1;
+	int victim = -1;
+	for (int channel = 0; channel < (int) voices.size(); channel++) {
+		if (!Mix_Playing(channel)) {
+			if (free < 0) {
+				free = channel;
+			}
+			continue;
+		}
+		const Voice& voice = voices[channel];
+		if (voice.chunk == chunk) {
+			playing++;
+			if (oldest < 0 || (now - voice.started) > (now - voices[oldest].started)) {
+				oldest = channel;
+			}
+		}
+		if (voice.priority < priority) {
+			if (victim < 0 || voice.priority < voices[victim].priority ||
+			        (voice.priority == voices[victim].priority && (now - voice.started) > (now - voices[victim].started))) {
+				victim = channel;
+			}
+		}
+	}
+	// At the voice limit, restart the oldest voice of this sound rather than taking another channel.
+	if (playing >= maxVoices) {
+		Mix_HaltChannel(oldest);
+		return oldest;
+	}
+	if (free >= 0) {
+		return free;
+	}
+	if (victim >= 0) {
+		stolen++;
+		WorkCounters::add(WORK_SOUND_STEALS);
+		Mix_HaltChannel(victim);
+		return victim;
+	}
+	dropped++;
+	WorkCounters::add(WORK_SOUND_DROPS);
+	return -1;
+}
+
+void VoiceManager::report(Uint32 now) {
+	unsigned long saturated = stolen + dropped;
+	if (saturated == reported || (now - reportTime) < OCCILLO_VOICEMANAGER_REPORT_INTERVAL) {
+		return;
+	}
+	g_info("%s[%d] : Mixing channels saturated, %lu channels stolen, %lu sounds dropped, (%lu coalesced)",
+	       __FILE__, __LINE__, stolen, dropped, coalesced);
+	reported = saturated;
+	reportTime = now;
+}
+
+void VoiceManager::halt() {
+	if (!voices.empty()) {
+		Mix_HaltChannel(-1);
+	}
+	for (Voice& voice : voices) {
+		voice = { nullptr, 0, 0 };
+	}
+	lastPlayed.clear();
+}
+
+unsigned long VoiceManager::getCoalesced() {
+	return coalesced;
+}
+
+unsigned long VoiceManager::getStolen() {
+	return stolen;
+}
+
+unsigned long VoiceManager::getDropped() {
+	return dropped;
+}
@@ -0,0 +1,163 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_VOICEMANAGER_H
+#define UTIL_VOICEMANAGER_H
+
+#include <map>
+#include <vector>
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <glib.h>
+
+#include "config.h"
+#include "WorkCounters.h"
+
+/**
+ * @brief The default number of mixing channels.
+ */
+#define OCCILLO_VOICEMANAGER_CHANNELS 16
+/**
+ * @brief The default time in ms within which repeated plays of the same sound are coalesced.
+ */
+#define OCCILLO_VOICEMANAGER_COALESCE_TIME 30
+/**
+ * @brief The default maximum number of channels playing the same sound.
+ */
+#define OCCILLO_VOICEMANAGER_MAX_VOICES 4
+/**
+ * @brief The minimum time in ms between reports of channel saturation.
+ */
+#define OCCILLO_VOICEMANAGER_REPORT_INTERVAL 5000
+
+/**
+ * @brief Plays sound effects on a fixed set of mixing channels.
+ *
+ * Plays of a sound within the coalesce time of its last play are merged into that play, and each sound
+ * is limited to a number of voices, (the oldest voice of the sound is restarted once at the limit). When
+ * every channel is busy, the oldest voice of the lowest priority below the new sound is stolen, otherwise
+ * the new sound is dropped. Saturation is counted by the work counters and reported in the log.
+ */
+class VoiceManager {
+  public:
+	VoiceManager();
+	virtual ~VoiceManager();
+	/**
+	 * @brief Allocate the mixing channels and set the limits, (SDL_mixer must be open).
+	 * @param channels The number of mixing channels.
+	 * @param coalesceTime The time in ms within which repeated plays of a sound are coalesced, (0 to not coalesce).
+	 * @param maxVoices The maximum number of channels playing the same sound.
+	 */
+	void init(int channels, int coalesceTime, int maxVoices);
+	/**
+	 * @brief Play the given sound.
+	 * @param chunk The sound to play.
+	 * @param priority The priority of the sound, (higher values may steal the channels of lower values).
+	 * @return The channel played on, or -1 if the play was coalesced or dropped.
+	 */
+	int play(Mix_Chunk* chunk, int priority);
+	/**
+	 * @brief Halt all channels and forget the sounds played, (eg before the sounds are freed).
+	 */
+	void halt();
+	/**
+	 * @brief Get the number of plays merged into an earlier play of the same sound.
+	 * @return The number of coalesced plays.
+	 */
+	unsigned long getCoalesced();
+	/**
+	 * @brief Get the number of plays that stole a busy channel.
+	 * @return The number of stolen channels.
+	 */
+	unsigned long getStolen();
+	/**
+	 * @brief Get the number of plays dropped as every channel was busy with sounds of equal or higher priority.
+	 * @return The number of dropped plays.
+	 */
+	unsigned long getDropped();
+
+  private:
+	/**
+	 * @brief The sound last started on a channel.
+	 */
+	struct Voice {
+		/**
+		 * @brief The sound, (only valid while the channel is playing).
+		 */
+		Mix_Chunk* chunk;
+		/**
+		 * @brief The priority of the sound.
+		 */
+		int priority;
+		/**
+		 * @brief The tick count when the sound was started.
+		 */
+		Uint32 started;
+	};
+	/**
+	 * @brief The voice of each channel.
+	 */
+	std::vector<Voice> voices;
+	/**
+	 * @brief The tick count of the last play of each sound.
+	 */
+	std::map<Mix_Chunk*, Uint32> lastPlayed;
+	/**
+	 * @brief The time in ms within which repeated plays of a sound are coalesced.
+	 */
+	int coalesceTime;
+	/**
+	 * @brief The maximum number of channels playing the same sound.
+	 */
+	int maxVoices;
+	/**
+	 * @brief The number of coalesced plays.
+	 */
+	unsigned long coalesced;
+	/**
+	 * @brief The number of stolen channels.
+	 */
+	unsigned long stolen;
+	/**
+	 * @brief The number of dropped plays.
+	 */
+	unsigned long dropped;
+	/**
+	 * @brief The number of stolen channels and dropped plays at the last report.
+	 */
+	unsigned long reported;
+	/**
+	 * @brief The tick count of the last report.
+	 */
+	Uint32 reportTime;
+	/**
+	 * @brief Find the channel to play the given sound on.
+	 * @param chunk The sound.
+	 * @param priority The priority of the sound.
+	 * @param now The current tick count.
+	 * @return The channel, or -1 if the sound should be dropped.
+	 */
+	int findChannel(Mix_Chunk* chunk, int priority, Uint32 now);
+	/**
+	 * @brief Log the stolen channels and dropped plays since the last report, at most once a report interval.
+	 * @param now The current tick count.
+	 */
+	void report(Uint32 now);
+};
+
+#endif /* UTIL_VOICEMANAGER_H */
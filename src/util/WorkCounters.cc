@@ -0,0 +1,146 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "WorkCounters.h"
+
+SDL_atomic_t WorkCounters::enabled = { 0 };
+SDL_atomic_t WorkCounters::totals[WORK_COUNTERS] = { };
+unsigned int WorkCounters::lastFrame[WORK_COUNTERS] = { 0 };
+unsigned long WorkCounters::second[WORK_COUNTERS] = { 0 };
+unsigned long WorkCounters::secondMax[WORK_COUNTERS] = { 0 };
+unsigned long WorkCounters::perSecond[WORK_COUNTERS] = { 0 };
+unsigned long WorkCounters::maxPerFrame[WORK_COUNTERS] = { 0 };
+int WorkCounters::frames = 0;
+int WorkCounters::framesPerSecond = 0;
+unsigned int WorkCounters::seconds = 0;
+Uint32 WorkCounters::secondStart = 0;
+std::ofstream WorkCounters::dump;
+
+/**
+ * @brief The counter names, indexed by WorkCounter.
+ */
+static const char* counterNames[WORK_COUNTERS] = {
+	"draw_calls",
+	"texture_switches",
+	"collision_tests",
+	"swept_aabb",
+	"brick_scans",
+	"animations",
+	"text_rasterizations",
+	"sound_plays",
+	"sound_coalesced",
+	"sound_steals",
+	"sound_drops",
+	"render_scale"
+};
+
+void WorkCounters::setEnabled(bool enable) {
+	if (enable && !isEnabled()) {
+		secondStart = SDL_GetTicks();
+	}
+	SDL_AtomicSet(&enabled, enable ? 1 : 0);
+}
+
+bool WorkCounters::isEnabled() {
+	return SDL_AtomicGet(&enabled) != 0;
+}
+
+bool WorkCounters::setDump(const std::string& file) {
+	dump.open(file, std::ofstream::out);
+	if (!dump.is_open()) {
+		g_warning("%s[%d] : Unable to open counters file %s", __FILE__, __LINE__, file.c_str());
+		return false;
+	}
+	setEnabled(true);
+	return true;
+}
+
+void WorkCounters::close() {
+	if (dump.is_open()) {
+		dump.close();
+	}
+}
+
+bool WorkCounters::isGauge(int counter) {
+	return (counter == WORK_ANIMATIONS) || (counter == WORK_RENDER_SCALE);
+}
+
+void WorkCounters::frame() {
+	if (!isEnabled()) {
+		return;
+	}
+	frames++;
+	for (int i = 0; i < WORK_COUNTERS; i++) {
+		const unsigned int total = (unsigned int) SDL_AtomicGet(&totals[i]);
+		unsigned long count = isGauge(i) ? total : (unsigned int)(total - lastFrame[i]);
+		lastFrame[i] = total;
+		second[i] += count;
+		if (count > secondMax[i]) {
+			secondMax[i] = count;
+		}
+	}
+	Uint32 now = SDL_GetTicks();
+	if ((now - secondStart) >= 1000) {
+		for (int i = 0; i < WORK_COUNTERS; i++) {
+			perSecond[i] = isGauge(i) ? (second[i] / frames) : second[i];
+			maxPerFrame[i] = secondMax[i];
+			second[i] = 0;
+			secondMax[i] = 0;
+		}
+		framesPerSecond = frames;
+		frames = 0;
+		seconds++;
+		secondStart = now;
+		if (dump.is_open()) {
+			writeDump();
+		}
+	}
+}
+
+void WorkCounters::writeDump() {
+	dump << "{\"second\":" << seconds << ",\"frames\":" << framesPerSecond;
+	for (int i = 0; i < WORK_COUNTERS; i++) {
+		dump << ",\"" << counterNames[i] << "\":" << perSecond[i]
+		     << ",\"" << counterNames[i] << "_max\":" << maxPerFrame[i];
+	}
+	dump << "}" << std::endl;
+}
+
+unsigned int WorkCounters::getTotal(WorkCounter counter) {
+	return (unsigned int) SDL_AtomicGet(&totals[counter]);
+}
+
+unsigned long WorkCounters::getPerSecond(WorkCounter counter) {
+	return perSecond[counter];
+}
+
+unsigned long WorkCounters::getMaxPerFrame(WorkCounter counter) {
+	return maxPerFrame[counter];
+}
+
+int WorkCounters::getFramesPerSecond() {
+	return framesPerSecond;
+}
+
+unsigned int WorkCounters::getSeconds() {
+	return seconds;
+}
+
+const char* WorkCounters::getName(WorkCounter counter) {
+	return counterNames[counter];
+}
@@ -0,0 +1,196 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef UTIL_WORKCOUNTERS_H
+#define UTIL_WORKCOUNTERS_H
+
+#include <string>
+#include <fstream>
+#include <SDL.h>
+#include <glib.h>
+
+#include "config.h"
+
+/**
+ * @brief The units of work counted.
+ */
+enum WorkCounter {
+	WORK_DRAW_CALLS,            /**< Texture render calls. */
+	WORK_TEXTURE_SWITCHES,      /**< Render calls using a different texture to the previous call. */
+	WORK_COLLISION_TESTS,       /**< Ball against brick or paddle collision tests. */
+	WORK_SWEPT_AABB,            /**< Swept AABB tests, (tests that pass the broadphase). */
+	WORK_BRICK_SCANS,           /**< Scans of the brick grid for the next collision. */
+	WORK_ANIMATIONS,            /**< Live animations, (a gauge rather than a count). */
+	WORK_TEXT_RASTERIZATIONS,   /**< Text rendered to a texture. */
+	WORK_SOUND_PLAYS,           /**< Sound effects played. */
+	WORK_SOUND_COALESCED,       /**< Sound effects merged into an earlier play of the same sound. */
+	WORK_SOUND_STEALS,          /**< Sound effects that stole a busy mixing channel. */
+	WORK_SOUND_DROPS,           /**< Sound effects dropped as every mixing channel was busy. */
+	WORK_RENDER_SCALE,          /**< The dynamic resolution scale of the level in percent, (a gauge, 0 outside a level). */
+	WORK_COUNTERS               /**< The number of counters. */
+};
+
+/**
+ * @brief Cheap counters of the work done each frame, aggregated each second.
+ *
+ * Counting is off until enabled. The flag and totals are atomic, as the level simulation thread and the
+ * job workers count their work while the render thread aggregates it, (they are 32 bit and wrap, differences are taken modulo 2^32).
+ */
+class WorkCounters {
+  public:
+	/**
+	 * @brief Add to the given counter.
+	 * @param counter The counter.
+	 * @param count The amount to add.
+	 */
+	static inline void add(WorkCounter counter, unsigned long count = 1) {
+		if (SDL_AtomicGet(&enabled) != 0) {
+			SDL_AtomicAdd(&totals[counter], (int) count);
+		}
+	}
+	/**
+	 * @brief Set the value of the given gauge, (eg the number of live animations).
+	 * @param counter The counter.
+	 * @param value The current value.
+	 */
+	static inline void set(WorkCounter counter, unsigned long value) {
+		if (SDL_AtomicGet(&enabled) != 0) {
+			SDL_AtomicSet(&totals[counter], (int) value);
+		}
+	}
+	/**
+	 * @brief Enable or disable counting.
+	 * @param enable TRUE to count.
+	 */
+	static void setEnabled(bool enable);
+	/**
+	 * @brief Determine if counting is enabled.
+	 * @return TRUE if counting.
+	 */
+	static bool isEnabled();
+	/**
+	 * @brief Write the per second counts to the given file, as JSON lines.
+	 * @param file The file to write.
+	 * @return TRUE if the file was opened.
+	 */
+	static bool setDump(const std::string& file);
+	/**
+	 * @brief Close the dump file.
+	 */
+	static void close();
+	/**
+	 * @brief Record the end of a frame, (called by the display on each render).
+	 */
+	static void frame();
+	/**
+	 * @brief Get the total count since counting was enabled.
+	 * @param counter The counter.
+	 * @return The total, (or the current value for a gauge), which wraps, so take differences as unsigned int.
+	 */
+	static unsigned int getTotal(WorkCounter counter);
+	/**
+	 * @brief Get the count for the last complete second.
+	 * @param counter The counter.
+	 * @return The count, (or the mean value for a gauge).
+	 */
+	static unsigned long getPerSecond(WorkCounter counter);
+	/**
+	 * @brief Get the largest count in a single frame in the last complete second.
+	 * @param counter The counter.
+	 * @return The count.
+	 */
+	static unsigned long getMaxPerFrame(WorkCounter counter);
+	/**
+	 * @brief Get the number of frames in the last complete second.
+	 * @return The number of frames.
+	 */
+	static int getFramesPerSecond();
+	/**
+	 * @brief Get the number of seconds aggregated, (changes when a new second is available).
+	 * @return The number of seconds.
+	 */
+	static unsigned int getSeconds();
+	/**
+	 * @brief Get the name of the given counter.
+	 * @param counter The counter.
+	 * @return The name, (as used in the dump).
+	 */
+	static const char* getName(WorkCounter counter);
+
+  private:
+	/**
+	 * @brief Non zero if counting, (read from any thread).
+	 */
+	static SDL_atomic_t enabled;
+	/**
+	 * @brief The running totals, (added to from any thread).
+	 */
+	static SDL_atomic_t totals[WORK_COUNTERS];
+	/**
+	 * @brief The totals at the end of the last frame.
+	 */
+	static unsigned int lastFrame[WORK_COUNTERS];
+	/**
+	 * @brief The counts in the current second.
+	 */
+	static unsigned long second[WORK_COUNTERS];
+	/**
+	 * @brief The largest frame counts in the current second.
+	 */
+	static unsigned long secondMax[WORK_COUNTERS];
+	/**
+	 * @brief The counts for the last complete second.
+	 */
+	static unsigned long perSecond[WORK_COUNTERS];
+	/**
+	 * @brief The largest frame counts for the last complete second.
+	 */
+	static unsigned long maxPerFrame[WORK_COUNTERS];
+	/**
+	 * @brief The number of frames in the current second.
+	 */
+	static int frames;
+	/**
+	 * @brief The number of frames in the last complete second.
+	 */
+	static int framesPerSecond;
+	/**
+	 * @brief The number of seconds aggregated.
+	 */
+	static unsigned int seconds;
+	/**
+	 * @brief The tick count at the start of the current second.
+	 */
+	static Uint32 secondStart;
+	/**
+	 * @brief The JSON lines dump.
+	 */
+	static std::ofstream dump;
+	/**
+	 * @brief Determine if the given counter is a gauge.
+	 * @param counter The counter.
+	 * @return TRUE if a gauge.
+	 */
+	static bool isGauge(int counter);
+	/**
+	 * @brief Write the last complete second to the dump.
+	 */
+	static void writeDump();
+};
+
+#endif /* UTIL_WORKCOUNTERS_H */
@@ -112,3 +112,46 @@ void collision::testBallPaddleTouch() {
 
 }
 
+
+void collision::testAutoPilotPredict() {
+	// On the stack, so nothing leaks when an assertion fails, (the ball and paddle own their textures).
+	Texture* btext = new Texture();
+	btext->setEmptyTexture(16, 16);
+	Ball ball(btext, 100, 0, 32);
+	ball.setDirection(90);
+
+	Texture* ptext = new Texture();
+	ptext->setEmptyTexture(48, 16);
+	Paddle paddle(ptext, 0, 200, 64, 0, 400, 0);
+
+	Brick* bricks[4] = { nullptr, nullptr, nullptr, nullptr };
+	AutoPilot pilot(&ball, &paddle, bricks, 2, 2, 1);
+
+	// Straight down, so will meet the paddle under the ball.
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(108.0, pilot.predict(), 0.001);
+}
+
+void collision::testAutoPilotPredictRebound() {
+	Texture* btext = new Texture();
+	btext->setEmptyTexture(16, 16);
+	Ball ball(btext, 100, 100, 32);
+	ball.setDirection(270);
+
+	Texture* ptext = new Texture();
+	ptext->setEmptyTexture(48, 16);
+	Paddle paddle(ptext, 0, 200, 64, 0, 400, 0);
+
+	// The brick doesn't own its texture.
+	Texture brtext;
+	brtext.setEmptyTexture(40, 16);
+	Brick brick(&brtext, 90, 20, 0, 10);
+	Brick* bricks[4] = { &brick, nullptr, nullptr, nullptr };
+	AutoPilot pilot(&ball, &paddle, bricks, 2, 2, 1);
+
+	// Straight up, rebounding off the brick back down to the paddle.
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(108.0, pilot.predict(), 0.001);
+
+	// Without the brick, the ball never returns.
+	brick.collision();
+	CPPUNIT_ASSERT_EQUAL(-1.0, pilot.predict());
+}
@@ -24,6 +24,8 @@
 #include "Texture.h"
 #include "Ball.h"
 #include "Paddle.h"
+#include "Brick.h"
+#include "AutoPilot.h"
 
 class collision : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST_SUITE(collision);
@@ -31,6 +33,8 @@ class collision : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(testBallPaddle);
     CPPUNIT_TEST(testBallPaddleOverlap);
     CPPUNIT_TEST(testBallPaddleTouch);
+    CPPUNIT_TEST(testAutoPilotPredict);
+    CPPUNIT_TEST(testAutoPilotPredictRebound);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -44,6 +48,8 @@ private:
     void testBallPaddleOverlap();
     void testBallPaddle();
 		void testBallPaddleTouch();
+    void testAutoPilotPredict();
+    void testAutoPilotPredictRebound();
 };
 
 #endif /* COLLISION_H */
@@ -18,6 +18,9 @@
 
 #include "colours.h"
 
+#include <vector>
+#include <cstdlib>
+
 CPPUNIT_TEST_SUITE_REGISTRATION(colours);
 
 colours::colours() {
@@ -26,10 +29,17 @@ colours::colours() {
 colours::~colours() {
 }
 
+/**
+ * @brief The number of workers started for each test, (so large resamples are split into parts).
+ */
+#define TEST_COLOURS_WORKERS 3
+
 void colours::setUp() {
+	CPPUNIT_ASSERT(JobSystem::init(TEST_COLOURS_WORKERS));
 }
 
 void colours::tearDown() {
+	JobSystem::shutdown();
 }
 
 void colours::testTextureColourGeneration() {
@@ -39,3 +49,122 @@ void colours::testTextureColourGeneration() {
 	}
 }
 
+
+void colours::testResampleFlatColour() {
+	// A flat, partly transparent colour must survive scaling up and down with every filter.
+	const Uint32 colour = 0x80336699;
+	SDL_Surface* source = SDL_CreateRGBSurface(0, 64, 48, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+	CPPUNIT_ASSERT(source != nullptr);
+	SDL_FillRect(source, nullptr, colour);
+	const ResampleFilter filters[] = { RESAMPLE_AREA, RESAMPLE_BILINEAR, RESAMPLE_LANCZOS };
+	const int sizes[][2] = { { 17, 13 }, { 64, 100 }, { 301, 7 } };
+	for (ResampleFilter filter : filters) {
+		for (const int* size : sizes) {
+			SDL_Surface* scaled = Resampler::resample(source, size[0], size[1], filter);
+			CPPUNIT_ASSERT(scaled != nullptr);
+			CPPUNIT_ASSERT_EQUAL(size[0], scaled->w);
+			CPPUNIT_ASSERT_EQUAL(size[1], scaled->h);
+			for (int y = 0; y < scaled->h; y++) {
+				Uint32* row = (Uint32*)((Uint8*) scaled->pixels + y * scaled->pitch);
+				for (int x = 0; x < scaled->w; x++) {
+					CPPUNIT_ASSERT_EQUAL(colour, row[x]);
+				}
+			}
+			SDL_FreeSurface(scaled);
+		}
+	}
+	SDL_FreeSurface(source);
+}
+
+/**
+ * @brief Create a surface of every alpha, (including 0 and 255), with varied colours.
+ */
+static SDL_Surface* createAlphaPattern(int width, int height) {
+	SDL_Surface* surface = SDL_CreateRGBSurface(0, width, height, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+	if (surface == nullptr) {
+		return nullptr;
+	}
+	Uint32 seed = 1;
+	for (int y = 0; y < height; y++) {
+		Uint32* row = (Uint32*)((Uint8*) surface->pixels + y * surface->pitch);
+		for (int x = 0; x < width; x++) {
+			seed = seed * 1103515245 + 12345;
+			Uint32 alpha = ((y * width + x) * 7) & 0xff;
+			row[x] = (alpha << 24) | ((seed >> 8) & 0x00ffffff);
+		}
+	}
+	return surface;
+}
+
+/**
+ * @brief Check the (SIMD) surface conversion against the scalar loop, for widths with and without a tail.
+ */
+static void checkMatchesScalar(void (*convert)(SDL_Surface*), void (*scalar)(Uint32*, int)) {
+	const int widths[] = { 1, 3, 4, 5, 7, 8, 37 };
+	for (int width : widths) {
+		SDL_Surface* surface = createAlphaPattern(width, 256);
+		CPPUNIT_ASSERT(surface != nullptr);
+		std::vector<Uint32> expected;
+		for (int y = 0; y < surface->h; y++) {
+			Uint32* row = (Uint32*)((Uint8*) surface->pixels + y * surface->pitch);
+			expected.insert(expected.end(), row, row + width);
+		}
+		for (int y = 0; y < surface->h; y++) {
+			scalar(&expected[y * width], width);
+		}
+		convert(surface);
+		for (int y = 0; y < surface->h; y++) {
+			Uint32* row = (Uint32*)((Uint8*) surface->pixels + y * surface->pitch);
+			for (int x = 0; x < width; x++) {
+				CPPUNIT_ASSERT_EQUAL(expected[y * width + x], row[x]);
+			}
+		}
+		SDL_FreeSurface(surface);
+	}
+}
+
+void colours::testPremultiplyMatchesScalar() {
+	checkMatchesScalar(AlphaUtil::premultiply, AlphaUtil::premultiplyScalar);
+	// Opaque pixels are kept, and transparent pixels lose their colour.
+	Uint32 pixels[] = { 0xff336699, 0x00336699 };
+	AlphaUtil::premultiplyScalar(pixels, 2);
+	CPPUNIT_ASSERT_EQUAL((Uint32) 0xff336699, pixels[0]);
+	CPPUNIT_ASSERT_EQUAL((Uint32) 0x00000000, pixels[1]);
+}
+
+void colours::testUnpremultiplyMatchesScalar() {
+	checkMatchesScalar(AlphaUtil::unpremultiply, AlphaUtil::unpremultiplyScalar);
+	// Opaque pixels are kept, and transparent pixels are cleared.
+	Uint32 pixels[] = { 0xff336699, 0x00336699 };
+	AlphaUtil::unpremultiplyScalar(pixels, 2);
+	CPPUNIT_ASSERT_EQUAL((Uint32) 0xff336699, pixels[0]);
+	CPPUNIT_ASSERT_EQUAL((Uint32) 0x00000000, pixels[1]);
+}
+
+void colours::testResampleMatchesScalar() {
+	// A varied image, so a wrong row or tap shows, at widths that leave a tail for the SIMD kernels.
+	SDL_Surface* source = createAlphaPattern(97, 61);
+	CPPUNIT_ASSERT(source != nullptr);
+	const ResampleFilter filters[] = { RESAMPLE_AREA, RESAMPLE_BILINEAR, RESAMPLE_LANCZOS };
+	const int sizes[][2] = { { 17, 13 }, { 46, 7 }, { 301, 500 }, { 517, 515 } };
+	for (ResampleFilter filter : filters) {
+		for (const int* size : sizes) {
+			// Premultiplied, so rounding in the faint pixels isn't magnified by the divide.
+			SDL_Surface* scaled = Resampler::resample(source, size[0], size[1], filter, true);
+			SDL_Surface* expected = Resampler::resampleScalar(source, size[0], size[1], filter, true);
+			CPPUNIT_ASSERT(scaled != nullptr);
+			CPPUNIT_ASSERT(expected != nullptr);
+			for (int y = 0; y < scaled->h; y++) {
+				const Uint8* row = (const Uint8*) scaled->pixels + y * scaled->pitch;
+				const Uint8* reference = (const Uint8*) expected->pixels + y * expected->pitch;
+				for (int x = 0; x < scaled->w * 4; x++) {
+					// The kernels sum in a different order, so may round differently.
+					CPPUNIT_ASSERT(std::abs((int) row[x] - (int) reference[x]) <= 1);
+				}
+			}
+			SDL_FreeSurface(expected);
+			SDL_FreeSurface(scaled);
+		}
+	}
+	SDL_FreeSurface(source);
+}
@@ -22,11 +22,17 @@
 #include <cppunit/extensions/HelperMacros.h>
 
 #include "Texture.h"
+#include "Resampler.h"
+#include "AlphaUtil.h"
 
 class colours : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST_SUITE(colours);
 
     CPPUNIT_TEST(testTextureColourGeneration);
+    CPPUNIT_TEST(testResampleFlatColour);
+    CPPUNIT_TEST(testResampleMatchesScalar);
+    CPPUNIT_TEST(testPremultiplyMatchesScalar);
+    CPPUNIT_TEST(testUnpremultiplyMatchesScalar);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -38,6 +44,10 @@ public:
 
 private:
     void testTextureColourGeneration();
+    void testResampleFlatColour();
+    void testResampleMatchesScalar();
+    void testPremultiplyMatchesScalar();
+    void testUnpremultiplyMatchesScalar();
 };
 
 #endif /* COLOURS_H */
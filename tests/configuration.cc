@@ -0,0 +1,75 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "configuration.h"
+
+#include <glib/gstdio.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(configuration);
+
+/**
+ * @brief The resource located by the tests, (unlikely to be in an installed data directory).
+ */
+#define TEST_CONFIGURATION_RESOURCE "game/test-configuration.txt"
+
+configuration::configuration() {
+}
+
+configuration::~configuration() {
+}
+
+void configuration::setUp() {
+	gchar* dir = g_dir_make_tmp("occillo-XXXXXX", nullptr);
+	CPPUNIT_ASSERT(dir != nullptr);
+	directory = dir;
+	g_free(dir);
+	std::string game = directory + G_DIR_SEPARATOR_S "game";
+	CPPUNIT_ASSERT_EQUAL(0, g_mkdir_with_parents(game.c_str(), 0755));
+}
+
+void configuration::tearDown() {
+	std::string file = directory + G_DIR_SEPARATOR_S TEST_CONFIGURATION_RESOURCE;
+	std::string game = directory + G_DIR_SEPARATOR_S "game";
+	g_remove(file.c_str());
+	g_rmdir(game.c_str());
+	g_rmdir(directory.c_str());
+}
+
+void configuration::testLocateResourceCached() {
+	std::string file = directory + G_DIR_SEPARATOR_S TEST_CONFIGURATION_RESOURCE;
+	CPPUNIT_ASSERT(g_file_set_contents(file.c_str(), "test", -1, nullptr));
+	Configuration config;
+	config.setDataPath(directory);
+	CPPUNIT_ASSERT_EQUAL(file, config.locateResource(TEST_CONFIGURATION_RESOURCE));
+	// Found resources are kept, so the file isn't looked for again.
+	g_remove(file.c_str());
+	CPPUNIT_ASSERT_EQUAL(file, config.locateResource(TEST_CONFIGURATION_RESOURCE));
+	// Until the data path changes.
+	config.setDataPath(directory);
+	CPPUNIT_ASSERT_EQUAL(std::string(""), config.locateResource(TEST_CONFIGURATION_RESOURCE));
+}
+
+void configuration::testLocateResourceMissing() {
+	std::string file = directory + G_DIR_SEPARATOR_S TEST_CONFIGURATION_RESOURCE;
+	Configuration config;
+	config.setDataPath(directory);
+	CPPUNIT_ASSERT_EQUAL(std::string(""), config.locateResource(TEST_CONFIGURATION_RESOURCE));
+	// Resources not found are looked for again, (after the directory was listed without them).
+	CPPUNIT_ASSERT(g_file_set_contents(file.c_str(), "test", -1, nullptr));
+	CPPUNIT_ASSERT_EQUAL(file, config.locateResource(TEST_CONFIGURATION_RESOURCE));
+}
@@ -0,0 +1,50 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef TEST_CONFIGURATION_H
+#define TEST_CONFIGURATION_H
+
+#include <string>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Configuration.h"
+
+class configuration : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(configuration);
+
+    CPPUNIT_TEST(testLocateResourceCached);
+    CPPUNIT_TEST(testLocateResourceMissing);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    configuration();
+    virtual ~configuration();
+    void setUp();
+    void tearDown();
+
+private:
+    /**
+     * @brief The data directory for the test.
+     */
+    std::string directory;
+    void testLocateResourceCached();
+    void testLocateResourceMissing();
+};
+
+#endif /* CONFIGURATION_H */
@@ -0,0 +1,142 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "jobsystem.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(jobsystem);
+
+/**
+ * @brief The number of workers started for each test.
+ */
+#define TEST_JOBSYSTEM_WORKERS 3
+
+/**
+ * @brief The counts shared by the jobs of a test.
+ */
+struct JobCounts {
+	/**
+	 * @brief The number of jobs run.
+	 */
+	SDL_atomic_t count;
+	/**
+	 * @brief The number of jobs run when the continuation ran, (-1 if not run).
+	 */
+	int seen;
+	/**
+	 * @brief The thread the job ran on.
+	 */
+	SDL_threadID thread;
+};
+
+static void countJob(void* data) {
+	SDL_AtomicAdd(&((JobCounts*) data)->count, 1);
+}
+
+static void slowJob(void* data) {
+	SDL_Delay(1);
+	SDL_AtomicAdd(&((JobCounts*) data)->count, 1);
+}
+
+static void continuationJob(void* data) {
+	JobCounts* counts = (JobCounts*) data;
+	// Still running when a waiter that did not wait for the continuation has returned.
+	SDL_Delay(10);
+	counts->seen = SDL_AtomicGet(&counts->count);
+}
+
+static void threadJob(void* data) {
+	((JobCounts*) data)->thread = SDL_ThreadID();
+	SDL_AtomicAdd(&((JobCounts*) data)->count, 1);
+}
+
+static void resetCounts(JobCounts& counts) {
+	SDL_AtomicSet(&counts.count, 0);
+	counts.seen = -1;
+	counts.thread = 0;
+}
+
+jobsystem::jobsystem() {
+}
+
+jobsystem::~jobsystem() {
+}
+
+void jobsystem::setUp() {
+	CPPUNIT_ASSERT(JobSystem::init(TEST_JOBSYSTEM_WORKERS));
+}
+
+void jobsystem::tearDown() {
+	JobSystem::shutdown();
+}
+
+void jobsystem::testGroup() {
+	const int jobs = 1000;
+	JobCounts counts;
+	resetCounts(counts);
+	JobGroup group;
+	for (int i = 0; i < jobs; i++) {
+		JobSystem::submit(&group, countJob, &counts, "count");
+	}
+	JobSystem::wait(&group);
+	CPPUNIT_ASSERT(group.isDone());
+	CPPUNIT_ASSERT_EQUAL(jobs, SDL_AtomicGet(&counts.count));
+}
+
+void jobsystem::testContinuation() {
+	const int jobs = 32;
+	JobCounts counts;
+	resetCounts(counts);
+	JobGroup group;
+	for (int i = 0; i < jobs; i++) {
+		JobSystem::submit(&group, slowJob, &counts, "slow");
+	}
+	JobSystem::then(&group, continuationJob, &counts);
+	JobSystem::wait(&group);
+	// The continuation runs after every job, and the wait includes it.
+	CPPUNIT_ASSERT_EQUAL(jobs, counts.seen);
+	CPPUNIT_ASSERT(group.isDone());
+}
+
+void jobsystem::testMainJob() {
+	JobCounts counts;
+	resetCounts(counts);
+	JobGroup group;
+	JobSystem::submit(&group, threadJob, &counts, "main", JOB_MAIN);
+	// Only the main thread runs the job, so the wait must drain the main thread queue.
+	JobSystem::wait(&group);
+	CPPUNIT_ASSERT_EQUAL(1, SDL_AtomicGet(&counts.count));
+	CPPUNIT_ASSERT(counts.thread == SDL_ThreadID());
+}
+
+void jobsystem::testStackGroup() {
+	// The group is destroyed as soon as the wait returns, while the worker that ran the last job may
+	// still be finishing it.
+	const int rounds = 2000;
+	JobCounts counts;
+	resetCounts(counts);
+	for (int i = 0; i < rounds; i++) {
+		JobGroup group;
+		JobSystem::submit(&group, countJob, &counts, "count");
+		JobSystem::submit(&group, countJob, &counts, "count");
+		if ((i % 2) == 0) {
+			JobSystem::then(&group, countJob, &counts);
+		}
+		JobSystem::wait(&group);
+	}
+	CPPUNIT_ASSERT_EQUAL(rounds * 2 + rounds / 2, SDL_AtomicGet(&counts.count));
+}
@@ -0,0 +1,49 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef TEST_JOBSYSTEM_H
+#define TEST_JOBSYSTEM_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "JobSystem.h"
+
+class jobsystem : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(jobsystem);
+
+    CPPUNIT_TEST(testGroup);
+    CPPUNIT_TEST(testContinuation);
+    CPPUNIT_TEST(testMainJob);
+    CPPUNIT_TEST(testStackGroup);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    jobsystem();
+    virtual ~jobsystem();
+    void setUp();
+    void tearDown();
+
+private:
+    void testGroup();
+    void testContinuation();
+    void testMainJob();
+    void testStackGroup();
+};
+
+#endif /* JOBSYSTEM_H */
@@ -0,0 +1,170 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "resourcepack.h"
+
+#include <cstring>
+#include <glib/gstdio.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(resourcepack);
+
+/**
+ * @brief The offset of the first index entry, (after the magic, count and index size).
+ */
+#define TEST_RESOURCEPACK_INDEX (OCCILLO_RESOURCEPACK_MAGIC_SIZE + 8)
+
+/**
+ * @brief The resources packed by each test, (and their contents).
+ */
+static const char* resources[][2] = {
+	{ "game/level.txt", "Level 1\n" },
+	{ "images/ball.svg", "<svg xmlns=\"http://www.w3.org/2000/svg\"/>" }
+};
+
+/**
+ * @brief Write the given contents as the given file.
+ */
+static void writeFile(const std::string& file, const std::string& contents) {
+	CPPUNIT_ASSERT(g_file_set_contents(file.c_str(), contents.data(), contents.size(), nullptr));
+}
+
+/**
+ * @brief Read the given file.
+ */
+static std::string readFile(const std::string& file) {
+	gchar* contents = nullptr;
+	gsize length = 0;
+	CPPUNIT_ASSERT(g_file_get_contents(file.c_str(), &contents, &length, nullptr));
+	std::string result(contents, length);
+	g_free(contents);
+	return result;
+}
+
+/**
+ * @brief Write a little endian value into the given buffer.
+ */
+static void putLE(std::string& buffer, size_t offset, guint64 value, int bytes) {
+	for (int i = 0; i < bytes; i++) {
+		buffer[offset + i] = (char)(value >> (i * 8));
+	}
+}
+
+resourcepack::resourcepack() {
+}
+
+resourcepack::~resourcepack() {
+}
+
+void resourcepack::setUp() {
+	gchar* dir = g_dir_make_tmp("occillo-XXXXXX", nullptr);
+	CPPUNIT_ASSERT(dir != nullptr);
+	directory = dir;
+	g_free(dir);
+	std::vector<std::string> names;
+	for (const char** resource : resources) {
+		std::string file = directory + G_DIR_SEPARATOR_S + resource[0];
+		gchar* parent = g_path_get_dirname(file.c_str());
+		g_mkdir_with_parents(parent, 0755);
+		g_free(parent);
+		writeFile(file, resource[1]);
+		names.push_back(resource[0]);
+	}
+	pack = directory + G_DIR_SEPARATOR_S OCCILLO_RESOURCEPACK_FILE;
+	CPPUNIT_ASSERT(ResourcePack::write(pack, directory, names));
+}
+
+void resourcepack::tearDown() {
+	ResourcePack::close();
+	// Remove the files, then the emptied directories.
+	for (const char** resource : resources) {
+		std::string file = directory + G_DIR_SEPARATOR_S + resource[0];
+		g_remove(file.c_str());
+		gchar* parent = g_path_get_dirname(file.c_str());
+		g_rmdir(parent);
+		g_free(parent);
+	}
+	g_remove(pack.c_str());
+	g_remove((pack + ".bad").c_str());
+	g_rmdir(directory.c_str());
+}
+
+void resourcepack::testWriteRead() {
+	CPPUNIT_ASSERT(ResourcePack::open(pack));
+	for (const char** resource : resources) {
+		CPPUNIT_ASSERT(ResourcePack::contains(resource[0]));
+		const char* data = nullptr;
+		size_t size = 0;
+		CPPUNIT_ASSERT(ResourcePack::find(ResourcePack::getPath(resource[0]), &data, &size));
+		CPPUNIT_ASSERT_EQUAL(std::string(resource[1]), std::string(data, size));
+		// Aligned, (the mapping starts on a page).
+		CPPUNIT_ASSERT_EQUAL((guintptr) 0, (guintptr) data % OCCILLO_RESOURCEPACK_ALIGN);
+	}
+	CPPUNIT_ASSERT(!ResourcePack::contains("images/missing.svg"));
+	const char* data = nullptr;
+	size_t size = 0;
+	CPPUNIT_ASSERT(!ResourcePack::find(directory + G_DIR_SEPARATOR_S "game/level.txt", &data, &size));
+}
+
+void resourcepack::testTruncatedIndex() {
+	std::string contents = readFile(pack);
+	std::string bad = pack + ".bad";
+	// Cut within the header, the first entry, and the first name.
+	const size_t lengths[] = { 4, TEST_RESOURCEPACK_INDEX - 1, TEST_RESOURCEPACK_INDEX + 10, TEST_RESOURCEPACK_INDEX + 22 };
+	for (size_t length : lengths) {
+		writeFile(bad, contents.substr(0, length));
+		CPPUNIT_ASSERT(!ResourcePack::open(bad));
+	}
+	// An index larger than the pack, or too small for its entries.
+	std::string index = contents;
+	putLE(index, OCCILLO_RESOURCEPACK_MAGIC_SIZE + 4, contents.size(), 4);
+	writeFile(bad, index);
+	CPPUNIT_ASSERT(!ResourcePack::open(bad));
+	index = contents;
+	putLE(index, OCCILLO_RESOURCEPACK_MAGIC_SIZE + 4, 30, 4);
+	writeFile(bad, index);
+	CPPUNIT_ASSERT(!ResourcePack::open(bad));
+	// The untouched pack still reads.
+	writeFile(bad, contents);
+	CPPUNIT_ASSERT(ResourcePack::open(bad));
+}
+
+void resourcepack::testEntryPastEnd() {
+	std::string contents = readFile(pack);
+	std::string bad = pack + ".bad";
+	// The first entry's offset past the end.
+	std::string entry = contents;
+	putLE(entry, TEST_RESOURCEPACK_INDEX, contents.size() + 1, 8);
+	writeFile(bad, entry);
+	CPPUNIT_ASSERT(!ResourcePack::open(bad));
+	// The first entry's size past the end, (and so large that offset + size wraps).
+	entry = contents;
+	guint64 offset = 0;
+	for (int i = 7; i >= 0; i--) {
+		offset = (offset << 8) | (unsigned char) contents[TEST_RESOURCEPACK_INDEX + i];
+	}
+	putLE(entry, TEST_RESOURCEPACK_INDEX + 8, contents.size() - offset + 1, 8);
+	writeFile(bad, entry);
+	CPPUNIT_ASSERT(!ResourcePack::open(bad));
+	putLE(entry, TEST_RESOURCEPACK_INDEX + 8, G_MAXUINT64, 8);
+	writeFile(bad, entry);
+	CPPUNIT_ASSERT(!ResourcePack::open(bad));
+	// A resource ending exactly at the end of the pack is valid.
+	putLE(entry, TEST_RESOURCEPACK_INDEX + 8, contents.size() - offset, 8);
+	writeFile(bad, entry);
+	CPPUNIT_ASSERT(ResourcePack::open(bad));
+}
@@ -0,0 +1,56 @@
+/*
+   Copyright (C) 2014 Darran Kartaschew
+
+   This file is part of Occillo.
+
+    Occillo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Occillo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Occillo.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef TEST_RESOURCEPACK_H
+#define TEST_RESOURCEPACK_H
+
+#include <string>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "ResourcePack.h"
+
+class resourcepack : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(resourcepack);
+
+    CPPUNIT_TEST(testWriteRead);
+    CPPUNIT_TEST(testTruncatedIndex);
+    CPPUNIT_TEST(testEntryPastEnd);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    resourcepack();
+    virtual ~resourcepack();
+    void setUp();
+    void tearDown();
+
+private:
+    /**
+     * @brief The directory holding the packed files and the packs.
+     */
+    std::string directory;
+    /**
+     * @brief The pack written by setUp().
+     */
+    std::string pack;
+    void testWriteRead();
+    void testTruncatedIndex();
+    void testEntryPastEnd();
+};
+
+#endif /* RESOURCEPACK_H */